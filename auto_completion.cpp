@@ -8,77 +8,57 @@
 #include "cmd_spec.h"
 #include "console_util.h"
 #include "essentutils/string_util.h"
-#include <set>
+#include "value_completion.h"
+#include <algorithm>
+#include <limits>
+#include <string_view>
 
 
 namespace
 {
 ///////////////////
 
-std::vector<std::string> autoCompleteCmdName(const std::string& input,
-                                             const std::set<ccon::CmdSpec>& cmds)
+// Finds the spec of the argument that the last of given command line words is a
+// value of. Returns null if the word is no value or belongs to no known argument.
+const ccon::ArgSpec* findValueArgSpec(const ccon::CmdSpec& spec,
+                                      const std::vector<std::string>& cmdPieces)
 {
-   std::vector<std::string> candidates;
-   for (const ccon::CmdSpec& spec : cmds)
-      if (sutil::startsWith(spec.name(), input))
-         candidates.push_back(spec.name());
-   return candidates;
-}
-
-
-std::vector<std::string> autoCompleteCmdArg(const std::string& cmdName,
-                                            const std::string& inputArg,
-                                            const std::set<ccon::CmdSpec>& cmds)
-{
-   const std::string inputLabel = ccon::stripArgSeparators(inputArg);
-   const std::string strippedSeps =
-      inputArg.substr(0, inputArg.size() - inputLabel.size());
-
-   std::vector<std::string> candidates;
-
-   for (const ccon::CmdSpec& cmdSpec : cmds)
+   // Consecutive spaces produce empty words that are no values.
+   std::size_t numPrevValues = 0;
+   for (std::size_t pieceIdx = cmdPieces.size() - 1; pieceIdx-- > 1;)
    {
-      if (cmdSpec.matchesName(cmdName))
+      const std::string& piece = cmdPieces[pieceIdx];
+      if (ccon::isArgLabel(piece))
       {
-         for (const ccon::ArgSpec& argSpec : cmdSpec)
-         {
-            if (argSpec.hasLabel() && sutil::startsWith(argSpec.label(), inputLabel))
-               candidates.push_back(strippedSeps + argSpec.label());
-         }
-
-         break;
+         // Values of an optional argument follow its label.
+         const std::string_view label = ccon::stripArgSeparatorsView(piece);
+         const auto argSpec = std::find_if(
+            spec.begin(), spec.end(),
+            [label](const ccon::ArgSpec& argSpec) { return argSpec.matchLabel(label); });
+         if (argSpec == spec.end() || numPrevValues >= argSpec->numValues())
+            return nullptr;
+         return &*argSpec;
       }
+      if (!piece.empty())
+         ++numPrevValues;
    }
 
-   return candidates;
-}
-
-
-std::vector<std::string> autoComplete(const std::string& input,
-                                      const std::set<ccon::CmdSpec>& cmds)
-{
-   std::vector<std::string> cmdPieces = sutil::split(input, " ");
-   if (cmdPieces.empty())
-      return {};
-
-   if (cmdPieces.size() == 1)
+   // Positional arguments come first.
+   for (const ccon::ArgSpec& argSpec : spec)
    {
-      return autoCompleteCmdName(sutil::lowercase(cmdPieces[0]), cmds);
+      if (argSpec.hasLabel())
+         break;
+      if (numPrevValues < argSpec.numValues())
+         return &argSpec;
+      numPrevValues -= argSpec.numValues();
    }
-   else
-   {
-      const std::vector<std::string> argCompletions = autoCompleteCmdArg(
-         sutil::lowercase(cmdPieces[0]), sutil::lowercase(*cmdPieces.rbegin()), cmds);
-
-      const std::string inputFront =
-         sutil::join(cmdPieces.begin(), (cmdPieces.rbegin() + 1).base(), " ") + ' ';
+   return nullptr;
+}
 
-      std::vector<std::string> inputCompletions;
-      for (const std::string& completedArg : argCompletions)
-         inputCompletions.push_back(inputFront + completedArg);
 
-      return inputCompletions;
-   }
+bool startsWith(std::string_view text, std::string_view prefix)
+{
+   return text.compare(0, prefix.size(), prefix) == 0;
 }
 
 } // namespace
@@ -90,7 +70,48 @@ namespace ccon
 
 void AutoCompletion::setCmds(const std::set<CmdSpec>& cmds)
 {
-   m_cmds = cmds;
+   m_lastMatches = {};
+   m_cmdNames.clear();
+   m_cmdArgs.clear();
+   for (const CmdSpec& spec : cmds)
+      addCmd(spec);
+}
+
+
+void AutoCompletion::addCmd(const CmdSpec& spec)
+{
+   if (m_cmdArgs.count(spec.name()) > 0)
+      return;
+   // The last matches would miss the command.
+   m_lastMatches = {};
+
+   auto args = std::make_shared<CmdArgs>();
+   args->spec = spec;
+   for (const ArgSpec& argSpec : spec)
+   {
+      if (argSpec.hasLabel())
+      {
+         args->labels.add(argSpec.label());
+         if (!argSpec.abbreviation().empty())
+            args->labels.add(argSpec.abbreviation(), argSpec.label());
+      }
+   }
+
+   m_cmdNames.add(spec.name());
+   m_cmdArgs.emplace(spec.name(), args);
+   if (!spec.abbreviation().empty())
+   {
+      m_cmdNames.add(spec.abbreviation(), spec.name());
+      m_cmdArgs.emplace(spec.abbreviation(), args);
+   }
+}
+
+
+void AutoCompletion::setMode(CompletionMode mode)
+{
+   m_mode = mode;
+   m_lastMatches = {};
+   reset();
 }
 
 
@@ -118,9 +139,11 @@ void AutoCompletion::reset()
 
 void AutoCompletion::complete(const std::string& pattern)
 {
-   m_completedPattern = pattern;
-   m_completions = autoComplete(pattern, m_cmds);
+   m_isCompletionPending = false;
+   m_completions = autoComplete(pattern);
    m_next = m_completions.begin();
+   // Completions that are still being looked up are requested again next time.
+   m_completedPattern = m_isCompletionPending ? std::string{} : pattern;
 }
 
 
@@ -146,4 +169,132 @@ std::string AutoCompletion::next()
    return (m_next != m_completions.end()) ? *m_next++ : "";
 }
 
+
+std::vector<std::string> AutoCompletion::autoComplete(const std::string& input)
+{
+   std::vector<std::string> cmdPieces = sutil::split(input, " ");
+   if (cmdPieces.empty())
+      return {};
+
+   if (cmdPieces.size() == 1)
+   {
+      return find(m_cmdNames, sutil::lowercase(cmdPieces[0]), input);
+   }
+   else
+   {
+      const std::vector<std::string> argCompletions = autoCompleteCmdArg(cmdPieces, input);
+
+      const std::string inputFront =
+         sutil::join(cmdPieces.begin(), (cmdPieces.rbegin() + 1).base(), " ") + ' ';
+
+      std::vector<std::string> inputCompletions;
+      for (const std::string& completedArg : argCompletions)
+         inputCompletions.push_back(inputFront + completedArg);
+
+      return inputCompletions;
+   }
+}
+
+
+std::vector<std::string>
+AutoCompletion::autoCompleteCmdArg(const std::vector<std::string>& cmdPieces,
+                                   const std::string& input)
+{
+   const auto cmdArgs = m_cmdArgs.find(sutil::lowercase(cmdPieces.front()));
+   if (cmdArgs == m_cmdArgs.end())
+      return {};
+
+   // Words that are not labels can be values. Arguments whose values cannot be
+   // completed keep completing labels.
+   const std::string& inputArg = cmdPieces.back();
+   if (!isArgLabel(inputArg))
+   {
+      if (const ArgSpec* valueSpec = findValueArgSpec(cmdArgs->second->spec, cmdPieces))
+      {
+         if (std::optional<std::vector<std::string>> values =
+                autoCompleteArgValue(*valueSpec, inputArg))
+         {
+            return *values;
+         }
+      }
+   }
+
+   const std::string lowercaseArg = sutil::lowercase(inputArg);
+   const std::string inputLabel = stripArgSeparators(lowercaseArg);
+   const std::string strippedSeps =
+      lowercaseArg.substr(0, lowercaseArg.size() - inputLabel.size());
+
+   std::vector<std::string> candidates = find(cmdArgs->second->labels, inputLabel, input);
+   for (std::string& candidate : candidates)
+      candidate.insert(0, strippedSeps);
+   return candidates;
+}
+
+
+std::optional<std::vector<std::string>>
+AutoCompletion::autoCompleteArgValue(const ArgSpec& argSpec, const std::string& inputValue)
+{
+   if (argSpec.completionProvider())
+   {
+      std::optional<std::vector<std::string>> values =
+         argSpec.completionProvider()->complete(inputValue);
+      if (!values)
+      {
+         m_isCompletionPending = true;
+         return std::vector<std::string>{};
+      }
+      return values;
+   }
+
+   if (argSpec.valueType().kind() == ValueKind::Path)
+      return m_pathCompletion.complete(inputValue);
+
+   if (argSpec.valueType().kind() == ValueKind::Enum)
+   {
+      // Enum members are lowercase.
+      const std::string lowercaseValue = sutil::lowercase(inputValue);
+      std::vector<std::string> members;
+      for (const std::string& member : argSpec.valueType().enumMembers())
+         if (startsWith(member, lowercaseValue))
+            members.push_back(member);
+      std::sort(members.begin(), members.end());
+      return members;
+   }
+
+   return std::nullopt;
+}
+
+
+std::vector<std::string> AutoCompletion::find(const CompletionIndex& index,
+                                              const std::string& pattern,
+                                              const std::string& input)
+{
+   // Without a pattern all candidates match equally well.
+   const CompletionMode mode = pattern.empty() ? CompletionMode::Prefix : m_mode;
+
+   if (canNarrow(index, mode, input))
+      index.narrow(m_lastMatches.matches, pattern);
+   else
+      m_lastMatches.matches = index.match(pattern, mode);
+   m_lastMatches.input = input;
+   m_lastMatches.index = &index;
+
+   const std::size_t maxResults = mode == CompletionMode::Fuzzy
+                                     ? MaxFuzzyCompletions
+                                     : std::numeric_limits<std::size_t>::max();
+   return index.completions(m_lastMatches.matches, maxResults);
+}
+
+
+bool AutoCompletion::canNarrow(const CompletionIndex& index, CompletionMode mode,
+                               const std::string& input) const
+{
+   // The input has to extend the last input within its last word. Otherwise its
+   // last word could belong to a different command or argument.
+   const std::string& lastInput = m_lastMatches.input;
+   return m_lastMatches.index == &index && m_lastMatches.matches.mode == mode &&
+          input.compare(0, lastInput.size(), lastInput) == 0 &&
+          input.find(' ', lastInput.size()) == std::string::npos;
+}
+
 } // namespace ccon
@@ -6,8 +6,14 @@
 //
 #pragma once
 #include "cmd_spec.h"
+#include "completion_index.h"
+#include "path_completion.h"
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 
@@ -18,7 +24,23 @@ namespace ccon
 class AutoCompletion
 {
 public:
+   // Number of best matches that fuzzy completion returns.
+   static constexpr std::size_t MaxFuzzyCompletions = 100;
+
+public:
+   AutoCompletion() = default;
+   ~AutoCompletion() = default;
+   AutoCompletion(const AutoCompletion&) = delete;
+   AutoCompletion(AutoCompletion&&) = delete;
+   AutoCompletion& operator=(const AutoCompletion&) = delete;
+   AutoCompletion& operator=(AutoCompletion&&) = delete;
+
+   // Replaces the completed commands.
    void setCmds(const std::set<CmdSpec>& cmds);
+   // Makes a command completable. Commands whose names are already known as name or
+   // abbreviation are ignored.
+   void addCmd(const CmdSpec& spec);
+   void setMode(CompletionMode mode);
    std::string next(const std::string& pattern);
    std::vector<std::string> all(const std::string& pattern);
    void reset();
@@ -27,10 +49,44 @@ private:
    void complete(const std::string& pattern);
    void completeIfNecessary(const std::string& pattern);
    std::string next();
+   std::vector<std::string> autoComplete(const std::string& input);
+   std::vector<std::string> autoCompleteCmdArg(const std::vector<std::string>& cmdPieces,
+                                               const std::string& input);
+   std::optional<std::vector<std::string>> autoCompleteArgValue(const ArgSpec& argSpec,
+                                                                const std::string& inputValue);
+   std::vector<std::string> find(const CompletionIndex& index, const std::string& pattern,
+                                 const std::string& input);
+   bool canNarrow(const CompletionIndex& index, CompletionMode mode,
+                  const std::string& input) const;
 
 private:
-   std::set<CmdSpec> m_cmds;
+   CompletionMode m_mode = CompletionMode::Prefix;
+   // Command names. Abbreviations complete to the names.
+   CompletionIndex m_cmdNames;
+   struct CmdArgs
+   {
+      CmdSpec spec;
+      // Argument abbreviations complete to the labels.
+      CompletionIndex labels;
+   };
+   // Arguments of each command by the name and abbreviation of the command.
+   std::unordered_map<std::string, std::shared_ptr<const CmdArgs>> m_cmdArgs;
+   // Completes values of path arguments that have no completion provider of their
+   // own.
+   PathCompletionProvider m_pathCompletion;
+   // Matches of the last completion. They are kept across resets, so that completing
+   // an input that extends the last input only has to narrow them down.
+   struct LastMatches
+   {
+      std::string input;
+      const CompletionIndex* index = nullptr;
+      CompletionIndex::Matches matches;
+   };
+   LastMatches m_lastMatches;
    std::string m_completedPattern;
+   // Set if a value completion provider is still looking up the completions of the
+   // completed pattern.
+   bool m_isCompletionPending = false;
    std::vector<std::string> m_completions;
    std::vector<std::string>::const_iterator m_next;
 };
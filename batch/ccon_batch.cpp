@@ -0,0 +1,59 @@
+//
+// ccon batch
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+// Executes command lines from stdin and writes their output to stdout, e.g.
+//    ccon_batch < commands.txt > output.txt
+// Empty lines and lines starting with '#' are skipped. The 'exit' command stops
+// the execution.
+//
+#include "file_output_sink.h"
+#include "headless_console_ui.h"
+#include "user_cmds.h"
+#include "console.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+
+namespace
+{
+///////////////////
+
+bool isSkippedLine(std::string_view line)
+{
+   const std::size_t start = line.find_first_not_of(" \t\r");
+   return start == std::string_view::npos || line[start] == '#';
+}
+
+} // namespace
+
+
+///////////////////
+
+int main()
+{
+   // Reading stdin through the C++ streams is only fast without synchronization.
+   std::ios::sync_with_stdio(false);
+
+   HeadlessConsoleUI ui;
+   ccon::Console console{ui};
+   addUserCommands(console);
+
+   FileOutputSink out{stdout};
+   std::string line;
+   while (!ui.isExitRequested() && std::getline(std::cin, line))
+   {
+      if (!line.empty() && line.back() == '\r')
+         line.pop_back();
+      if (!isSkippedLine(line))
+         console.execute(line, out);
+   }
+
+   out.flush();
+   return out.flushBuffer() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
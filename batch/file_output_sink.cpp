@@ -0,0 +1,45 @@
+//
+// ccon batch
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "file_output_sink.h"
+
+
+///////////////////
+
+FileOutputSink::FileOutputSink(std::FILE* file, std::size_t bufferSize)
+: m_file{file}, m_bufferSize{bufferSize}
+{
+   m_buffer.reserve(m_bufferSize);
+}
+
+
+FileOutputSink::~FileOutputSink()
+{
+   flush();
+   flushBuffer();
+}
+
+
+bool FileOutputSink::flushBuffer()
+{
+   if (m_buffer.empty())
+      return std::fflush(m_file) == 0;
+
+   const std::size_t numWritten = std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+   const bool isWritten = numWritten == m_buffer.size();
+   m_buffer.clear();
+   return isWritten && std::fflush(m_file) == 0;
+}
+
+
+void FileOutputSink::consumeLine(std::string_view line)
+{
+   if (m_buffer.size() + line.size() + 1 > m_bufferSize)
+      flushBuffer();
+
+   m_buffer += line;
+   m_buffer += '\n';
+}
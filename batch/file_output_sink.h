@@ -0,0 +1,44 @@
+//
+// ccon batch
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "output_sink.h"
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+
+///////////////////
+
+// Writes output lines to a file through a large buffer, so that the file gets
+// written in few large chunks.
+class FileOutputSink : public ccon::OutputSink
+{
+ public:
+   static constexpr std::size_t DefaultBufferSize = 1024 * 1024;
+
+ public:
+   // The file is not closed by the sink.
+   explicit FileOutputSink(std::FILE* file, std::size_t bufferSize = DefaultBufferSize);
+   // Writes the buffered output.
+   ~FileOutputSink();
+   FileOutputSink(const FileOutputSink&) = delete;
+   FileOutputSink(FileOutputSink&&) = delete;
+   FileOutputSink& operator=(const FileOutputSink&) = delete;
+   FileOutputSink& operator=(FileOutputSink&&) = delete;
+
+   // Writes the buffered output to the file. Returns false if writing failed.
+   bool flushBuffer();
+
+ protected:
+   void consumeLine(std::string_view line) override;
+
+ private:
+   std::FILE* m_file = nullptr;
+   std::size_t m_bufferSize = 0;
+   std::string m_buffer;
+};
@@ -0,0 +1,33 @@
+//
+// ccon batch
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "console_ui.h"
+
+
+///////////////////
+
+// Console UI without display. Records whether the console was asked to close.
+class HeadlessConsoleUI : public ccon::ConsoleUI
+{
+ public:
+   void setContent(ccon::ConsoleContent*) override {}
+   void showConsole() override {}
+   // The exit command hides the console.
+   void hideConsole() override { m_isExitRequested = true; }
+   void setBackgroundColor(const sutil::Rgb&) override {}
+   void setOutputTextColor(const sutil::Rgb&) override {}
+   void setInputTextColor(const sutil::Rgb&) override {}
+   void resetColors() override {}
+   void setFontSize(int) override {}
+   // Commands execute synchronously. No output arrives later.
+   void notifyPendingOutput() override {}
+
+   bool isExitRequested() const { return m_isExitRequested; }
+
+ private:
+   bool m_isExitRequested = false;
+};
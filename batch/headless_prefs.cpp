@@ -0,0 +1,22 @@
+//
+// ccon batch
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+// The console's preferences depend on Win32 and are not linked into the batch
+// runner. The built-in font size command still needs the default font size.
+//
+#include "preferences.h"
+
+
+namespace ccon
+{
+///////////////////
+
+int DefaultPrefs::fontSize()
+{
+   return 11;
+}
+
+} // namespace ccon
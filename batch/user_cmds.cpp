@@ -0,0 +1,50 @@
+//
+// ccon batch
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "user_cmds.h"
+#include "cmd.h"
+#include "cmd_spec.h"
+#include "console.h"
+#include <memory>
+#include <string>
+
+
+namespace
+{
+///////////////////
+
+ccon::CmdSpec makeEchoCmdSpec()
+{
+   return {"echo",
+           "",
+           "outputs its arguments",
+           {ccon::ArgSpec::makePositionalArg(ccon::ArgSpec::ZeroOrMore, "text to output")},
+           ""};
+}
+
+
+struct EchoCmd : public ccon::StreamingCmd
+{
+   using ccon::StreamingCmd::execute;
+   void execute(const ccon::VerifiedCmd& input, ccon::OutputSink& out) override
+   {
+      std::string text;
+      for (const ccon::VerifiedArg& arg : input.args)
+         for (const std::string& value : arg.values)
+            text += (text.empty() ? "" : " ") + value;
+      out.writeLine(text);
+   }
+};
+
+} // namespace
+
+
+///////////////////
+
+void addUserCommands(ccon::Console& console)
+{
+   console.addCommand(makeEchoCmdSpec(), []() { return std::make_unique<EchoCmd>(); });
+}
@@ -0,0 +1,17 @@
+//
+// ccon batch
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+
+namespace ccon
+{
+class Console;
+}
+
+
+// Adds the domain-specific commands to the console of the batch runner. Replace
+// the example command with the commands of your application.
+void addUserCommands(ccon::Console& console);
@@ -0,0 +1,190 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "auto_completion_bench.h"
+#include "auto_completion.h"
+#include "bench_generators.h"
+#include "bench_util.h"
+#include "path_completion.h"
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace ccon;
+namespace fs = std::filesystem;
+
+
+namespace
+{
+///////////////////
+
+void benchAutoCompletionNext()
+{
+   const std::vector<std::size_t> numCmds = {10, 1000, 10000, 50000};
+
+   for (std::size_t n : numCmds)
+   {
+      AutoCompletion ac;
+      ac.setCmds(makeSpecCatalog(n));
+
+      // Reset before each call to force a new completion instead of cycling
+      // through the candidates of the previous one.
+      const std::string pattern = "command1";
+      const BenchResult result = measure(1000, [&]() {
+         ac.reset();
+         ac.next(pattern);
+      });
+      reportResult("AutoCompletion::next", n, result);
+   }
+
+   for (std::size_t n : numCmds)
+   {
+      AutoCompletion ac;
+      ac.setCmds(makeSpecCatalog(n));
+
+      const std::string pattern = "command1";
+      ac.next(pattern);
+      const BenchResult result = measure(100000, [&]() { ac.next(pattern); });
+      reportResult("AutoCompletion::next (cycling)", n, result);
+   }
+}
+
+
+
+void benchAutoCompletionAddCmd()
+{
+   const std::vector<std::size_t> numCmds = {1000, 10000, 50000};
+
+   for (std::size_t n : numCmds)
+   {
+      const std::set<CmdSpec> catalog = makeSpecCatalog(n);
+
+      // Completes the added name after each registration to verify that commands
+      // become completable without rebuilding the index.
+      const BenchResult result = measure(1, [&]() {
+         AutoCompletion ac;
+         for (const CmdSpec& spec : catalog)
+         {
+            ac.addCmd(spec);
+            ac.reset();
+            ac.next(spec.name());
+         }
+      });
+      reportResult("AutoCompletion::addCmd", n, result);
+   }
+}
+
+
+
+void benchAutoCompletionFuzzy()
+{
+   const std::vector<std::size_t> numCmds = {1000, 10000, 100000};
+
+   for (std::size_t n : numCmds)
+   {
+      AutoCompletion ac;
+      ac.setCmds(makeSpecCatalog(n));
+      ac.setMode(CompletionMode::Fuzzy);
+
+      // Every name of the catalog contains the characters of the pattern, so all
+      // of them get scored.
+      const std::string pattern = "cmd12";
+      const BenchResult result = measure(100, [&]() {
+         ac.reset();
+         ac.next(pattern);
+      });
+      reportResult("AutoCompletion::next (fuzzy)", n, result);
+   }
+}
+
+
+
+void benchAutoCompletionTyping()
+{
+   const std::vector<std::size_t> numCmds = {1000, 10000, 100000};
+   const std::string typedName = "command12345";
+
+   for (CompletionMode mode : {CompletionMode::Prefix, CompletionMode::Fuzzy})
+   {
+      for (std::size_t n : numCmds)
+      {
+         AutoCompletion ac;
+         ac.setCmds(makeSpecCatalog(n));
+         ac.setMode(mode);
+
+         // Completes after each typed character like a completion popup. Only the
+         // first character searches the whole catalog.
+         const BenchResult result = measure(10, [&]() {
+            for (std::size_t len = 1; len <= typedName.size(); ++len)
+            {
+               ac.reset();
+               ac.next(typedName.substr(0, len));
+            }
+         });
+         reportResult(mode == CompletionMode::Fuzzy ? "AutoCompletion typing (fuzzy)"
+                                                    : "AutoCompletion typing",
+                      n, result);
+      }
+   }
+}
+
+
+
+void benchPathCompletion()
+{
+   const std::vector<std::size_t> numEntries = {1000, 10000, 100000};
+
+   for (std::size_t n : numEntries)
+   {
+      const fs::path dir =
+         fs::temp_directory_path() /
+         ("ccon_bench_" +
+          std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+      fs::create_directories(dir);
+      for (std::size_t i = 0; i < n; ++i)
+         std::ofstream{dir / ("file" + std::to_string(i))};
+
+      PathCompletionProvider provider{dir};
+      const std::string prefix = "file1234";
+
+      // Reads the directory for each completion.
+      const BenchResult scanResult = measure(5, [&]() {
+         provider.invalidate();
+         provider.complete(prefix);
+      });
+      reportResult("PathCompletion scan", n, scanResult);
+
+      // Looks the prefix up in the cached listing.
+      provider.complete(prefix);
+      const BenchResult cachedResult = measure(1000, [&]() { provider.complete(prefix); });
+      reportResult("PathCompletion cached", n, cachedResult);
+
+      std::error_code ec;
+      fs::remove_all(dir, ec);
+   }
+}
+
+} // namespace
+
+
+void benchAutoCompletion()
+{
+   if (isBenchSelected("AutoCompletion::next"))
+      benchAutoCompletionNext();
+   if (isBenchSelected("AutoCompletion::addCmd"))
+      benchAutoCompletionAddCmd();
+   if (isBenchSelected("AutoCompletion::next (fuzzy)"))
+      benchAutoCompletionFuzzy();
+   if (isBenchSelected("AutoCompletion typing"))
+      benchAutoCompletionTyping();
+   if (isBenchSelected("PathCompletion"))
+      benchPathCompletion();
+}
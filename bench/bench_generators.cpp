@@ -0,0 +1,57 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "bench_generators.h"
+#include "blackboard.h"
+
+using namespace ccon;
+
+
+///////////////////
+
+std::string makeCatalogCmdName(std::size_t idx)
+{
+   return "command" + std::to_string(idx);
+}
+
+
+CmdSpec makeCatalogSpec(std::size_t idx)
+{
+   return {makeCatalogCmdName(idx),
+           "c" + std::to_string(idx),
+           "generated command " + std::to_string(idx),
+           {ArgSpec::makePositionalArg(ArgSpec::OneOrMore, "values"),
+            ArgSpec::makeOptionalArg("size", 1, "s", "size of the thing"),
+            ArgSpec::makeFlagArg("verbose", "v", "verbose output")},
+           ""};
+}
+
+
+std::set<CmdSpec> makeSpecCatalog(std::size_t numCmds)
+{
+   std::set<CmdSpec> catalog;
+   for (std::size_t i = 0; i < numCmds; ++i)
+      catalog.insert(makeCatalogSpec(i));
+   return catalog;
+}
+
+
+std::string makeLongArgLine(const std::string& cmdName, std::size_t numValues)
+{
+   std::string cmdLine = cmdName;
+   for (std::size_t i = 0; i < numValues; ++i)
+      cmdLine += " value" + std::to_string(i);
+   cmdLine += " -size 10 -verbose";
+   return cmdLine;
+}
+
+
+void fillScrollback(Blackboard& bb, std::size_t numLines)
+{
+   for (std::size_t i = 0; i < numLines; ++i)
+      bb.appendLine("output line " + std::to_string(i) +
+                    " with some text to give it a realistic length");
+}
@@ -0,0 +1,37 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd_spec.h"
+#include <cstddef>
+#include <set>
+#include <string>
+
+namespace ccon
+{
+class Blackboard;
+}
+
+
+///////////////////
+
+// Synthetic inputs for benchmarks. All generators are deterministic so that results
+// of different runs are comparable.
+
+// Name of the command at a given index of a generated spec catalog.
+std::string makeCatalogCmdName(std::size_t idx);
+// Spec of the command at a given index of a generated spec catalog. The spec has a
+// positional argument, an optional argument and a flag.
+ccon::CmdSpec makeCatalogSpec(std::size_t idx);
+// Catalog of a given number of command specs.
+std::set<ccon::CmdSpec> makeSpecCatalog(std::size_t numCmds);
+
+// Command line for a given command with a given number of positional values
+// followed by a few options.
+std::string makeLongArgLine(const std::string& cmdName, std::size_t numValues);
+
+// Appends a given number of output lines to a blackboard.
+void fillScrollback(ccon::Blackboard& bb, std::size_t numLines);
@@ -0,0 +1,118 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "bench_util.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+
+namespace
+{
+///////////////////
+
+std::atomic<std::size_t> numHeapAllocations = 0;
+ReportFormat reportFormat = ReportFormat::Table;
+std::string benchFilter;
+
+
+// Escapes the characters of a text that are special in JSON strings.
+std::string jsonEscape(const std::string& s)
+{
+   std::string escaped;
+   escaped.reserve(s.size());
+   for (char ch : s)
+   {
+      if (ch == '"' || ch == '\\')
+         escaped += '\\';
+      escaped += ch;
+   }
+   return escaped;
+}
+
+
+void reportTableRow(const std::string& label, std::size_t size, const BenchResult& result)
+{
+   std::cout << std::left << std::setw(40) << label << std::right << std::setw(10) << size
+             << std::fixed << std::setprecision(1) << std::setw(14) << result.nsPerOp
+             << " ns/op" << std::setw(10) << result.allocsPerOp << " allocs/op"
+             << std::setw(12) << result.p50Ns << " p50" << std::setw(12) << result.p99Ns
+             << " p99\n";
+}
+
+
+void reportJsonLine(const std::string& label, std::size_t size, const BenchResult& result)
+{
+   std::cout << std::fixed << std::setprecision(2) << "{\"bench\":\"" << jsonEscape(label)
+             << "\",\"size\":" << size << ",\"ns_per_op\":" << result.nsPerOp
+             << ",\"allocs_per_op\":" << result.allocsPerOp
+             << ",\"p50_ns\":" << result.p50Ns << ",\"p90_ns\":" << result.p90Ns
+             << ",\"p99_ns\":" << result.p99Ns << "}\n";
+}
+
+} // namespace
+
+
+///////////////////
+
+// Replacements of the global allocation functions that count the heap allocations.
+// The other forms of new and delete are implemented in terms of these.
+void* operator new(std::size_t size)
+{
+   ++numHeapAllocations;
+   if (void* mem = std::malloc(size > 0 ? size : 1))
+      return mem;
+   throw std::bad_alloc{};
+}
+
+
+void operator delete(void* mem) noexcept
+{
+   std::free(mem);
+}
+
+
+void operator delete(void* mem, std::size_t) noexcept
+{
+   std::free(mem);
+}
+
+
+///////////////////
+
+void setReportFormat(ReportFormat format)
+{
+   reportFormat = format;
+}
+
+
+void setBenchFilter(const std::string& filter)
+{
+   benchFilter = filter;
+}
+
+
+bool isBenchSelected(const std::string& label)
+{
+   return benchFilter.empty() || label.find(benchFilter) != std::string::npos;
+}
+
+
+void reportResult(const std::string& label, std::size_t size, const BenchResult& result)
+{
+   if (reportFormat == ReportFormat::JsonLines)
+      reportJsonLine(label, size, result);
+   else
+      reportTableRow(label, size, result);
+}
+
+
+std::size_t countHeapAllocations()
+{
+   return numHeapAllocations;
+}
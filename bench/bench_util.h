@@ -0,0 +1,105 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+///////////////////
+
+// Measurements of an operation.
+struct BenchResult
+{
+   double nsPerOp = 0.0;
+   double allocsPerOp = 0.0;
+   // Percentiles of the time per operation. Sampled over batches of operations
+   // because single operations are too short to be timed reliably.
+   double p50Ns = 0.0;
+   double p90Ns = 0.0;
+   double p99Ns = 0.0;
+};
+
+
+enum class ReportFormat
+{
+   // Aligned columns for reading.
+   Table,
+   // One JSON object per line for tracking results with tools.
+   JsonLines
+};
+
+
+void setReportFormat(ReportFormat format);
+// Limits the benchmarks that are run to the ones whose labels contain a given
+// text.
+void setBenchFilter(const std::string& filter);
+bool isBenchSelected(const std::string& label);
+void reportResult(const std::string& label, std::size_t size, const BenchResult& result);
+
+// Returns the number of heap allocations that the benchmark program made so far.
+std::size_t countHeapAllocations();
+
+
+///////////////////
+
+// Runs a given function a number of times and measures the time and heap
+// allocations per call.
+template <typename Fn> BenchResult measure(std::size_t numIterations, Fn fn)
+{
+   using Clock = std::chrono::steady_clock;
+   constexpr std::size_t MaxSamples = 200;
+
+   const std::size_t numSamples = std::clamp<std::size_t>(numIterations, 1, MaxSamples);
+   const std::size_t batchSize = std::max<std::size_t>(numIterations / numSamples, 1);
+
+   // Warm up caches and lazily initialized state.
+   for (std::size_t i = 0; i < batchSize; ++i)
+      fn();
+
+   std::vector<double> samples;
+   samples.reserve(numSamples);
+   Clock::duration elapsed{0};
+
+   const std::size_t allocsBefore = countHeapAllocations();
+   for (std::size_t sample = 0; sample < numSamples; ++sample)
+   {
+      const Clock::time_point start = Clock::now();
+      for (std::size_t i = 0; i < batchSize; ++i)
+         fn();
+      const Clock::duration batchTime = Clock::now() - start;
+
+      elapsed += batchTime;
+      samples.push_back(
+         static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(batchTime).count()) /
+         static_cast<double>(batchSize));
+   }
+   const std::size_t numAllocs = countHeapAllocations() - allocsBefore;
+   const double numOps = static_cast<double>(numSamples * batchSize);
+
+   std::sort(samples.begin(), samples.end());
+   auto percentile = [&samples](double p) {
+      const std::size_t idx = static_cast<std::size_t>(p * (samples.size() - 1) + 0.5);
+      return samples[idx];
+   };
+
+   BenchResult result;
+   result.nsPerOp =
+      static_cast<double>(
+         std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+      numOps;
+   // The sample vector was reserved up front, so all counted allocations are made
+   // by the measured function.
+   result.allocsPerOp = static_cast<double>(numAllocs) / numOps;
+   result.p50Ns = percentile(0.5);
+   result.p90Ns = percentile(0.9);
+   result.p99Ns = percentile(0.99);
+   return result;
+}
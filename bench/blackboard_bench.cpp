@@ -0,0 +1,44 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "blackboard_bench.h"
+#include "bench_generators.h"
+#include "bench_util.h"
+#include "blackboard.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void benchBlackboardAppendLine()
+{
+   const std::vector<std::size_t> scrollbackSizes = {0, 10000, 1000000};
+
+   for (std::size_t n : scrollbackSizes)
+   {
+      Blackboard bb{"> "};
+      fillScrollback(bb, n);
+
+      const std::string line = "appended output line with some text";
+      const BenchResult result = measure(100000, [&]() { bb.appendLine(line); });
+      reportResult("Blackboard::appendLine", n, result);
+   }
+}
+
+} // namespace
+
+
+void benchBlackboard()
+{
+   if (isBenchSelected("Blackboard::appendLine"))
+      benchBlackboardAppendLine();
+}
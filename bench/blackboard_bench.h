@@ -0,0 +1,9 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+
+void benchBlackboard();
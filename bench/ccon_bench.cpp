@@ -0,0 +1,64 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "auto_completion_bench.h"
+#include "bench_util.h"
+#include "blackboard_bench.h"
+#include "cmd_depot_bench.h"
+#include "cmd_spec_bench.h"
+#include "formatting_bench.h"
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+
+namespace
+{
+///////////////////
+
+void printUsage()
+{
+   std::cout << "Usage: ccon_bench [--json] [--filter <text>]\n"
+                "  --json           Print results as JSON lines.\n"
+                "  --filter <text>  Run only benchmarks whose label contains the text.\n";
+}
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+   bool printJson = false;
+   for (int i = 1; i < argc; ++i)
+   {
+      const std::string_view arg = argv[i];
+      if (arg == "--json")
+      {
+         printJson = true;
+      }
+      else if (arg == "--filter" && i + 1 < argc)
+      {
+         setBenchFilter(argv[++i]);
+      }
+      else
+      {
+         printUsage();
+         return EXIT_FAILURE;
+      }
+   }
+   setReportFormat(printJson ? ReportFormat::JsonLines : ReportFormat::Table);
+
+   benchCmdDepot();
+   benchCmdSpec();
+   benchAutoCompletion();
+   benchBlackboard();
+   benchFormatting();
+
+   // Keep the output of the JSON format parsable.
+   if (!printJson)
+      std::cout << "ccon benchmarks finished.\n";
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "cmd_depot_bench.h"
+#include "bench_generators.h"
+#include "bench_util.h"
+#include "cmd_depot.h"
+#include "cmd_spec.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+struct BenchCmd : public Cmd
+{
+   CmdOutput execute(const VerifiedCmd& /*input*/) override { return {}; }
+};
+
+
+void populateDepot(CmdDepot& depot, std::size_t numCmds)
+{
+   auto cmdFactory = []() { return std::make_unique<BenchCmd>(); };
+
+   for (std::size_t i = 0; i < numCmds; ++i)
+      depot.addCommand(makeCatalogSpec(i), cmdFactory);
+}
+
+
+///////////////////
+
+void benchCmdDepotMatchCommand()
+{
+   const std::vector<std::size_t> numCmds = {10, 100, 1000, 10000, 100000};
+   const std::size_t numIterations = 100000;
+
+   for (std::size_t n : numCmds)
+   {
+      CmdDepot depot;
+      populateDepot(depot, n);
+
+      // Pick commands from the front, middle, and back of the catalog so that
+      // any dependency on the position of the spec would show up.
+      const std::vector<std::string> cmdLines = {
+         makeCatalogCmdName(0) + " target -size 10 -verbose",
+         makeCatalogCmdName(n / 2) + " target -size 10 -verbose",
+         makeCatalogCmdName(n - 1) + " target -size 10 -verbose",
+      };
+
+      std::size_t lineIdx = 0;
+      const BenchResult result = measure(numIterations, [&]() {
+         depot.matchCommand(cmdLines[lineIdx++ % cmdLines.size()]);
+      });
+      reportResult("CmdDepot::matchCommand", n, result);
+   }
+
+   for (std::size_t n : numCmds)
+   {
+      CmdDepot depot;
+      populateDepot(depot, n);
+
+      const std::string cmdLine = "unknown target -size 10 -verbose";
+      const BenchResult result =
+         measure(numIterations, [&]() { depot.matchCommand(cmdLine); });
+      reportResult("CmdDepot::matchCommand (not found)", n, result);
+   }
+}
+
+
+void benchCmdDepotGetCommandHelp()
+{
+   const std::vector<std::size_t> numCmds = {10, 1000, 100000};
+
+   for (std::size_t n : numCmds)
+   {
+      CmdDepot depot;
+      populateDepot(depot, n);
+
+      const std::string cmdName = makeCatalogCmdName(n / 2);
+      const BenchResult result =
+         measure(10000, [&]() { depot.getCommandHelp(cmdName); });
+      reportResult("CmdDepot::getCommandHelp", n, result);
+   }
+}
+
+} // namespace
+
+
+void benchCmdDepot()
+{
+   if (isBenchSelected("CmdDepot::matchCommand"))
+      benchCmdDepotMatchCommand();
+   if (isBenchSelected("CmdDepot::getCommandHelp"))
+      benchCmdDepotGetCommandHelp();
+}
@@ -0,0 +1,102 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "cmd_spec_bench.h"
+#include "bench_generators.h"
+#include "bench_util.h"
+#include "cmd_spec.h"
+#include "console_util.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+CmdSpec makeBenchSpec()
+{
+   return {"run",
+           "r",
+           "",
+           {ArgSpec::makePositionalArg(ArgSpec::OneOrMore),
+            ArgSpec::makeOptionalArg("size", 1, "s"), ArgSpec::makeFlagArg("verbose", "v")},
+           ""};
+}
+
+
+///////////////////
+
+void benchCmdSpecMatch()
+{
+   const std::vector<std::size_t> numValues = {1, 10, 100, 1000};
+   const CmdSpec spec = makeBenchSpec();
+
+   for (std::size_t n : numValues)
+   {
+      const std::string cmdLine = makeLongArgLine("run", n);
+      const BenchResult result = measure(100000 / n, [&]() { spec.match(cmdLine); });
+      reportResult("CmdSpec::match", n, result);
+   }
+
+   for (std::size_t n : numValues)
+   {
+      const std::string cmdLine = makeLongArgLine("run", n);
+      const BenchResult result =
+         measure(100000 / n, [&]() { spec.match(splitCmdLine(cmdLine)); });
+      reportResult("CmdSpec::match (views)", n, result);
+   }
+}
+
+
+CmdSpec makeManyOptionsSpec(std::size_t numOptions)
+{
+   std::vector<ArgSpec> argSpecs;
+   for (std::size_t i = 0; i < numOptions; ++i)
+      argSpecs.push_back(
+         ArgSpec::makeOptionalArg("option" + std::to_string(i), 1, "o" + std::to_string(i)));
+   return {"opts", "", "", std::move(argSpecs), ""};
+}
+
+
+// Command line that passes every option once, in reverse order of their specs.
+std::string makeManyOptionsCmdLine(std::size_t numOptions)
+{
+   std::string cmdLine = "opts";
+   for (std::size_t i = numOptions; i > 0; --i)
+      cmdLine += " -option" + std::to_string(i - 1) + " 1";
+   return cmdLine;
+}
+
+
+void benchCmdSpecMatchOptions()
+{
+   const std::vector<std::size_t> numOptions = {1, 10, 60, 200};
+
+   for (std::size_t n : numOptions)
+   {
+      const CmdSpec spec = makeManyOptionsSpec(n);
+      const std::string cmdLine = makeManyOptionsCmdLine(n);
+      const CmdArgViews cmdPieces = splitCmdLine(cmdLine);
+      const BenchResult result = measure(100000 / n, [&]() { spec.match(cmdPieces); });
+      reportResult("CmdSpec::match (options)", n, result);
+   }
+}
+
+} // namespace
+
+
+void benchCmdSpec()
+{
+   if (isBenchSelected("CmdSpec::match"))
+   {
+      benchCmdSpecMatch();
+      benchCmdSpecMatchOptions();
+   }
+}
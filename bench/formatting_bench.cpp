@@ -0,0 +1,45 @@
+//
+// ccon bench
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "formatting_bench.h"
+#include "bench_util.h"
+#include "formatting.h"
+#include <cstdint>
+#include <string>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void benchFormatIntOutput()
+{
+   const std::string label = "value";
+   std::int64_t val = 0;
+
+   const BenchResult decResult =
+      measure(100000, [&]() { formatIntOutput(val++, label, IntBase::Dec); });
+   reportResult("formatIntOutput (dec)", 1, decResult);
+
+   const BenchResult hexResult =
+      measure(100000, [&]() { formatIntOutput(val++, label, IntBase::Hex); });
+   reportResult("formatIntOutput (hex)", 1, hexResult);
+
+   const BenchResult noLabelResult =
+      measure(100000, [&]() { formatIntOutput(val++, "", IntBase::Dec); });
+   reportResult("formatIntOutput (no label)", 1, noLabelResult);
+}
+
+} // namespace
+
+
+void benchFormatting()
+{
+   if (isBenchSelected("formatIntOutput"))
+      benchFormatIntOutput();
+}
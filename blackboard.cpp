@@ -41,9 +41,16 @@ bool Blackboard::isEnteredLine(std::size_t lineIdx) const
 }
 
 
-void Blackboard::appendLine(const std::string& text)
+void Blackboard::appendLine(std::string_view text)
 {
-   m_content.push_back({text, Line::Source::Output});
+   m_content.push_back({std::string{text}, Line::Source::Output});
+}
+
+
+void Blackboard::insertOutputLine(std::string_view text)
+{
+   assert(!m_content.empty());
+   m_content.insert(m_content.end() - 1, {std::string{text}, Line::Source::Output});
 }
 
 
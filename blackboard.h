@@ -5,8 +5,10 @@
 // MIT license
 //
 #pragma once
+#include "output_sink.h"
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 
@@ -31,7 +33,9 @@ class Blackboard
    std::size_t countLines() const;
    std::string lineText(std::size_t lineIdx) const;
    bool isEnteredLine(std::size_t lineIdx) const;
-   void appendLine(const std::string& text);
+   void appendLine(std::string_view text);
+   // Inserts an output line before the input line.
+   void insertOutputLine(std::string_view text);
    // Returns the entire text of the input line.
    std::string inputLineText() const;
    // Returns only the entered text of the input line.
@@ -66,4 +70,26 @@ class Blackboard
    std::size_t m_historyIdx = 0;
 };
 
+
+///////////////////
+
+// Sink that inserts command output directly into a blackboard, before its input
+// line.
+class BlackboardOutputSink : public OutputSink
+{
+ public:
+   explicit BlackboardOutputSink(Blackboard& bb) : m_bb{bb} {}
+   ~BlackboardOutputSink() = default;
+   BlackboardOutputSink(const BlackboardOutputSink&) = delete;
+   BlackboardOutputSink(BlackboardOutputSink&&) = delete;
+   BlackboardOutputSink& operator=(const BlackboardOutputSink&) = delete;
+   BlackboardOutputSink& operator=(BlackboardOutputSink&&) = delete;
+
+ protected:
+   void consumeLine(std::string_view line) override { m_bb.insertOutputLine(line); }
+
+ private:
+   Blackboard& m_bb;
+};
+
 } // namespace ccon
@@ -0,0 +1,191 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "cancellation.h"
+#include <algorithm>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+using Clock = std::chrono::steady_clock;
+
+constexpr Clock::rep NoDeadline = Clock::duration::max().count();
+
+
+// Condition variable and mutex of an operation that waits for a token.
+struct Waiter
+{
+   std::condition_variable* cv = nullptr;
+   std::mutex* mutex = nullptr;
+};
+
+
+const char* describe(ccon::CancelReason reason)
+{
+   switch (reason)
+   {
+   case ccon::CancelReason::TimedOut:
+      return "Timed out.";
+   case ccon::CancelReason::Cancelled:
+   case ccon::CancelReason::None:
+      break;
+   }
+   return "Cancelled.";
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+struct CancellationToken::State
+{
+   std::atomic<CancelReason> reason = CancelReason::None;
+   // Time since the clock's epoch. Stored as count to be atomic.
+   std::atomic<Clock::rep> deadline = NoDeadline;
+   // Guards the waiters. Locked before the mutexes of the waiters.
+   std::mutex waitersMutex;
+   std::vector<Waiter*> waiters;
+
+   // Wakes the waiters, so that they notice a cancellation or a changed deadline.
+   void wakeWaiters();
+};
+
+
+void CancellationToken::State::wakeWaiters()
+{
+   std::scoped_lock lock{waitersMutex};
+   for (Waiter* waiter : waiters)
+   {
+      // Lock the waiter's mutex, so that the wakeup cannot get lost between the
+      // waiter checking the token and starting to wait.
+      std::scoped_lock waiterLock{*waiter->mutex};
+      waiter->cv->notify_all();
+   }
+}
+
+
+CancelReason CancellationToken::reason() const
+{
+   if (!m_state)
+      return CancelReason::None;
+
+   const CancelReason reason = m_state->reason.load(std::memory_order_acquire);
+   if (reason != CancelReason::None)
+      return reason;
+
+   // Check the deadline lazily instead of having a timer thread that cancels.
+   const Clock::rep deadline = m_state->deadline.load(std::memory_order_relaxed);
+   if (deadline == NoDeadline || Clock::now().time_since_epoch().count() < deadline)
+      return CancelReason::None;
+
+   // Keep an explicit cancellation that raced with the timeout.
+   CancelReason expected = CancelReason::None;
+   m_state->reason.compare_exchange_strong(expected, CancelReason::TimedOut);
+   return m_state->reason.load(std::memory_order_acquire);
+}
+
+
+///////////////////
+
+CancellationSource::CancellationSource()
+: m_state{std::make_shared<CancellationToken::State>()}
+{
+}
+
+
+void CancellationSource::cancel()
+{
+   CancelReason expected = CancelReason::None;
+   if (m_state->reason.compare_exchange_strong(expected, CancelReason::Cancelled))
+      m_state->wakeWaiters();
+}
+
+
+void CancellationSource::cancelAfter(std::chrono::milliseconds timeout)
+{
+   const Clock::time_point deadline = Clock::now() + timeout;
+   m_state->deadline.store(deadline.time_since_epoch().count(),
+                           std::memory_order_relaxed);
+   // Waiters wait until the earlier deadline.
+   m_state->wakeWaiters();
+}
+
+
+///////////////////
+
+bool waitUnlessCancelled(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                         const CancellationToken& cancellation, Clock::time_point until,
+                         const std::function<bool()>& pred)
+{
+   if (pred() || cancellation.isCancelled())
+      return pred();
+
+   CancellationToken::State* state = cancellation.m_state.get();
+   Waiter waiter{&cv, lock.mutex()};
+
+   // Register without holding the caller's lock. Waking the waiters locks the
+   // registry first and the caller's mutex second.
+   if (state)
+   {
+      lock.unlock();
+      {
+         std::scoped_lock registryLock{state->waitersMutex};
+         state->waiters.push_back(&waiter);
+      }
+      lock.lock();
+   }
+
+   while (!pred() && !cancellation.isCancelled() && Clock::now() < until)
+   {
+      const Clock::rep deadline =
+         state ? state->deadline.load(std::memory_order_relaxed) : NoDeadline;
+      Clock::time_point wakeAt = until;
+      if (deadline != NoDeadline)
+         wakeAt = std::min(wakeAt, Clock::time_point{Clock::duration{deadline}});
+
+      if (wakeAt == Clock::time_point::max())
+         cv.wait(lock);
+      else
+         cv.wait_until(lock, wakeAt);
+   }
+
+   if (state)
+   {
+      lock.unlock();
+      {
+         std::scoped_lock registryLock{state->waitersMutex};
+         state->waiters.erase(
+            std::find(state->waiters.begin(), state->waiters.end(), &waiter));
+      }
+      lock.lock();
+   }
+
+   return pred();
+}
+
+
+bool waitUnlessCancelled(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                         const CancellationToken& cancellation,
+                         const std::function<bool()>& pred)
+{
+   return waitUnlessCancelled(cv, lock, cancellation, Clock::time_point::max(), pred);
+}
+
+
+///////////////////
+
+CancelledError::CancelledError(CancelReason reason)
+: std::runtime_error{describe(reason)}, m_reason{reason}
+{
+}
+
+} // namespace ccon
@@ -0,0 +1,120 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+
+namespace ccon
+{
+///////////////////
+
+enum class CancelReason
+{
+   None,
+   // Cancelled explicitly, e.g. by the user.
+   Cancelled,
+   // Exceeded its time limit.
+   TimedOut
+};
+
+
+// Observes whether an operation was asked to stop. Operations check the token
+// regularly and stop cooperatively. Default constructed tokens are never cancelled.
+// Operations that block can wait with waitUnlessCancelled() instead of checking.
+class CancellationToken
+{
+ public:
+   CancellationToken() = default;
+   ~CancellationToken() = default;
+   CancellationToken(const CancellationToken&) = default;
+   CancellationToken(CancellationToken&&) = default;
+   CancellationToken& operator=(const CancellationToken&) = default;
+   CancellationToken& operator=(CancellationToken&&) = default;
+
+   bool isCancelled() const { return reason() != CancelReason::None; }
+   CancelReason reason() const;
+
+ private:
+   friend class CancellationSource;
+   friend bool waitUnlessCancelled(std::condition_variable&,
+                                   std::unique_lock<std::mutex>&,
+                                   const CancellationToken&,
+                                   std::chrono::steady_clock::time_point,
+                                   const std::function<bool()>&);
+   struct State;
+
+   explicit CancellationToken(std::shared_ptr<State> state) : m_state{std::move(state)} {}
+
+ private:
+   std::shared_ptr<State> m_state;
+};
+
+
+// Cancels the operations that observe its tokens.
+class CancellationSource
+{
+ public:
+   CancellationSource();
+   ~CancellationSource() = default;
+   CancellationSource(const CancellationSource&) = default;
+   CancellationSource(CancellationSource&&) = default;
+   CancellationSource& operator=(const CancellationSource&) = default;
+   CancellationSource& operator=(CancellationSource&&) = default;
+
+   CancellationToken token() const { return CancellationToken{m_state}; }
+   // Wakes the operations that wait for their tokens.
+   // Must not be called while holding the mutex of such a wait.
+   void cancel();
+   // Cancels the tokens once a given time has passed.
+   // Must not be called while holding the mutex of a wait for the tokens.
+   void cancelAfter(std::chrono::milliseconds timeout);
+   bool isCancelled() const { return token().isCancelled(); }
+
+ private:
+   std::shared_ptr<CancellationToken::State> m_state;
+};
+
+
+///////////////////
+
+// Waits on a condition variable until a predicate holds, the cancellation is
+// requested or a given time is reached. The lock has to be locked and is locked
+// again on return. Cancelling and timing out wake the wait, so that waiting
+// operations do not have to poll their cancellation. Returns the predicate's
+// result.
+bool waitUnlessCancelled(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                         const CancellationToken& cancellation,
+                         std::chrono::steady_clock::time_point until,
+                         const std::function<bool()>& pred);
+
+// Waits without a time limit of its own.
+bool waitUnlessCancelled(std::condition_variable& cv, std::unique_lock<std::mutex>& lock,
+                         const CancellationToken& cancellation,
+                         const std::function<bool()>& pred);
+
+
+///////////////////
+
+// Thrown to abort an operation that was cancelled.
+class CancelledError : public std::runtime_error
+{
+ public:
+   explicit CancelledError(CancelReason reason);
+
+   CancelReason reason() const { return m_reason; }
+
+ private:
+   CancelReason m_reason = CancelReason::Cancelled;
+};
+
+} // namespace ccon
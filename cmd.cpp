@@ -0,0 +1,28 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "cmd.h"
+
+
+namespace ccon
+{
+///////////////////
+
+void Cmd::execute(const VerifiedCmd& input, OutputSink& out)
+{
+   for (const std::string& line : execute(input))
+      out.writeLine(line);
+}
+
+
+CmdOutput StreamingCmd::execute(const VerifiedCmd& input)
+{
+   CollectingOutputSink out;
+   execute(input, out);
+   return out.releaseLines();
+}
+
+} // namespace ccon
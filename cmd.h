@@ -5,8 +5,17 @@
 // MIT license
 //
 #pragma once
+#include "output_sink.h"
+#include "symbol_table.h"
+#include "essentutils/color.h"
+#include <cstddef>
+#include <filesystem>
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <vector>
 
 
@@ -14,11 +23,28 @@ namespace ccon
 {
 ///////////////////
 
+// Value of a command argument converted to the type that its spec declares.
+// Text and enum values are held as strings.
+using ArgValue =
+   std::variant<std::string, int, double, sutil::Rgb, bool, std::filesystem::path>;
+
+// Spec index of arguments that were not matched against a spec of their command,
+// e.g. the common help argument.
+inline constexpr std::size_t NoArgSpecIdx = static_cast<std::size_t>(-1);
+
+
 // Command argument that was verified by the parser to be valid.
 struct VerifiedArg
 {
    std::string label;
    std::vector<std::string> values;
+   // Converted values for arguments whose spec declares a value type. Empty for
+   // arguments with text values.
+   std::vector<ArgValue> typedValues;
+   // Index of the matched spec within the argument specs of the command.
+   std::size_t specIdx = NoArgSpecIdx;
+   // Interned label. Allows comparing labels without comparing their text.
+   SymbolId labelId = NoSymbol;
 };
 
 using VerifiedArgs = std::vector<VerifiedArg>;
@@ -29,22 +55,136 @@ struct VerifiedCmd
 {
    std::string name;
    VerifiedArgs args;
+   // Interned name.
+   SymbolId nameId = NoSymbol;
 };
 
 
+// Non-owning variants of the verified argument and command types. Labels and names
+// refer to the text stored in the matched specs, values refer to the text of the
+// parsed command line. Both have to outlive the view objects.
+// The views can allocate their memory from a given memory resource, e.g. from an
+// arena for processing a single command line.
+struct VerifiedArgView
+{
+   using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+   VerifiedArgView() = default;
+   explicit VerifiedArgView(const allocator_type& alloc) : values{alloc}, typedValues{alloc}
+   {
+   }
+   VerifiedArgView(const VerifiedArgView& other, const allocator_type& alloc)
+   : label{other.label}, values{other.values, alloc},
+     typedValues{other.typedValues, alloc}, specIdx{other.specIdx}, labelId{other.labelId}
+   {
+   }
+   VerifiedArgView(VerifiedArgView&& other, const allocator_type& alloc)
+   : label{other.label}, values{std::move(other.values), alloc},
+     typedValues{std::move(other.typedValues), alloc}, specIdx{other.specIdx},
+     labelId{other.labelId}
+   {
+   }
+   ~VerifiedArgView() = default;
+   VerifiedArgView(const VerifiedArgView&) = default;
+   VerifiedArgView(VerifiedArgView&&) = default;
+   VerifiedArgView& operator=(const VerifiedArgView&) = default;
+   VerifiedArgView& operator=(VerifiedArgView&&) = default;
+
+   std::string_view label;
+   std::pmr::vector<std::string_view> values;
+   std::pmr::vector<ArgValue> typedValues;
+   std::size_t specIdx = NoArgSpecIdx;
+   SymbolId labelId = NoSymbol;
+};
+
+using VerifiedArgViews = std::pmr::vector<VerifiedArgView>;
+
+
+struct VerifiedCmdView
+{
+   using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+   VerifiedCmdView() = default;
+   explicit VerifiedCmdView(const allocator_type& alloc) : args{alloc} {}
+   ~VerifiedCmdView() = default;
+   VerifiedCmdView(const VerifiedCmdView&) = default;
+   VerifiedCmdView(VerifiedCmdView&&) = default;
+   VerifiedCmdView& operator=(const VerifiedCmdView&) = default;
+   VerifiedCmdView& operator=(VerifiedCmdView&&) = default;
+
+   std::string_view name;
+   VerifiedArgViews args;
+   SymbolId nameId = NoSymbol;
+};
+
+
+// Creates owning copies of verified views.
+inline VerifiedArg toVerifiedArg(const VerifiedArgView& view)
+{
+   VerifiedArg arg;
+   arg.label = view.label;
+   arg.values.reserve(view.values.size());
+   for (std::string_view value : view.values)
+      arg.values.emplace_back(value);
+   arg.typedValues.assign(view.typedValues.begin(), view.typedValues.end());
+   arg.specIdx = view.specIdx;
+   arg.labelId = view.labelId;
+   return arg;
+}
+
+inline VerifiedCmd toVerifiedCmd(const VerifiedCmdView& view)
+{
+   VerifiedCmd cmd;
+   cmd.name = view.name;
+   cmd.nameId = view.nameId;
+   cmd.args.reserve(view.args.size());
+   for (const VerifiedArgView& arg : view.args)
+      cmd.args.push_back(toVerifiedArg(arg));
+   return cmd;
+}
+
+
 ///////////////////
 
 // A command line split into words.
 using CmdArgs = std::vector<std::string>;
+// A command line split into words that refer to the text of the command line.
+using CmdArgViews = std::pmr::vector<std::string_view>;
 // The output lines of a command.
 using CmdOutput = std::vector<std::string>;
 
 
+// Threads that a command can execute on.
+enum class CmdThreadAffinity
+{
+   // Worker thread of the console. The console stays responsive while the command
+   // executes.
+   Any,
+   // Thread of the console's UI. Required for commands that access the UI.
+   UIThread
+};
+
+
 // Abstracts console commands.
+// Commands with small outputs return them as vector of lines. Commands that produce
+// large or slow output derive from StreamingCmd instead.
 struct Cmd
 {
    virtual ~Cmd() = default;
    virtual CmdOutput execute(const VerifiedCmd& input) = 0;
+   // Writes the returned lines to the sink.
+   virtual void execute(const VerifiedCmd& input, OutputSink& out);
+   virtual CmdThreadAffinity threadAffinity() const { return CmdThreadAffinity::Any; }
+};
+
+
+// Commands that write their output to the sink as they go. The console displays the
+// lines without buffering the entire output.
+struct StreamingCmd : public Cmd
+{
+   // Collects the lines written to the sink.
+   CmdOutput execute(const VerifiedCmd& input) override;
+   void execute(const VerifiedCmd& input, OutputSink& out) override = 0;
 };
 
 
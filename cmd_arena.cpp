@@ -0,0 +1,24 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "cmd_arena.h"
+
+
+namespace ccon
+{
+///////////////////
+
+CmdArena::CmdArena() : m_arena{m_buffer.data(), m_buffer.size(), &m_heapPool}
+{
+}
+
+
+void CmdArena::release()
+{
+   m_arena.release();
+}
+
+} // namespace ccon
@@ -0,0 +1,48 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+
+namespace ccon
+{
+///////////////////
+
+// Memory for the transient objects that are created while processing a command
+// line, e.g. the words of the line and the matched arguments. Allocations are not
+// freed individually but all at once when the arena is released.
+// Small command lines fit into the arena's inline buffer. Larger ones get more
+// memory from the heap which is kept until the arena is destroyed.
+class CmdArena
+{
+ public:
+   static constexpr std::size_t InlineSize = 4096;
+
+ public:
+   CmdArena();
+   ~CmdArena() = default;
+   CmdArena(const CmdArena&) = delete;
+   CmdArena(CmdArena&&) = delete;
+   CmdArena& operator=(const CmdArena&) = delete;
+   CmdArena& operator=(CmdArena&&) = delete;
+
+   std::pmr::memory_resource* resource() { return &m_arena; }
+   // Frees all allocations at once. Objects that were allocated from the arena must
+   // not be used anymore.
+   void release();
+
+ private:
+   alignas(std::max_align_t) std::array<std::byte, InlineSize> m_buffer;
+   // Monotonic buffer on top of a pool, so that the heap memory that large command
+   // lines need is reused for later ones instead of being returned to the heap.
+   std::pmr::unsynchronized_pool_resource m_heapPool;
+   std::pmr::monotonic_buffer_resource m_arena;
+};
+
+} // namespace ccon
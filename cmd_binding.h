@@ -0,0 +1,273 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd.h"
+#include "cmd_parser.h"
+#include "cmd_spec.h"
+#include "essentutils/color.h"
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+// Describes a parameter of a function that is bound as command.
+// Labels are required for optional and flag parameters and ignored for positional
+// parameters.
+struct BoundArg
+{
+   std::string label;
+   std::string abbrev;
+   std::string description;
+};
+
+
+// Spec and factory of a command that is bound to a function. Can be passed to
+// Console::addCommand.
+struct BoundCmd
+{
+   CmdSpec spec;
+   CmdFactoryFn factory;
+};
+
+
+// Binds a free function as command. The argument specs of the command are derived
+// from the function's parameter types:
+// - int, double, std::string, sutil::Rgb, std::filesystem::path
+//   Positional argument with one value of the type.
+// - std::optional<T> for any of the above types or bool
+//   Optional argument with one value of the type.
+// - bool
+//   Flag argument.
+// Positional parameters have to come before all others. The function can return a
+// CmdOutput, a std::string, or nothing.
+// Example:
+//    CmdOutput resize(int width, std::optional<int> height, bool keepRatio);
+//    console.addCommand(bindCommand<&resize>(
+//       "resize", "r", "resizes the thing",
+//       {{"", "", "width"}, {"height", "h", "height"}, {"keep", "k", "keep ratio"}}));
+template <auto Fn>
+BoundCmd bindCommand(const std::string& name, const std::string& abbrev,
+                     const std::string& description);
+template <auto Fn, std::size_t N>
+BoundCmd bindCommand(const std::string& name, const std::string& abbrev,
+                     const std::string& description, const BoundArg (&args)[N]);
+
+
+///////////////////
+
+namespace binding
+{
+
+template <typename T> struct IsOptional : std::false_type
+{
+};
+
+template <typename T> struct IsOptional<std::optional<T>> : std::true_type
+{
+};
+
+
+template <typename T> constexpr bool isBindableValueType()
+{
+   return std::is_same_v<T, std::string> || std::is_same_v<T, int> ||
+          std::is_same_v<T, double> || std::is_same_v<T, sutil::Rgb> ||
+          std::is_same_v<T, std::filesystem::path> || std::is_same_v<T, bool>;
+}
+
+// Value kind of the (unwrapped) type of a bound parameter.
+template <typename T> constexpr ValueKind valueKind()
+{
+   static_assert(isBindableValueType<T>(), "Parameter type cannot be bound.");
+
+   if constexpr (std::is_same_v<T, int>)
+      return ValueKind::Int;
+   else if constexpr (std::is_same_v<T, double>)
+      return ValueKind::Double;
+   else if constexpr (std::is_same_v<T, sutil::Rgb>)
+      return ValueKind::HexColor;
+   else if constexpr (std::is_same_v<T, bool>)
+      return ValueKind::Bool;
+   else if constexpr (std::is_same_v<T, std::filesystem::path>)
+      return ValueKind::Path;
+   else
+      return ValueKind::Text;
+}
+
+
+template <typename Param> constexpr bool isPositional()
+{
+   return !IsOptional<Param>::value && !std::is_same_v<Param, bool>;
+}
+
+template <typename... Params> constexpr bool havePositionalsFirst()
+{
+   constexpr bool positional[] = {isPositional<Params>()..., false};
+   bool haveNonPositional = false;
+   for (bool isPos : positional)
+   {
+      if (isPos && haveNonPositional)
+         return false;
+      haveNonPositional = haveNonPositional || !isPos;
+   }
+   return true;
+}
+
+
+template <typename Fn> struct FnTraits;
+
+template <typename Ret, typename... Args> struct FnTraits<Ret (*)(Args...)>
+{
+   using Result = Ret;
+   using Params = std::tuple<std::decay_t<Args>...>;
+   static constexpr std::size_t NumParams = sizeof...(Args);
+
+   static_assert(havePositionalsFirst<std::decay_t<Args>...>(),
+                 "Positional parameters have to come before optional and flag parameters.");
+};
+
+
+template <typename Param>
+ArgSpec makeArgSpec(const BoundArg& arg)
+{
+   if constexpr (std::is_same_v<Param, bool>)
+   {
+      return ArgSpec::makeFlagArg(arg.label, arg.abbrev, arg.description);
+   }
+   else if constexpr (IsOptional<Param>::value)
+   {
+      using Value = typename Param::value_type;
+      return ArgSpec::makeOptionalArg(arg.label, 1, arg.abbrev, arg.description,
+                                      valueKind<Value>());
+   }
+   else
+   {
+      return ArgSpec::makePositionalArg(1, arg.description, valueKind<Param>());
+   }
+}
+
+
+template <typename Params, std::size_t... Idx>
+std::vector<ArgSpec> makeArgSpecs(const BoundArg* args, std::index_sequence<Idx...>)
+{
+   return {makeArgSpec<std::tuple_element_t<Idx, Params>>(args[Idx])...};
+}
+
+
+// Stores the value of a verified argument in the parameter at a given index.
+template <typename Params, std::size_t Idx>
+void setParam(Params& params, const VerifiedArg& arg)
+{
+   using Param = std::tuple_element_t<Idx, Params>;
+
+   if constexpr (std::is_same_v<Param, bool>)
+      std::get<Idx>(params) = true;
+   else if constexpr (IsOptional<Param>::value)
+      std::get<Idx>(params) = argValue<typename Param::value_type>(arg);
+   else
+      std::get<Idx>(params) = argValue<Param>(arg).value_or(Param{});
+}
+
+template <typename Params> using ParamSetter = void (*)(Params&, const VerifiedArg&);
+
+template <typename Params, std::size_t... Idx>
+constexpr std::array<ParamSetter<Params>, sizeof...(Idx)>
+makeParamSetters(std::index_sequence<Idx...>)
+{
+   return {&setParam<Params, Idx>...};
+}
+
+
+template <typename Result> CmdOutput toCmdOutput(Result&& result)
+{
+   if constexpr (std::is_same_v<std::decay_t<Result>, CmdOutput>)
+      return std::forward<Result>(result);
+   else
+      return {std::string{std::forward<Result>(result)}};
+}
+
+
+// Command that calls a bound function with the values of the verified arguments.
+template <auto Fn> class BoundFnCmd : public Cmd
+{
+ public:
+   using Traits = FnTraits<decltype(Fn)>;
+   using Params = typename Traits::Params;
+
+   CmdOutput execute(const VerifiedCmd& input) override
+   {
+      // Arguments are dispatched by the index of their spec which matches the index
+      // of the parameter.
+      static constexpr auto setters = makeParamSetters<Params>(
+         std::make_index_sequence<Traits::NumParams>{});
+
+      Params params{};
+      for (const VerifiedArg& arg : input.args)
+      {
+         if (arg.specIdx < setters.size())
+            setters[arg.specIdx](params, arg);
+      }
+
+      if constexpr (std::is_void_v<typename Traits::Result>)
+      {
+         std::apply(Fn, std::move(params));
+         return {};
+      }
+      else
+      {
+         return toCmdOutput(std::apply(Fn, std::move(params)));
+      }
+   }
+};
+
+
+template <auto Fn>
+BoundCmd makeBoundCmd(const std::string& name, const std::string& abbrev,
+                      const std::string& description, const BoundArg* args)
+{
+   using Traits = FnTraits<decltype(Fn)>;
+   using Params = typename Traits::Params;
+
+   CmdSpec spec{name, abbrev, description,
+                makeArgSpecs<Params>(args, std::make_index_sequence<Traits::NumParams>{}),
+                ""};
+   return {std::move(spec), []() { return std::make_unique<BoundFnCmd<Fn>>(); }};
+}
+
+} // namespace binding
+
+
+template <auto Fn>
+BoundCmd bindCommand(const std::string& name, const std::string& abbrev,
+                     const std::string& description)
+{
+   static_assert(binding::FnTraits<decltype(Fn)>::NumParams == 0,
+                 "Describe the parameters of the bound function.");
+   return binding::makeBoundCmd<Fn>(name, abbrev, description, nullptr);
+}
+
+
+template <auto Fn, std::size_t N>
+BoundCmd bindCommand(const std::string& name, const std::string& abbrev,
+                     const std::string& description, const BoundArg (&args)[N])
+{
+   static_assert(binding::FnTraits<decltype(Fn)>::NumParams == N,
+                 "Describe each parameter of the bound function.");
+   return binding::makeBoundCmd<Fn>(name, abbrev, description, args);
+}
+
+} // namespace ccon
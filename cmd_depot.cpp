@@ -5,36 +5,324 @@
 // MIT license
 //
 #include "cmd_depot.h"
+#include "cancellation.h"
 #include "cmd_spec.h"
+#include "console_util.h"
+#include "interactive_cmd.h"
+#include "static_cmd_spec.h"
 #include "essentutils/string_util.h"
 #include <algorithm>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+// Instances of a command that are reused for multiple executions. Each execution
+// borrows an idle instance. The pool starts with one instance. Further instances
+// are created on demand until the pool is exhausted. After that, executions wait
+// for an instance to be returned.
+// Thread-safe.
+class CmdInstancePool
+{
+ public:
+   // The first instance determines the thread affinity of all instances.
+   CmdInstancePool(ccon::CmdFactoryFn factoryFn, std::size_t numInstances,
+                   std::unique_ptr<ccon::Cmd> firstInstance);
+   ~CmdInstancePool() = default;
+   CmdInstancePool(const CmdInstancePool&) = delete;
+   CmdInstancePool(CmdInstancePool&&) = delete;
+   CmdInstancePool& operator=(const CmdInstancePool&) = delete;
+   CmdInstancePool& operator=(CmdInstancePool&&) = delete;
+
+   // Returns null when the cancellation is requested while waiting for an instance.
+   // Throws if creating a new instance fails.
+   std::unique_ptr<ccon::Cmd> borrow(const ccon::CancellationToken& cancellation);
+   // Instances whose execution failed are discarded, so that a later execution does
+   // not see their state.
+   void giveBack(std::unique_ptr<ccon::Cmd> cmd, bool isIntact);
+   ccon::CmdThreadAffinity threadAffinity() const { return m_affinity; }
+
+ private:
+   std::unique_ptr<ccon::Cmd> createInstance();
+
+ private:
+   ccon::CmdFactoryFn m_factoryFn;
+   const std::size_t m_maxInstances = 1;
+   std::mutex m_mutex;
+   std::condition_variable m_instanceReturned;
+   std::vector<std::unique_ptr<ccon::Cmd>> m_idle;
+   // Instances that are idle or borrowed.
+   std::size_t m_numInstances = 0;
+   const ccon::CmdThreadAffinity m_affinity = ccon::CmdThreadAffinity::Any;
+};
+
+
+CmdInstancePool::CmdInstancePool(ccon::CmdFactoryFn factoryFn, std::size_t numInstances,
+                                 std::unique_ptr<ccon::Cmd> firstInstance)
+: m_factoryFn{std::move(factoryFn)},
+  m_maxInstances{std::max<std::size_t>(numInstances, 1)},
+  m_affinity{firstInstance->threadAffinity()}
+{
+   m_idle.push_back(std::move(firstInstance));
+   m_numInstances = 1;
+}
+
+
+std::unique_ptr<ccon::Cmd>
+CmdInstancePool::borrow(const ccon::CancellationToken& cancellation)
+{
+   {
+      std::unique_lock lock{m_mutex};
+      const bool isAvailable =
+         ccon::waitUnlessCancelled(m_instanceReturned, lock, cancellation, [this]() {
+            return !m_idle.empty() || m_numInstances < m_maxInstances;
+         });
+      if (!isAvailable)
+         return {};
+
+      if (!m_idle.empty())
+      {
+         std::unique_ptr<ccon::Cmd> cmd = std::move(m_idle.back());
+         m_idle.pop_back();
+         return cmd;
+      }
+      // Reserve the new instance, so that concurrent executions don't exceed the
+      // limit while it gets created outside of the lock.
+      ++m_numInstances;
+   }
+
+   return createInstance();
+}
+
+
+void CmdInstancePool::giveBack(std::unique_ptr<ccon::Cmd> cmd, bool isIntact)
+{
+   {
+      std::scoped_lock lock{m_mutex};
+      if (isIntact && cmd)
+         m_idle.push_back(std::move(cmd));
+      else
+         --m_numInstances;
+   }
+   m_instanceReturned.notify_one();
+}
+
+
+std::unique_ptr<ccon::Cmd> CmdInstancePool::createInstance()
+{
+   std::unique_ptr<ccon::Cmd> cmd;
+   try
+   {
+      cmd = m_factoryFn();
+   }
+   catch (...)
+   {
+      giveBack({}, false);
+      throw;
+   }
+   if (!cmd)
+   {
+      giveBack({}, false);
+      throw std::runtime_error{"Failed to instantiate command."};
+   }
+   return cmd;
+}
+
+
+///////////////////
+
+// Stands in for a reused command. Borrows an instance for each execution.
+class ReusedCmd : public ccon::StreamingCmd
+{
+ public:
+   explicit ReusedCmd(std::shared_ptr<CmdInstancePool> pool) : m_pool{std::move(pool)} {}
+   ~ReusedCmd() = default;
+   ReusedCmd(const ReusedCmd&) = delete;
+   ReusedCmd(ReusedCmd&&) = delete;
+   ReusedCmd& operator=(const ReusedCmd&) = delete;
+   ReusedCmd& operator=(ReusedCmd&&) = delete;
+
+   using ccon::StreamingCmd::execute;
+   void execute(const ccon::VerifiedCmd& input, ccon::OutputSink& out) override;
+   ccon::CmdThreadAffinity threadAffinity() const override
+   {
+      return m_pool->threadAffinity();
+   }
+
+ private:
+   std::shared_ptr<CmdInstancePool> m_pool;
+};
+
+
+void ReusedCmd::execute(const ccon::VerifiedCmd& input, ccon::OutputSink& out)
+{
+   std::unique_ptr<ccon::Cmd> cmd = m_pool->borrow(out.cancellation());
+   // Cancelled while waiting. The console reports the cancellation.
+   if (!cmd)
+      return;
+
+   try
+   {
+      cmd->execute(input, out);
+   }
+   catch (const ccon::CancelledError&)
+   {
+      // Commands are expected to be left intact when they get aborted at their
+      // output.
+      m_pool->giveBack(std::move(cmd), true);
+      throw;
+   }
+   catch (...)
+   {
+      m_pool->giveBack(std::move(cmd), false);
+      throw;
+   }
+   m_pool->giveBack(std::move(cmd), true);
+}
+
+} // namespace
 
 
 namespace ccon
 {
 ///////////////////
 
+CmdDepot::CmdDepot(const CmdDepot& other)
+: m_specs{other.m_specs}, m_cmdFactory{other.m_cmdFactory}
+{
+   // The index has to point to the copied specs. Map each entry instead of indexing
+   // the specs again, so that the precedence of conflicting abbreviations is kept.
+   m_index.reserve(other.m_index.size());
+   for (const auto& [id, spec] : other.m_index)
+      m_index.emplace(id, &*m_specs.find(*spec));
+}
+
+
+CmdDepot& CmdDepot::operator=(const CmdDepot& other)
+{
+   if (this != &other)
+      *this = CmdDepot{other};
+   return *this;
+}
+
+
 void CmdDepot::addCommand(const CmdSpec& spec, CmdFactoryFn factoryFn)
 {
-   const bool haveCommand = (m_specs.find(spec) != m_specs.end());
-   if (!haveCommand)
+   const auto [specPos, isInserted] = m_specs.insert(spec);
+   if (isInserted)
    {
-      m_specs.insert(spec);
-      m_cmdFactory[spec.name()] = factoryFn;
+      indexCommand(*specPos);
+      m_cmdFactory[spec.nameId()] = factoryFn;
    }
 }
 
 
+void CmdDepot::addCommand(const CmdSpec& spec, CmdFactoryFn factoryFn,
+                          CmdLifetime lifetime, std::size_t numInstances)
+{
+   if (lifetime == CmdLifetime::PerInvocation)
+   {
+      addCommand(spec, std::move(factoryFn));
+      return;
+   }
+
+   // Like for other commands, adding an existing command does nothing. Checked
+   // before an instance is created, which could throw.
+   if (m_specs.find(spec) != m_specs.end())
+      return;
+   if (lifetime == CmdLifetime::Pooled && numInstances == 0)
+      throw std::invalid_argument{"Pooled commands need at least one instance."};
+
+   // Probe an instance now instead of when the command executes. Finding out its
+   // thread affinity later could block the UI thread while all instances are
+   // borrowed.
+   std::unique_ptr<Cmd> firstInstance = factoryFn();
+   if (!firstInstance)
+      throw std::invalid_argument{"Failed to instantiate reused command."};
+   if (dynamic_cast<InteractiveCmd*>(firstInstance.get()))
+      throw std::invalid_argument{"Interactive commands cannot be reused."};
+
+   auto pool = std::make_shared<CmdInstancePool>(
+      std::move(factoryFn), lifetime == CmdLifetime::Singleton ? 1 : numInstances,
+      std::move(firstInstance));
+   addCommand(spec, [pool]() { return std::make_unique<ReusedCmd>(pool); });
+}
+
+
+void CmdDepot::addCommand(const StaticCmdSpec& spec, CmdFactoryFn factoryFn)
+{
+   addCommand(toCmdSpec(spec), factoryFn);
+}
+
+
+void CmdDepot::addCommand(const StaticCmdSpec& spec, CmdFactoryFn factoryFn,
+                          CmdLifetime lifetime, std::size_t numInstances)
+{
+   addCommand(toCmdSpec(spec), std::move(factoryFn), lifetime, numInstances);
+}
+
+
 const std::set<CmdSpec>& CmdDepot::availableCommands() const
 {
    return m_specs;
 }
 
 
+const CmdSpec* CmdDepot::findCommand(const std::string& cmdName) const
+{
+   return findCommand(findSymbolIgnoringCase(cmdName));
+}
+
+
+const CmdSpec* CmdDepot::findCommand(SymbolId cmdNameId) const
+{
+   const auto indexIter = m_index.find(cmdNameId);
+   if (indexIter != m_index.end())
+      return indexIter->second;
+   return nullptr;
+}
+
+
+CmdSpec::Match CmdDepot::matchCommand(const std::string& cmdLine) const
+{
+   // Split the command line only once and match it against the one spec that
+   // is indexed under the command name. Copies of the matched text are only
+   // made for the final result.
+   const CmdSpec::MatchView matched = matchCommand(splitCmdLine(cmdLine));
+   if (!matched.isMatching || !matched.areArgsValid)
+      return {matched.isMatching, matched.areArgsValid, {}};
+   return {true, true, toVerifiedCmd(matched.matchedCmd)};
+}
+
+
+CmdSpec::MatchView CmdDepot::matchCommand(const CmdArgViews& cmdPieces) const
+{
+   if (cmdPieces.empty())
+      return {};
+
+   const CmdSpec* spec = findCommand(findSymbolIgnoringCase(cmdPieces[0]));
+   if (!spec)
+      return {};
+   return spec->match(cmdPieces);
+}
+
+
 std::unique_ptr<Cmd> CmdDepot::makeCommand(const std::string& cmdName) const
 {
-   const auto factoryIter = m_cmdFactory.find(cmdName);
+   return makeCommand(findSymbol(cmdName));
+}
+
+
+std::unique_ptr<Cmd> CmdDepot::makeCommand(SymbolId cmdNameId) const
+{
+   const auto factoryIter = m_cmdFactory.find(cmdNameId);
    if (factoryIter != m_cmdFactory.end())
       return factoryIter->second();
    return {};
@@ -43,12 +331,21 @@ std::unique_ptr<Cmd> CmdDepot::makeCommand(const std::string& cmdName) const
 
 std::vector<std::string> CmdDepot::getCommandHelp(const std::string& cmdName) const
 {
-   const auto match =
-      find_if(begin(m_specs), end(m_specs),
-              [&cmdName](const CmdSpec& spec) { return spec.matchesName(cmdName); });
-   if (match != end(m_specs))
-      return sutil::split(match->help(), "\n");
+   const CmdSpec* spec = findCommand(cmdName);
+   if (spec)
+      return sutil::split(spec->help(), "\n");
    return {};
 }
 
+
+void CmdDepot::indexCommand(const CmdSpec& spec)
+{
+   // Names take precedence over abbreviations of other commands.
+   m_index[spec.nameId()] = &spec;
+
+   const SymbolId abbrevId = internSymbol(spec.abbreviation());
+   if (abbrevId != NoSymbol)
+      m_index.emplace(abbrevId, &spec);
+}
+
 } // namespace ccon
@@ -6,15 +6,19 @@
 //
 #pragma once
 #include "cmd.h"
+#include "cmd_spec.h"
+#include "symbol_table.h"
+#include <cstddef>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace ccon
 {
-class CmdSpec;
 struct ConsoleUI;
+struct StaticCmdSpec;
 } // namespace ccon
 
 
@@ -22,24 +26,75 @@ namespace ccon
 {
 ///////////////////
 
+// How the depot instantiates a command for its executions.
+enum class CmdLifetime
+{
+   // Each execution gets a new instance.
+   PerInvocation,
+   // All executions share one instance. They execute one after the other.
+   Singleton,
+   // Executions borrow one of a limited number of instances. As many executions as
+   // there are instances can execute concurrently.
+   Pooled
+};
+
+
 // Respository of console commands.
 class CmdDepot
 {
  public:
+   CmdDepot() = default;
+   ~CmdDepot() = default;
+   // Copies share the data of the specs, the factory functions and the reused
+   // command instances with the original.
+   CmdDepot(const CmdDepot& other);
+   CmdDepot(CmdDepot&&) = default;
+   CmdDepot& operator=(const CmdDepot& other);
+   CmdDepot& operator=(CmdDepot&&) = default;
+
    void addCommand(const CmdSpec& spec, CmdFactoryFn factoryFn);
+   // Adds a command whose instances are reused for multiple executions. The first
+   // instance is created right away, further instances on demand. They are kept
+   // until the depot and all its copies are destroyed. The number of instances is
+   // only used for pooled commands.
+   // Throws std::invalid_argument for interactive commands, which keep the state of
+   // an execution between their steps and cannot be reused, when no instance can be
+   // created, and for pools without instances.
+   void addCommand(const CmdSpec& spec, CmdFactoryFn factoryFn, CmdLifetime lifetime,
+                   std::size_t numInstances = 1);
+   // Adds a command declared as static data. The spec's data is shared with all
+   // other depots that add the same static spec.
+   void addCommand(const StaticCmdSpec& spec, CmdFactoryFn factoryFn);
+   void addCommand(const StaticCmdSpec& spec, CmdFactoryFn factoryFn,
+                   CmdLifetime lifetime, std::size_t numInstances = 1);
    // Returns a collection of all available console command specs.
    const std::set<CmdSpec>& availableCommands() const;
-   // Instantiates a command with a given name.
+   // Looks up the spec of a command by its name or abbreviation.
+   // Returns null if no command matches.
+   const CmdSpec* findCommand(const std::string& cmdName) const;
+   const CmdSpec* findCommand(SymbolId cmdNameId) const;
+   // Matches a given command line against the available command specs.
+   CmdSpec::Match matchCommand(const std::string& cmdLine) const;
+   // Non-allocating version for a command line that was already split into words.
+   // The matched command refers to the words' text and to the depot's specs.
+   CmdSpec::MatchView matchCommand(const CmdArgViews& cmdPieces) const;
+   // Instantiates a command with a given name. Commands with reused instances are
+   // returned as placeholders that borrow an instance for the time of an execution.
    std::unique_ptr<Cmd> makeCommand(const std::string& cmdName) const;
+   std::unique_ptr<Cmd> makeCommand(SymbolId cmdNameId) const;
    // Returns the help description for a given command.
    std::vector<std::string> getCommandHelp(const std::string& cmdName) const;
 
  private:
-   using CmdName = std::string;
+   void indexCommand(const CmdSpec& spec);
 
  private:
    std::set<CmdSpec> m_specs;
-   std::unordered_map<CmdName, CmdFactoryFn> m_cmdFactory;
+   // Lookup of specs by their interned names and abbreviations. Points to the
+   // elements of m_specs which are stable because std::set never relocates its
+   // nodes.
+   std::unordered_map<SymbolId, const CmdSpec*> m_index;
+   std::unordered_map<SymbolId, CmdFactoryFn> m_cmdFactory;
 };
 
 } // namespace ccon
@@ -8,62 +8,129 @@
 #include "cmd_spec.h"
 #include "console_util.h"
 #include "essentutils/color.h"
-#include "essentutils/string_util.h"
 #include <algorithm>
+#include <array>
 #include <cassert>
-#include <map>
+#include <charconv>
+#include <filesystem>
 #include <optional>
+#include <utility>
 
 
 namespace
 {
 ///////////////////
 
-unsigned int intFromHexDigit(char hexChar)
+constexpr int InvalidHexDigit = -1;
+
+constexpr std::array<int, 256> makeHexDigitTable()
 {
-   static std::map<char, int> hexValue = {
-      {'0', 0},  {'1', 1},  {'2', 2},  {'3', 3},  {'4', 4},  {'5', 5},
-      {'6', 6},  {'7', 7},  {'8', 8},  {'9', 9},  {'a', 10}, {'A', 10},
-      {'b', 11}, {'B', 11}, {'c', 12}, {'C', 12}, {'d', 13}, {'D', 13},
-      {'e', 14}, {'E', 14}, {'f', 15}, {'F', 15},
-   };
+   std::array<int, 256> table{};
+   for (int& val : table)
+      val = InvalidHexDigit;
+   for (int i = 0; i < 10; ++i)
+      table['0' + i] = i;
+   for (int i = 0; i < 6; ++i)
+   {
+      table['a' + i] = 10 + i;
+      table['A' + i] = 10 + i;
+   }
+   return table;
+}
+
+constexpr std::array<int, 256> HexDigitTable = makeHexDigitTable();
 
-   auto match = hexValue.find(hexChar);
-   if (match != hexValue.end())
-      return match->second;
-   return static_cast<unsigned int>(-1);
+
+int intFromHexDigit(char hexChar)
+{
+   return HexDigitTable[static_cast<unsigned char>(hexChar)];
 }
 
 
-unsigned int intFromHexDoubleDigit(const std::string& hex)
+int intFromHexDoubleDigit(std::string_view hex)
 {
    if (hex.size() != 2)
-      return static_cast<unsigned int>(-1);
+      return InvalidHexDigit;
 
    const int high = intFromHexDigit(hex[0]);
    const int low = intFromHexDigit(hex[1]);
-   if (high == -1 || low == -1)
-      return static_cast<unsigned int>(-1);
+   if (high == InvalidHexDigit || low == InvalidHexDigit)
+      return InvalidHexDigit;
 
    return 16 * high + low;
 }
 
 
-std::optional<sutil::Rgb> colorFromString(const std::string& colorAsStr)
+std::optional<sutil::Rgb> colorFromString(std::string_view colorAsStr)
 {
    if (colorAsStr.size() != 6)
       return std::nullopt;
 
-   const unsigned int r = intFromHexDoubleDigit(colorAsStr.substr(0, 2));
-   const unsigned int g = intFromHexDoubleDigit(colorAsStr.substr(2, 2));
-   const unsigned int b = intFromHexDoubleDigit(colorAsStr.substr(4, 2));
-   if (r == -1 || g == -1 || b == -1)
+   const int r = intFromHexDoubleDigit(colorAsStr.substr(0, 2));
+   const int g = intFromHexDoubleDigit(colorAsStr.substr(2, 2));
+   const int b = intFromHexDoubleDigit(colorAsStr.substr(4, 2));
+   if (r == InvalidHexDigit || g == InvalidHexDigit || b == InvalidHexDigit)
       return std::nullopt;
 
    return sutil::Rgb{static_cast<uint8_t>(r), static_cast<uint8_t>(g),
                      static_cast<uint8_t>(b)};
 }
 
+
+template <typename Num> std::optional<Num> numberFromString(std::string_view numAsStr)
+{
+   const char* first = numAsStr.data();
+   const char* last = numAsStr.data() + numAsStr.size();
+   // Allow explicit plus signs which std::from_chars does not accept.
+   if (first != last && *first == '+')
+      ++first;
+
+   Num num{};
+   const auto [end, err] = std::from_chars(first, last, num);
+   // The entire text has to be a number.
+   if (err != std::errc{} || end != last || first == last)
+      return std::nullopt;
+   return num;
+}
+
+
+std::optional<bool> boolFromString(std::string_view boolAsStr)
+{
+   static constexpr std::array<std::pair<std::string_view, bool>, 8> boolNames = {{
+      {"true", true},
+      {"false", false},
+      {"yes", true},
+      {"no", false},
+      {"on", true},
+      {"off", false},
+      {"1", true},
+      {"0", false},
+   }};
+
+   for (const auto& [name, value] : boolNames)
+      if (ccon::equalsLowercase(boolAsStr, name))
+         return value;
+   return std::nullopt;
+}
+
+
+std::optional<std::string> enumFromString(std::string_view enumAsStr,
+                                          const std::vector<std::string>& members)
+{
+   for (const std::string& member : members)
+      if (ccon::equalsLowercase(enumAsStr, member))
+         return member;
+   return std::nullopt;
+}
+
+
+template <typename T> std::optional<ccon::ArgValue> toArgValue(std::optional<T> val)
+{
+   if (val.has_value())
+      return ccon::ArgValue{std::move(val.value())};
+   return std::nullopt;
+}
+
 } // namespace
 
 
@@ -74,7 +141,16 @@ namespace ccon
 bool containsHelpParameter(const CmdArgs& args)
 {
    return any_of(begin(args), end(args), [](const std::string& arg) {
-      return HelpArgSpec.matchLabel(stripArgSeparators(arg));
+      return HelpArgSpec.matchLabel(stripArgSeparatorsView(arg));
+   });
+}
+
+
+bool containsHelpParameter(CmdArgViews::const_iterator argsBegin,
+                           CmdArgViews::const_iterator argsEnd)
+{
+   return any_of(argsBegin, argsEnd, [](std::string_view arg) {
+      return HelpArgSpec.matchLabel(stripArgSeparatorsView(arg));
    });
 }
 
@@ -82,47 +158,109 @@ bool containsHelpParameter(const CmdArgs& args)
 bool containsHelpParameter(const VerifiedArgs& args)
 {
    return any_of(begin(args), end(args), [](const VerifiedArg& arg) {
-      return HelpArgSpec.matchLabel(stripArgSeparators(arg.label));
+      return HelpArgSpec.matchLabel(stripArgSeparatorsView(arg.label));
    });
 }
 
 
 bool haveArgWithLabel(VerifiedArgs::const_iterator beginOptions,
-                      VerifiedArgs::const_iterator endOptions, const std::string& label)
+                      VerifiedArgs::const_iterator endOptions, std::string_view label)
 {
    return findArgWithLabel(beginOptions, endOptions, label) != endOptions;
 }
 
 
+bool haveArgWithLabel(VerifiedArgs::const_iterator beginOptions,
+                      VerifiedArgs::const_iterator endOptions, SymbolId labelId)
+{
+   return findArgWithLabel(beginOptions, endOptions, labelId) != endOptions;
+}
+
+
 VerifiedArgs::const_iterator findArgWithLabel(VerifiedArgs::const_iterator beginOptions,
                                               VerifiedArgs::const_iterator endOptions,
-                                              const std::string& label)
+                                              std::string_view label)
 {
-   return find_if(beginOptions, endOptions, [&label](const auto& arg) {
-      return stripArgSeparators(arg.label) == stripArgSeparators(label);
+   const std::string_view strippedLabel = stripArgSeparatorsView(label);
+   const SymbolId labelId = findSymbol(strippedLabel);
+
+   return find_if(beginOptions, endOptions, [strippedLabel, labelId](const auto& arg) {
+      if (arg.labelId != NoSymbol)
+         return arg.labelId == labelId;
+      // Fall back to comparing the text for args that were not verified against a
+      // spec.
+      return stripArgSeparatorsView(arg.label) == strippedLabel;
    });
 }
 
 
+VerifiedArgs::const_iterator findArgWithLabel(VerifiedArgs::const_iterator beginOptions,
+                                              VerifiedArgs::const_iterator endOptions,
+                                              SymbolId labelId)
+{
+   if (labelId == NoSymbol)
+      return endOptions;
+   return find_if(beginOptions, endOptions,
+                  [labelId](const auto& arg) { return arg.labelId == labelId; });
+}
+
+
+std::optional<ArgValue> parseArgValue(std::string_view text, const ValueType& type)
+{
+   switch (type.kind())
+   {
+   case ValueKind::Text:
+      return ArgValue{std::string{text}};
+   case ValueKind::Int:
+      return toArgValue(numberFromString<int>(text));
+   case ValueKind::Double:
+      return toArgValue(numberFromString<double>(text));
+   case ValueKind::HexColor:
+      return toArgValue(colorFromString(text));
+   case ValueKind::Enum:
+      return toArgValue(enumFromString(text, type.enumMembers()));
+   case ValueKind::Bool:
+      return toArgValue(boolFromString(text));
+   case ValueKind::Path:
+      if (text.empty())
+         return std::nullopt;
+      return ArgValue{std::filesystem::path{text}};
+   }
+   return std::nullopt;
+}
+
+
 int parseIntArg(VerifiedArgs::const_iterator beginOptions,
-                VerifiedArgs::const_iterator endOptions, const std::string& argLabel,
+                VerifiedArgs::const_iterator endOptions, std::string_view argLabel,
                 int defaultValue)
 {
    auto argIter = findArgWithLabel(beginOptions, endOptions, argLabel);
-   if (argIter != endOptions)
-      return sutil::intFromStr(argIter->values[0], defaultValue);
-   return defaultValue;
+   if (argIter == endOptions)
+      return defaultValue;
+
+   // Use the value that was converted during verification, if available.
+   if (const std::optional<int> typedValue = argValue<int>(*argIter);
+       typedValue.has_value())
+      return typedValue.value();
+   if (argIter->values.empty())
+      return defaultValue;
+   return numberFromString<int>(argIter->values[0]).value_or(defaultValue);
 }
 
 
 sutil::Rgb parseColorArg(VerifiedArgs::const_iterator beginOptions,
                          VerifiedArgs::const_iterator endOptions,
-                         const std::string& argLabel, const sutil::Rgb& defaultColor)
+                         std::string_view argLabel, const sutil::Rgb& defaultColor)
 {
    auto colorIter = findArgWithLabel(beginOptions, endOptions, argLabel);
    if (colorIter == endOptions)
       return defaultColor;
 
+   // Use the value that was converted during verification, if available.
+   if (const std::optional<sutil::Rgb> typedColor = argValue<sutil::Rgb>(*colorIter);
+       typedColor.has_value())
+      return typedColor.value();
+
    assert(colorIter->values.size() == 1);
    const std::optional<sutil::Rgb> color = colorFromString(colorIter->values[0]);
    return color.has_value() ? color.value() : defaultColor;
@@ -6,7 +6,16 @@
 //
 #pragma once
 #include "cmd.h"
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <variant>
 
+namespace ccon
+{
+class ValueType;
+}
 namespace sutil
 {
 struct Rgb;
@@ -19,25 +28,64 @@ namespace ccon
 
 // Check, if given arguments contain the 'help' parameter.
 bool containsHelpParameter(const CmdArgs& args);
+bool containsHelpParameter(CmdArgViews::const_iterator argsBegin,
+                           CmdArgViews::const_iterator argsEnd);
 bool containsHelpParameter(const VerifiedArgs& args);
 
 // Checks if a given argument sequence contains an argument with a given label.
 bool haveArgWithLabel(VerifiedArgs::const_iterator beginOptions,
-                      VerifiedArgs::const_iterator endOptions, const std::string& label);
+                      VerifiedArgs::const_iterator endOptions, std::string_view label);
+bool haveArgWithLabel(VerifiedArgs::const_iterator beginOptions,
+                      VerifiedArgs::const_iterator endOptions, SymbolId labelId);
 
 // Finds in a given argument sequence an argument with a given label.
 // Returns the found arg's iterator.
 VerifiedArgs::const_iterator findArgWithLabel(VerifiedArgs::const_iterator beginOptions,
                                               VerifiedArgs::const_iterator endOptions,
-                                              const std::string& label);
+                                              std::string_view label);
+// Version for interned labels. Only finds arguments that were verified against a
+// spec.
+VerifiedArgs::const_iterator findArgWithLabel(VerifiedArgs::const_iterator beginOptions,
+                                              VerifiedArgs::const_iterator endOptions,
+                                              SymbolId labelId);
+
+// Converts the text of an argument value to a given type. Returns nothing if the
+// text is not a valid value of the type.
+std::optional<ArgValue> parseArgValue(std::string_view text, const ValueType& type);
+
+// Returns the value at a given index of a verified argument as a given type.
+// Uses the value that was converted during verification if available.
+template <typename T>
+std::optional<T> argValue(const VerifiedArg& arg, std::size_t valueIdx = 0);
 
 // Parses a given argument sequence for an integer argument with a given label.
 int parseIntArg(VerifiedArgs::const_iterator beginOptions,
-                VerifiedArgs::const_iterator endOptions, const std::string& argLabel,
+                VerifiedArgs::const_iterator endOptions, std::string_view argLabel,
                 int defaultValue);
 // Parses a given argument sequence for a color argument with a given label.
 sutil::Rgb parseColorArg(VerifiedArgs::const_iterator beginOptions,
                          VerifiedArgs::const_iterator endOptions,
-                         const std::string& argLabel, const sutil::Rgb& defaultColor);
+                         std::string_view argLabel, const sutil::Rgb& defaultColor);
+
+
+
+///////////////////
+
+template <typename T> std::optional<T> argValue(const VerifiedArg& arg, std::size_t valueIdx)
+{
+   if (valueIdx < arg.typedValues.size())
+   {
+      if (const T* typedValue = std::get_if<T>(&arg.typedValues[valueIdx]))
+         return *typedValue;
+      return std::nullopt;
+   }
+
+   if constexpr (std::is_same_v<T, std::string>)
+   {
+      if (valueIdx < arg.values.size())
+         return arg.values[valueIdx];
+   }
+   return std::nullopt;
+}
 
 } // namespace ccon
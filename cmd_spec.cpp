@@ -11,99 +11,179 @@
 #include "essentutils/string_util.h"
 #include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
 
 
 namespace
 {
 ///////////////////
 
-// Checks if a passed string is an argument label.
-bool isArgLabel(const std::string& val)
+// Checks if a command line word is a negative number, i.e. a dash followed by a digit
+// or a decimal point.
+bool isNegativeNumber(std::string_view word)
 {
-   if (val.empty())
-      return false;
-
-   auto charIter = std::begin(val);
-   auto charEnd = std::end(val);
-   while (charIter != charEnd && *charIter == ' ')
-      ++charIter;
+   return word.size() >= 2 && word[0] == '-' &&
+          (std::isdigit(static_cast<unsigned char>(word[1])) || word[1] == '.');
+}
 
-   std::size_t numDashes = 0;
-   while (charIter != charEnd && *charIter == '-')
-   {
-      ++numDashes;
-      ++charIter;
-   }
 
-   return numDashes == 1 || numDashes == 2;
+// Looks up the interned label of a given command line word. Returns NoSymbol if the
+// word is not a label or if no command uses the label.
+ccon::SymbolId findLabelSymbol(std::string_view word)
+{
+   if (!ccon::isArgLabel(word))
+      return ccon::NoSymbol;
+   return ccon::findSymbolIgnoringCase(ccon::stripArgSeparatorsView(word));
 }
 
 
-std::optional<ccon::VerifiedArg> matchArgSpec(const ccon::ArgSpec& spec,
-                                              ccon::CmdArgs::const_iterator& actualArgs,
-                                              ccon::CmdArgs::const_iterator actualArgsEnd)
+bool matchArgSpec(ccon::CmdSpec::ArgSpecIter_t spec, ccon::CmdSpec::ArgSpecIter_t specsBegin,
+                  ccon::CmdArgViews::const_iterator& actualArgs,
+                  ccon::CmdArgViews::const_iterator actualArgsEnd,
+                  ccon::SymbolId actualLabelId, ccon::VerifiedArgViews& verifiedArgs)
 {
-   ccon::CmdArgs::const_iterator iterCopy = actualArgs;
-   const std::optional<ccon::VerifiedArg> match = spec.match(iterCopy, actualArgsEnd);
+   // The spec only advances the iterator over the actual arguments if it finds a
+   // match.
+   std::optional<ccon::VerifiedArgView> match = spec->match(
+      actualArgs, actualArgsEnd, actualLabelId, verifiedArgs.get_allocator().resource());
    if (!match.has_value())
-      return std::nullopt;
+      return false;
 
-   // Only advance the iterator over the actual arguments if we found a match.
-   actualArgs = iterCopy;
-   return match;
+   match->specIdx = static_cast<std::size_t>(std::distance(specsBegin, spec));
+   verifiedArgs.push_back(std::move(match.value()));
+   return true;
 }
 
 
-std::optional<ccon::VerifiedArgs> matchPositionalCmdArgs(
-   ccon::CmdSpec::ArgSpecIter_t posSpec, ccon::CmdSpec::ArgSpecIter_t posSpecEnd,
-   ccon::CmdArgs::const_iterator& actualArgs, ccon::CmdArgs::const_iterator actualArgsEnd)
+// Matches an argument that is not part of the command's specs, e.g. the common
+// timeout argument.
+bool matchCommonArgSpec(const ccon::ArgSpec& spec,
+                        ccon::CmdArgViews::const_iterator& actualArgs,
+                        ccon::CmdArgViews::const_iterator actualArgsEnd,
+                        ccon::SymbolId actualLabelId,
+                        ccon::VerifiedArgViews& verifiedArgs)
 {
-   ccon::VerifiedArgs verifiedArgs;
+   std::optional<ccon::VerifiedArgView> match =
+      spec.match(actualArgs, actualArgsEnd, actualLabelId,
+                 verifiedArgs.get_allocator().resource());
+   if (!match.has_value())
+      return false;
 
+   verifiedArgs.push_back(std::move(match.value()));
+   return true;
+}
+
+
+bool matchPositionalCmdArgs(ccon::CmdSpec::ArgSpecIter_t specsBegin,
+                            ccon::CmdSpec::ArgSpecIter_t posSpec,
+                            ccon::CmdSpec::ArgSpecIter_t posSpecEnd,
+                            ccon::CmdArgViews::const_iterator& actualArgs,
+                            ccon::CmdArgViews::const_iterator actualArgsEnd,
+                            ccon::VerifiedArgViews& verifiedArgs)
+{
    for (; posSpec != posSpecEnd; ++posSpec)
    {
-      const std::optional<ccon::VerifiedArg> matchedArg =
-         matchArgSpec(*posSpec, actualArgs, actualArgsEnd);
-      if (!matchedArg.has_value())
-         return std::nullopt;
-
-      verifiedArgs.push_back(matchedArg.value());
+      if (!matchArgSpec(posSpec, specsBegin, actualArgs, actualArgsEnd, ccon::NoSymbol,
+                        verifiedArgs))
+         return false;
    }
 
-   return verifiedArgs;
+   return true;
 }
 
 
-std::optional<ccon::VerifiedArgs> matchOptionalCmdArgs(
-   ccon::CmdSpec::ArgSpecIter_t optSpecBegin, ccon::CmdSpec::ArgSpecIter_t optSpecEnd,
-   ccon::CmdArgs::const_iterator& actualArgs, ccon::CmdArgs::const_iterator actualArgsEnd)
+bool matchOptionalCmdArgs(const ccon::CmdSpec& cmdSpec,
+                          ccon::CmdArgViews::const_iterator& actualArgs,
+                          ccon::CmdArgViews::const_iterator actualArgsEnd,
+                          ccon::VerifiedArgViews& verifiedArgs)
 {
-   ccon::VerifiedArgs verifiedArgs;
-
    while (actualArgs != actualArgsEnd)
    {
-      bool haveMatch = false;
+      // Each label resolves to at most one spec.
+      const ccon::SymbolId labelId = findLabelSymbol(*actualArgs);
+      const ccon::CmdSpec::ArgSpecIter_t optSpec = cmdSpec.findOptionalArgSpec(labelId);
 
-      for (ccon::CmdSpec::ArgSpecIter_t optSpec = optSpecBegin; optSpec != optSpecEnd;
-           ++optSpec)
+      if (optSpec == cmdSpec.end())
       {
-         const std::optional<ccon::VerifiedArg> matchedArg =
-            matchArgSpec(*optSpec, actualArgs, actualArgsEnd);
-         if (matchedArg.has_value())
+         // Common arguments apply to commands without own arguments of the label.
+         if (ccon::TimeoutArgSpec.matchLabel(labelId))
          {
-            verifiedArgs.push_back(matchedArg.value());
-            haveMatch = true;
-            break;
+            if (!matchCommonArgSpec(ccon::TimeoutArgSpec, actualArgs, actualArgsEnd,
+                                    labelId, verifiedArgs))
+               return false;
+            continue;
          }
+
+         // There is an actual arg that does not match any optional arg spec. Fail
+         // the parsing.
+         return false;
       }
+      if (!matchArgSpec(optSpec, cmdSpec.begin(), actualArgs, actualArgsEnd,
+                        optSpec->labelId(), verifiedArgs))
+         return false;
+   }
 
-      // There is an actual arg that does not match any optional arg spec. Fail the
-      // parsing.
-      if (!haveMatch)
-         return std::nullopt;
+   return true;
+}
+
+
+using OptionIndex = std::vector<std::pair<ccon::SymbolId, std::size_t>>;
+
+// Builds the lookup of optional argument specs by their labels and abbreviations.
+// Throws for specs that cannot be told apart when matching.
+OptionIndex makeOptionIndex(const std::string& cmdName,
+                            const std::vector<ccon::ArgSpec>& argSpecs)
+{
+   OptionIndex index;
+
+   auto addLabel = [&index, &cmdName](ccon::SymbolId labelId, std::size_t specIdx) {
+      if (labelId == ccon::NoSymbol)
+         return;
+      if (ccon::HelpArgSpec.matchLabel(labelId))
+      {
+         throw std::invalid_argument("Argument '" +
+                                     std::string{ccon::symbolName(labelId)} +
+                                     "' of command '" + cmdName +
+                                     "' is shadowed by the help argument.");
+      }
+      index.emplace_back(labelId, specIdx);
+   };
+
+   bool haveOptionalArgs = false;
+   for (std::size_t specIdx = 0; specIdx < argSpecs.size(); ++specIdx)
+   {
+      const ccon::ArgSpec& spec = argSpecs[specIdx];
+      if (spec.isRequired())
+      {
+         if (haveOptionalArgs)
+         {
+            throw std::invalid_argument("Positional arguments of command '" + cmdName +
+                                        "' have to come before its optional arguments.");
+         }
+         continue;
+      }
+
+      haveOptionalArgs = true;
+      addLabel(spec.labelId(), specIdx);
+      addLabel(spec.abbreviationId(), specIdx);
    }
 
-   return verifiedArgs;
+   std::sort(index.begin(), index.end());
+   const auto duplicate =
+      std::adjacent_find(index.begin(), index.end(), [](const auto& a, const auto& b) {
+         return a.first == b.first;
+      });
+   if (duplicate != index.end())
+   {
+      throw std::invalid_argument("Argument label '" +
+                                  std::string{ccon::symbolName(duplicate->first)} +
+                                  "' of command '" + cmdName + "' is ambiguous.");
+   }
+
+   return index;
 }
 
 } // namespace
@@ -119,6 +199,9 @@ LabelWithAbbrev::LabelWithAbbrev(const std::string& label, const std::string& ab
    const bool haveOnlyAbbrev = (m_label.empty() && !m_abbrev.empty());
    if (haveOnlyAbbrev)
       std::swap(m_label, m_abbrev);
+
+   m_labelId = ccon::internSymbol(m_label);
+   m_abbrevId = ccon::internSymbol(m_abbrev);
 }
 
 
@@ -128,7 +211,7 @@ LabelWithAbbrev::operator bool() const
 }
 
 
-bool LabelWithAbbrev::matches(const std::string& match) const
+bool LabelWithAbbrev::matches(std::string_view match) const
 {
    if (match.empty())
       return m_label.empty();
@@ -136,7 +219,24 @@ bool LabelWithAbbrev::matches(const std::string& match) const
 }
 
 
-std::string LabelWithAbbrev::label() const
+bool LabelWithAbbrev::matchesIgnoringCase(std::string_view match) const
+{
+   if (match.empty())
+      return m_label.empty();
+   return (equalsLowercase(match, m_label) ||
+           (!m_abbrev.empty() && equalsLowercase(match, m_abbrev)));
+}
+
+
+bool LabelWithAbbrev::matches(SymbolId match) const
+{
+   if (match == NoSymbol)
+      return false;
+   return (match == m_labelId || match == m_abbrevId);
+}
+
+
+const std::string& LabelWithAbbrev::label() const
 {
    return m_label;
 }
@@ -148,7 +248,7 @@ bool LabelWithAbbrev::haveAbbreviation() const
 }
 
 
-std::string LabelWithAbbrev::abbreviation() const
+const std::string& LabelWithAbbrev::abbreviation() const
 {
    return m_abbrev;
 }
@@ -156,31 +256,74 @@ std::string LabelWithAbbrev::abbreviation() const
 
 ///////////////////
 
-ArgSpec ArgSpec::makePositionalArg(std::size_t numValues, const std::string& description)
+ValueType ValueType::makeEnum(const std::vector<std::string>& members)
+{
+   ValueType type{ValueKind::Enum};
+   type.m_enumMembers.reserve(members.size());
+   for (const std::string& member : members)
+      type.m_enumMembers.push_back(sutil::lowercase(member));
+   return type;
+}
+
+
+ValueType::ValueType(ValueKind kind) : m_kind{kind}
 {
-   return ArgSpec("", "", numValues, description);
+}
+
+
+std::string ValueType::help() const
+{
+   switch (m_kind)
+   {
+   case ValueKind::Text:
+      return "text";
+   case ValueKind::Int:
+      return "integer";
+   case ValueKind::Double:
+      return "number";
+   case ValueKind::HexColor:
+      return "rrggbb";
+   case ValueKind::Enum:
+      return "one of: " + sutil::join(m_enumMembers.begin(), m_enumMembers.end(), ", ");
+   case ValueKind::Bool:
+      return "true/false";
+   case ValueKind::Path:
+      return "path";
+   }
+   return "";
+}
+
+
+///////////////////
+
+ArgSpec ArgSpec::makePositionalArg(std::size_t numValues, const std::string& description,
+                                   const ValueType& valueType)
+{
+   return ArgSpec("", "", numValues, description, valueType);
 }
 
 
 ArgSpec ArgSpec::makeOptionalArg(const std::string& label, std::size_t numValues,
                                  const std::string& abbrev,
-                                 const std::string& description)
+                                 const std::string& description,
+                                 const ValueType& valueType)
 {
-   return ArgSpec(label, abbrev, numValues, description);
+   return ArgSpec(label, abbrev, numValues, description, valueType);
 }
 
 
 ArgSpec ArgSpec::makeFlagArg(const std::string& label, const std::string& abbrev,
                              const std::string& description)
 {
-   return ArgSpec(label, abbrev, 0, description);
+   return ArgSpec(label, abbrev, 0, description, {});
 }
 
 
 ArgSpec::ArgSpec(const std::string& label, const std::string& abbrev,
-                 std::size_t numValues, const std::string& description)
+                 std::size_t numValues, const std::string& description,
+                 const ValueType& valueType)
 : m_label{sutil::lowercase(label), sutil::lowercase(abbrev)}, m_numValues{numValues},
-  m_description{description}
+  m_description{description}, m_valueType{valueType}
 {
 }
 
@@ -203,12 +346,18 @@ bool ArgSpec::hasLabel() const
 }
 
 
-std::string ArgSpec::label() const
+const std::string& ArgSpec::label() const
 {
    return m_label.label();
 }
 
 
+const std::string& ArgSpec::abbreviation() const
+{
+   return m_label.abbreviation();
+}
+
+
 std::string ArgSpec::help(const std::string& indent) const
 {
    // Ignore empty spec.
@@ -243,6 +392,8 @@ std::string ArgSpec::help(const std::string& indent) const
       else
          help += std::to_string(m_numValues);
       help += (m_numValues == 1) ? " value" : " values";
+      if (!m_valueType.isText())
+         help += " (" + m_valueType.help() + ")";
    }
 
    if (!m_description.empty())
@@ -255,71 +406,117 @@ std::string ArgSpec::help(const std::string& indent) const
 }
 
 
-bool ArgSpec::matchLabel(const std::string& match) const
+bool ArgSpec::matchLabel(std::string_view match) const
 {
-   return m_label.matches(sutil::lowercase(match));
+   return m_label.matchesIgnoringCase(match);
+}
+
+
+bool ArgSpec::matchLabel(SymbolId matchId) const
+{
+   return m_label.matches(matchId);
 }
 
 
 std::optional<VerifiedArg> ArgSpec::match(CmdArgs::const_iterator& actualArgs,
                                           CmdArgs::const_iterator actualArgsEnd) const
+{
+   const CmdArgViews argViews(actualArgs, actualArgsEnd);
+   CmdArgViews::const_iterator viewIter = argViews.begin();
+
+   const std::optional<VerifiedArgView> matchedArg = match(viewIter, argViews.end());
+   if (!matchedArg.has_value())
+      return std::nullopt;
+
+   std::advance(actualArgs, std::distance(argViews.begin(), viewIter));
+   return toVerifiedArg(matchedArg.value());
+}
+
+
+std::optional<VerifiedArgView> ArgSpec::match(CmdArgViews::const_iterator& actualArgs,
+                                              CmdArgViews::const_iterator actualArgsEnd) const
+{
+   const SymbolId actualLabelId =
+      (hasLabel() && actualArgs != actualArgsEnd) ? findLabelSymbol(*actualArgs) : NoSymbol;
+   return match(actualArgs, actualArgsEnd, actualLabelId);
+}
+
+
+std::optional<VerifiedArgView> ArgSpec::match(CmdArgViews::const_iterator& actualArgs,
+                                              CmdArgViews::const_iterator actualArgsEnd,
+                                              SymbolId actualLabelId,
+                                              std::pmr::memory_resource* resource) const
 {
    if (actualArgs == actualArgsEnd)
    {
       // Zero matching positional values might be valid for 'zero or more' specs.
       return (!hasLabel() && haveEnoughValues(0))
-                ? std::optional<VerifiedArg>{VerifiedArg{}}
+                ? std::optional<VerifiedArgView>{VerifiedArgView{resource}}
                 : std::nullopt;
    }
 
-   CmdArgs::const_iterator actualArgsBegin = actualArgs;
-   std::string currArg = *actualArgs;
-   std::string currArgWithoutSep = stripArgSeparators(currArg);
+   CmdArgViews::const_iterator actualArgsBegin = actualArgs;
 
-   if (hasLabel() && (!isArgLabel(currArg) || !matchLabel(currArgWithoutSep)))
+   if (hasLabel() && !matchLabel(actualLabelId))
       return std::nullopt;
 
-   VerifiedArg matchedArg;
+   VerifiedArgView matchedArg{resource};
    if (hasLabel())
    {
       matchedArg.label = m_label.label();
+      matchedArg.labelId = m_label.labelId();
       ++actualArgs;
    }
 
-   const auto matchedValues = matchValues(actualArgs, actualArgsEnd);
-   if (!matchedValues.has_value())
+   if (!matchValues(actualArgs, actualArgsEnd, matchedArg))
    {
       // Restore original position of actual arg iterator.
       actualArgs = actualArgsBegin;
       return std::nullopt;
    }
-   matchedArg.values = matchedValues.value();
 
    return matchedArg;
 }
 
 
-std::optional<std::vector<std::string>>
-ArgSpec::matchValues(CmdArgs::const_iterator& actualArgs,
-                     CmdArgs::const_iterator actualArgsEnd) const
+bool ArgSpec::matchValues(CmdArgViews::const_iterator& actualArgs,
+                          CmdArgViews::const_iterator actualArgsEnd,
+                          VerifiedArgView& matchedArg) const
 {
-   std::vector<std::string> matchedValues;
+   std::pmr::vector<std::string_view>& matchedValues = matchedArg.values;
 
-   std::string currArg;
    while (actualArgs != actualArgsEnd && canMatchMoreValues(matchedValues.size()))
    {
-      currArg = *actualArgs;
+      const std::string_view currArg = *actualArgs;
+      // Negative numbers look like labels. Numeric values take them as values.
+      const bool isNegativeValue = isNumeric() && isNegativeNumber(currArg);
       // Stop if we reach the next label.
-      if (isArgLabel(currArg))
+      if (isArgLabel(currArg) && !isNegativeValue)
          break;
 
-      matchedValues.push_back(stripArgSeparators(currArg));
+      const std::string_view value =
+         isNegativeValue ? currArg : stripArgSeparatorsView(currArg);
+      // Convert typed values right away. Values that cannot be converted make the
+      // argument invalid.
+      if (!m_valueType.isText())
+      {
+         std::optional<ArgValue> typedValue = parseArgValue(value, m_valueType);
+         if (!typedValue.has_value())
+            return false;
+         matchedArg.typedValues.push_back(std::move(typedValue.value()));
+      }
+
+      matchedValues.push_back(value);
       ++actualArgs;
    }
 
-   if (!haveEnoughValues(matchedValues.size()))
-      return std::nullopt;
-   return matchedValues;
+   return haveEnoughValues(matchedValues.size());
+}
+
+
+bool ArgSpec::isNumeric() const
+{
+   return m_valueType.kind() == ValueKind::Int || m_valueType.kind() == ValueKind::Double;
 }
 
 
@@ -343,36 +540,89 @@ bool ArgSpec::haveEnoughValues(std::size_t numMatchedValues) const
 
 ///////////////////
 
+CmdSpec::CmdSpec() : m_data{emptyData()}
+{
+}
+
+
 CmdSpec::CmdSpec(const std::string& name, const std::string& shortName,
                  const std::string& description, std::vector<ArgSpec> argSpecs,
                  const std::string& notes)
-: m_name{sutil::lowercase(name), sutil::lowercase(shortName)}, m_description{description},
-  m_argSpecs{argSpecs}, m_notes{notes}
 {
+   const std::string lowercaseName = sutil::lowercase(name);
+   OptionIndex optionIndex = makeOptionIndex(lowercaseName, argSpecs);
+
+   // No timeout and not pure until set.
+   const std::optional<std::chrono::milliseconds> timeout = std::nullopt;
+   const bool isPure = false;
+   m_data = std::make_shared<const Data>(
+      Data{LabelWithAbbrev{lowercaseName, sutil::lowercase(shortName)}, description, notes,
+           std::move(argSpecs), std::move(optionIndex), timeout, isPure});
 }
 
 
 CmdSpec::operator bool() const
 {
-   return !!m_name;
+   return !!m_data->name;
+}
+
+
+bool CmdSpec::matchesName(std::string_view name) const
+{
+   return m_data->name.matches(name);
+}
+
+
+const std::string& CmdSpec::name() const
+{
+   return m_data->name.label();
+}
+
+
+SymbolId CmdSpec::nameId() const
+{
+   return m_data->name.labelId();
+}
+
+
+const std::string& CmdSpec::abbreviation() const
+{
+   return m_data->name.abbreviation();
+}
+
+
+const std::string& CmdSpec::description() const
+{
+   return m_data->description;
 }
 
 
-bool CmdSpec::matchesName(const std::string& name) const
+std::optional<std::chrono::milliseconds> CmdSpec::timeout() const
 {
-   return m_name.matches(name);
+   return m_data->timeout;
 }
 
 
-std::string CmdSpec::name() const
+void CmdSpec::setTimeout(std::optional<std::chrono::milliseconds> timeout)
 {
-   return m_name.label();
+   // The data is shared with copies of the spec. Copy it before changing it.
+   auto data = std::make_shared<Data>(*m_data);
+   data->timeout = timeout;
+   m_data = std::move(data);
 }
 
 
-std::string CmdSpec::description() const
+bool CmdSpec::isPure() const
 {
-   return m_description;
+   return m_data->isPure;
+}
+
+
+void CmdSpec::setPure(bool isPure)
+{
+   auto data = std::make_shared<Data>(*m_data);
+   data->isPure = isPure;
+   m_data = std::move(data);
 }
 
 
@@ -388,24 +638,24 @@ std::string CmdSpec::help() const
 
    std::string help;
    help += "Name:\n";
-   help += Indent + m_name.label() + Newline;
+   help += Indent + m_data->name.label() + Newline;
 
    help += "Abbreviation:\n";
-   if (m_name.haveAbbreviation())
-      help += Indent + m_name.abbreviation() + Newline;
+   if (m_data->name.haveAbbreviation())
+      help += Indent + m_data->name.abbreviation() + Newline;
    else
       help += NotAvailable;
 
    help += "Description:\n";
-   if (!m_description.empty())
-      help += Indent + m_description + Newline;
+   if (!m_data->description.empty())
+      help += Indent + m_data->description + Newline;
    else
       help += NotAvailable;
 
    help += "Arguments:\n";
-   if (!m_argSpecs.empty())
+   if (!m_data->argSpecs.empty())
    {
-      for (const ArgSpec& argSpec : m_argSpecs)
+      for (const ArgSpec& argSpec : m_data->argSpecs)
          help += argSpec.help(Indent) + Newline;
    }
    else
@@ -413,10 +663,16 @@ std::string CmdSpec::help() const
       help += NotAvailable;
    }
 
+   if (m_data->timeout.has_value())
+   {
+      help += "Timeout:\n";
+      help += Indent + std::to_string(m_data->timeout->count()) + " ms" + Newline;
+   }
+
    help += "Notes:\n";
-   if (!m_notes.empty())
+   if (!m_data->notes.empty())
    {
-      const std::vector<std::string> noteLines = sutil::split(m_notes, "\n");
+      const std::vector<std::string> noteLines = sutil::split(m_data->notes, "\n");
       for (const std::string& line : noteLines)
          help += Indent + line + Newline;
    }
@@ -431,9 +687,9 @@ std::string CmdSpec::help() const
 
 bool CmdSpec::hasArgSpec(const std::string& argLabel) const
 {
-   auto endPos = std::end(m_argSpecs);
+   auto endPos = std::end(m_data->argSpecs);
    return (endPos !=
-           find_if(std::begin(m_argSpecs), endPos,
+           find_if(std::begin(m_data->argSpecs), endPos,
                    [&argLabel](const auto& spec) { return spec.matchLabel(argLabel); }));
 }
 
@@ -443,59 +699,85 @@ CmdSpec::Match CmdSpec::match(const std::string& cmd) const
    if (!*this)
       return {};
 
-   std::vector<std::string> cmdPieces = sutil::split(cmd, " ");
+   const MatchView matched = match(splitCmdLine(cmd));
+   if (!matched.isMatching || !matched.areArgsValid)
+      return {matched.isMatching, matched.areArgsValid, {}};
+   return {true, true, toVerifiedCmd(matched.matchedCmd)};
+}
+
+
+CmdSpec::MatchView CmdSpec::match(const CmdArgViews& cmdPieces) const
+{
+   if (!*this)
+      return {};
+
    if (cmdPieces.empty())
       return {};
 
-   if (!matchesName(sutil::lowercase(cmdPieces[0])))
+   if (!m_data->name.matchesIgnoringCase(cmdPieces[0]))
       return {};
 
-   VerifiedCmd verifiedCmd;
+   VerifiedCmdView verifiedCmd{cmdPieces.get_allocator().resource()};
    verifiedCmd.name = name();
+   verifiedCmd.nameId = nameId();
 
-   cmdPieces.erase(cmdPieces.begin());
-
-   const std::optional<VerifiedArgs> args = matchCmdArgs(cmdPieces);
-   if (!args.has_value())
+   // Skip the command name.
+   if (!matchCmdArgs(std::next(std::begin(cmdPieces)), std::end(cmdPieces),
+                     verifiedCmd.args))
+   {
       return {true, false, {}};
-   verifiedCmd.args = args.value();
+   }
 
-   return {true, true, verifiedCmd};
+   return {true, true, std::move(verifiedCmd)};
 }
 
 
-std::optional<VerifiedArgs> CmdSpec::matchCmdArgs(const CmdArgs& args) const
+bool CmdSpec::matchCmdArgs(CmdArgViews::const_iterator argsBegin,
+                           CmdArgViews::const_iterator argsEnd,
+                           VerifiedArgViews& verifiedArgs) const
 {
-   if (containsHelpParameter(args))
-      return VerifiedArgs{VerifiedArg{HelpArgSpec.label()}};
+   if (containsHelpParameter(argsBegin, argsEnd))
+   {
+      VerifiedArgView helpArg{verifiedArgs.get_allocator().resource()};
+      helpArg.label = HelpArgSpec.label();
+      helpArg.labelId = HelpArgSpec.labelId();
+      verifiedArgs.push_back(std::move(helpArg));
+      return true;
+   }
 
    auto posSpecs = firstPositionalArgument();
    auto posSpecsEnd = firstOptionalArgument();
-   auto optSpecs = posSpecsEnd;
-   auto optSpecsEnd = end();
 
-   auto actualArgs = std::begin(args);
-   auto actualArgsEnd = std::end(args);
+   auto actualArgs = argsBegin;
 
-   VerifiedArgs verifiedArgs;
-   const std::optional<VerifiedArgs> parsedArgs =
-      matchPositionalCmdArgs(posSpecs, posSpecsEnd, actualArgs, actualArgsEnd);
-   if (!parsedArgs.has_value())
-      return std::nullopt;
-   verifiedArgs = parsedArgs.value();
+   verifiedArgs.reserve(m_data->argSpecs.size());
+   if (!matchPositionalCmdArgs(begin(), posSpecs, posSpecsEnd, actualArgs, argsEnd,
+                               verifiedArgs))
+      return false;
+   if (!matchOptionalCmdArgs(*this, actualArgs, argsEnd, verifiedArgs))
+      return false;
 
-   const std::optional<VerifiedArgs> parsedOptArgs =
-      matchOptionalCmdArgs(optSpecs, optSpecsEnd, actualArgs, actualArgsEnd);
-   if (!parsedOptArgs.has_value())
-      return std::nullopt;
+   const bool haveUnmacthedArgs = (actualArgs != argsEnd);
+   return !haveUnmacthedArgs;
+}
 
-   const bool haveUnmacthedArgs = (actualArgs != std::end(args));
-   if (haveUnmacthedArgs)
-      return std::nullopt;
 
-   std::copy(parsedOptArgs.value().begin(), parsedOptArgs.value().end(),
-             std::back_inserter(verifiedArgs));
-   return verifiedArgs;
+CmdSpec::ArgSpecIter_t CmdSpec::findOptionalArgSpec(SymbolId labelId) const
+{
+   const std::vector<std::pair<SymbolId, std::size_t>>& index = m_data->optionIndex;
+   const auto indexIter =
+      std::lower_bound(index.begin(), index.end(), labelId,
+                       [](const auto& entry, SymbolId id) { return entry.first < id; });
+   if (indexIter == index.end() || indexIter->first != labelId)
+      return end();
+   return begin() + indexIter->second;
+}
+
+
+const std::shared_ptr<const CmdSpec::Data>& CmdSpec::emptyData()
+{
+   static const std::shared_ptr<const Data> empty = std::make_shared<const Data>();
+   return empty;
 }
 
 
@@ -6,10 +6,15 @@
 //
 #pragma once
 #include "cmd.h"
+#include "symbol_table.h"
+#include <chrono>
 #include <cstddef>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -18,6 +23,11 @@ namespace ccon
 {
 ///////////////////
 
+class ValueCompletionProvider;
+
+
+///////////////////
+
 class LabelWithAbbrev
 {
  public:
@@ -31,14 +41,67 @@ class LabelWithAbbrev
 
    explicit operator bool() const;
 
-   bool matches(const std::string& match) const;
-   std::string label() const;
+   bool matches(std::string_view match) const;
+   // Matches ignoring the case of the passed text. Requires the label and
+   // abbreviation to be lowercase.
+   bool matchesIgnoringCase(std::string_view match) const;
+   // Matches an interned name.
+   bool matches(SymbolId match) const;
+   const std::string& label() const;
+   SymbolId labelId() const { return m_labelId; }
    bool haveAbbreviation() const;
-   std::string abbreviation() const;
+   const std::string& abbreviation() const;
+   SymbolId abbreviationId() const { return m_abbrevId; }
 
  private:
    std::string m_label;
    std::string m_abbrev;
+   SymbolId m_labelId = NoSymbol;
+   SymbolId m_abbrevId = NoSymbol;
+};
+
+
+///////////////////
+
+// Kinds of values that arguments can declare.
+enum class ValueKind
+{
+   Text,
+   Int,
+   Double,
+   // Color in 'rrggbb' format.
+   HexColor,
+   // One of a given set of names.
+   Enum,
+   Bool,
+   Path
+};
+
+
+// Type of the values of an argument.
+class ValueType
+{
+ public:
+   // Creates a type for values that have to match one of the given names (case
+   // insensitive).
+   static ValueType makeEnum(const std::vector<std::string>& members);
+
+   ValueType() = default;
+   ValueType(ValueKind kind);
+   ~ValueType() = default;
+   ValueType(const ValueType&) = default;
+   ValueType(ValueType&&) = default;
+   ValueType& operator=(const ValueType&) = default;
+   ValueType& operator=(ValueType&&) = default;
+
+   ValueKind kind() const { return m_kind; }
+   bool isText() const { return m_kind == ValueKind::Text; }
+   const std::vector<std::string>& enumMembers() const { return m_enumMembers; }
+   std::string help() const;
+
+ private:
+   ValueKind m_kind = ValueKind::Text;
+   std::vector<std::string> m_enumMembers;
 };
 
 
@@ -53,11 +116,13 @@ class ArgSpec
 
    // Creates a spec for a required, positional argument (one or more values).
    static ArgSpec makePositionalArg(std::size_t numValues,
-                                    const std::string& description = "");
+                                    const std::string& description = "",
+                                    const ValueType& valueType = {});
    // Creates a spec for an optional argument (a label followed by one or more values).
    static ArgSpec makeOptionalArg(const std::string& label, std::size_t numValues,
                                   const std::string& abbrev = "",
-                                  const std::string& description = "");
+                                  const std::string& description = "",
+                                  const ValueType& valueType = {});
    // Creates a spec for a flag argument (a special optional argument without any values).
    static ArgSpec makeFlagArg(const std::string& label, const std::string& abbrev = "",
                               const std::string& description = "");
@@ -72,20 +137,48 @@ class ArgSpec
    explicit operator bool() const;
    bool isRequired() const;
    bool hasLabel() const;
-   std::string label() const;
+   const std::string& label() const;
+   SymbolId labelId() const { return m_label.labelId(); }
+   const std::string& abbreviation() const;
+   SymbolId abbreviationId() const { return m_label.abbreviationId(); }
+   std::size_t numValues() const { return m_numValues; }
+   const ValueType& valueType() const { return m_valueType; }
+   // Completes partially entered values of the argument. Copies of the spec share
+   // the provider.
+   const std::shared_ptr<ValueCompletionProvider>& completionProvider() const
+   {
+      return m_completionProvider;
+   }
+   void setCompletionProvider(std::shared_ptr<ValueCompletionProvider> provider)
+   {
+      m_completionProvider = std::move(provider);
+   }
    std::string help(const std::string& indent = {}) const;
 
-   bool matchLabel(const std::string& argName) const;
+   bool matchLabel(std::string_view argName) const;
+   bool matchLabel(SymbolId argNameId) const;
    std::optional<VerifiedArg> match(CmdArgs::const_iterator& actualArgs,
                                     CmdArgs::const_iterator actualArgsEnd) const;
+   // Non-allocating version for matching words of a command line. The returned
+   // view refers to this spec and to the text of the matched words.
+   std::optional<VerifiedArgView> match(CmdArgViews::const_iterator& actualArgs,
+                                        CmdArgViews::const_iterator actualArgsEnd) const;
+   // Version for callers that already looked up the interned label at the current
+   // position (NoSymbol if it is not a label). The matched values are allocated
+   // from a given memory resource.
+   std::optional<VerifiedArgView>
+   match(CmdArgViews::const_iterator& actualArgs, CmdArgViews::const_iterator actualArgsEnd,
+         SymbolId actualLabelId,
+         std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
 
  private:
    ArgSpec(const std::string& label, const std::string& abbrev, std::size_t numValues,
-           const std::string& description);
+           const std::string& description, const ValueType& valueType);
 
-   std::optional<std::vector<std::string>>
-   matchValues(CmdArgs::const_iterator& actualArgs,
-               CmdArgs::const_iterator actualArgsEnd) const;
+   bool matchValues(CmdArgViews::const_iterator& actualArgs,
+                    CmdArgViews::const_iterator actualArgsEnd,
+                    VerifiedArgView& matchedArg) const;
+   bool isNumeric() const;
    bool canMatchMoreValues(std::size_t matchedValues) const;
    bool haveEnoughValues(std::size_t matchedValues) const;
 
@@ -93,11 +186,17 @@ class ArgSpec
    LabelWithAbbrev m_label;
    std::size_t m_numValues = 0;
    std::string m_description;
+   ValueType m_valueType;
+   std::shared_ptr<ValueCompletionProvider> m_completionProvider;
 };
 
 
 // Common help argument that can be used for all commands.
 const ArgSpec HelpArgSpec = ArgSpec::makeFlagArg("help", "?");
+// Common argument that limits the execution time of a command to a given number of
+// milliseconds. Arguments of the command with the same label take precedence.
+const ArgSpec TimeoutArgSpec = ArgSpec::makeOptionalArg(
+   "timeout", 1, "", "aborts the command after the given milliseconds", ValueKind::Int);
 
 
 ///////////////////
@@ -115,31 +214,52 @@ const ArgSpec HelpArgSpec = ArgSpec::makeFlagArg("help", "?");
 //   - Have to come after any positional arguments.
 //   - Their order can be changed.
 //   - They are optional. Missing one will not cause an error.
+//
+// Optional arguments are looked up by their labels and abbreviations. Specs whose
+// optional arguments cannot be told apart are rejected when constructing the command
+// spec by throwing std::invalid_argument:
+// - Labels or abbreviations that are used by multiple optional arguments.
+// - Labels or abbreviations of the common help argument.
+// - Positional arguments that come after optional arguments.
 class CmdSpec
 {
  public:
    using ArgSpecIter_t = std::vector<ArgSpec>::const_iterator;
 
  public:
-   CmdSpec() = default;
+   CmdSpec();
+   // Throws std::invalid_argument for ambiguous argument specs.
    CmdSpec(const std::string& name, const std::string& shortName,
            const std::string& description, std::vector<ArgSpec> argSpecs,
            const std::string& notes);
    ~CmdSpec() = default;
+   // Specs share their immutable data, so copies are cheap. Moves are implemented as
+   // copies to keep moved-from specs valid.
    CmdSpec(const CmdSpec&) = default;
-   CmdSpec(CmdSpec&&) = default;
    CmdSpec& operator=(const CmdSpec&) = default;
-   CmdSpec& operator=(CmdSpec&&) = default;
 
    explicit operator bool() const;
-   bool matchesName(const std::string& cmdName) const;
-   std::string name() const;
-   std::string description() const;
+   bool matchesName(std::string_view cmdName) const;
+   const std::string& name() const;
+   SymbolId nameId() const;
+   const std::string& abbreviation() const;
+   const std::string& description() const;
    std::string help() const;
    bool hasArgSpec(const std::string& argLabel) const;
-
-   ArgSpecIter_t begin() const { return m_argSpecs.begin(); }
-   ArgSpecIter_t end() const { return m_argSpecs.end(); }
+   // Time after which executions of the command are aborted. Can be overridden for
+   // a single execution with the common timeout argument.
+   std::optional<std::chrono::milliseconds> timeout() const;
+   void setTimeout(std::optional<std::chrono::milliseconds> timeout);
+   // Pure commands have no side effects and produce the same output for the same
+   // arguments. The console reuses their results instead of executing them again.
+   bool isPure() const;
+   void setPure(bool isPure);
+
+   ArgSpecIter_t begin() const { return m_data->argSpecs.begin(); }
+   ArgSpecIter_t end() const { return m_data->argSpecs.end(); }
+   // Looks up the optional argument spec with a given interned label or
+   // abbreviation. Returns the end iterator if there is none.
+   ArgSpecIter_t findOptionalArgSpec(SymbolId labelId) const;
 
    struct Match
    {
@@ -149,16 +269,42 @@ class CmdSpec
    };
    Match match(const std::string& cmd) const;
 
+   struct MatchView
+   {
+      bool isMatching = false;
+      bool areArgsValid = false;
+      VerifiedCmdView matchedCmd;
+   };
+   // Version for matching a command line that was already split into words. The
+   // matched command refers to this spec and to the text of the words. Its memory is
+   // allocated from the memory resource of the words.
+   MatchView match(const CmdArgViews& cmdPieces) const;
+
  private:
-   std::optional<VerifiedArgs> matchCmdArgs(const CmdArgs& args) const;
+   bool matchCmdArgs(CmdArgViews::const_iterator argsBegin,
+                     CmdArgViews::const_iterator argsEnd,
+                     VerifiedArgViews& verifiedArgs) const;
    ArgSpecIter_t firstPositionalArgument() const;
    ArgSpecIter_t firstOptionalArgument() const;
 
  private:
-   LabelWithAbbrev m_name;
-   std::string m_description;
-   std::string m_notes;
-   std::vector<ArgSpec> m_argSpecs;
+   struct Data
+   {
+      LabelWithAbbrev name;
+      std::string description;
+      std::string notes;
+      std::vector<ArgSpec> argSpecs;
+      // Indices of optional argument specs by the ids of their labels and
+      // abbreviations. Sorted by id.
+      std::vector<std::pair<SymbolId, std::size_t>> optionIndex;
+      std::optional<std::chrono::milliseconds> timeout;
+      bool isPure = false;
+   };
+
+   static const std::shared_ptr<const Data>& emptyData();
+
+ private:
+   std::shared_ptr<const Data> m_data;
 };
 
 
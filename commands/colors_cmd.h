@@ -7,8 +7,10 @@
 #pragma once
 #include "cmd.h"
 #include "cmd_spec.h"
+#include "static_cmd_spec.h"
 #include "essentutils/color.h"
 #include <optional>
+#include <string_view>
 
 namespace ccon
 {
@@ -23,31 +25,28 @@ namespace ccon
 namespace colorsCmd
 {
 
-const std::string cmdName = ":colors";
-const std::string backgroundOption = "background";
-const std::string outputTextOption = "output";
-const std::string inputTextOption = "input";
-const std::string defaultsOption = "defaults";
+inline constexpr std::string_view cmdName = ":colors";
+inline constexpr std::string_view backgroundOption = "background";
+inline constexpr std::string_view outputTextOption = "output";
+inline constexpr std::string_view inputTextOption = "input";
+inline constexpr std::string_view defaultsOption = "defaults";
+
+inline constexpr StaticArgSpec argSpecs[] = {
+   {backgroundOption, "b", 1, "background color", ValueKind::HexColor},
+   {outputTextOption, "o", 1, "output text color", ValueKind::HexColor},
+   {inputTextOption, "i", 1, "input text color", ValueKind::HexColor},
+   {defaultsOption, "d", 0, "reset all colors to defaults"},
+};
+
+inline constexpr StaticCmdSpec cmdSpec{cmdName, ":c", "sets the colors for the console",
+                                       argSpecs};
 
 } // namespace colorsCmd
 
 
 inline CmdSpec makeConsoleColorsCmdSpec()
 {
-   return {colorsCmd::cmdName,
-           ":c",
-           "sets the colors for the console",
-           {
-              ArgSpec::makeOptionalArg(colorsCmd::backgroundOption, 1, "b",
-                                       "background color (rrggbb)"),
-              ArgSpec::makeOptionalArg(colorsCmd::outputTextOption, 1, "o",
-                                       "output text color (rrggbb)"),
-              ArgSpec::makeOptionalArg(colorsCmd::inputTextOption, 1, "i",
-                                       "input text color (rrggbb)"),
-              ArgSpec::makeFlagArg(colorsCmd::defaultsOption, "d",
-                                   "reset all colors to defaults"),
-           },
-           ""};
+   return toCmdSpec(colorsCmd::cmdSpec);
 }
 
 
@@ -65,6 +64,11 @@ class ConsoleColorsCmd : public Cmd
    ConsoleColorsCmd& operator=(ConsoleColorsCmd&&) = default;
 
    CmdOutput execute(const VerifiedCmd& input) override;
+   // Changes the colors of the console UI.
+   CmdThreadAffinity threadAffinity() const override
+   {
+      return CmdThreadAffinity::UIThread;
+   }
 
  private:
    struct Options
@@ -7,6 +7,8 @@
 #pragma once
 #include "cmd.h"
 #include "cmd_spec.h"
+#include "static_cmd_spec.h"
+#include <string_view>
 
 namespace ccon
 {
@@ -21,14 +23,16 @@ namespace ccon
 namespace exitCmd
 {
 
-const std::string cmdName = "exit";
+inline constexpr std::string_view cmdName = "exit";
+
+inline constexpr StaticCmdSpec cmdSpec{cmdName, "x", "exits the console"};
 
 } // namespace exitCmd
 
 
 inline CmdSpec makeExitCmdSpec()
 {
-   return {exitCmd::cmdName, "x", "exits the console", {}, ""};
+   return toCmdSpec(exitCmd::cmdSpec);
 }
 
 
@@ -46,6 +50,11 @@ class ExitCmd : public Cmd
    ExitCmd& operator=(ExitCmd&&) = default;
 
    CmdOutput execute(const VerifiedCmd& input) override;
+   // Closes the console UI.
+   CmdThreadAffinity threadAffinity() const override
+   {
+      return CmdThreadAffinity::UIThread;
+   }
 
 private:
    ConsoleUI* m_ui = nullptr;
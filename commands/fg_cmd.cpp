@@ -0,0 +1,54 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "fg_cmd.h"
+#include "cmd_parser.h"
+#include "jobs.h"
+#include <cassert>
+
+
+namespace ccon
+{
+///////////////////
+
+FgCmd::FgCmd(JobTable* jobs) : m_jobs{jobs}
+{
+}
+
+
+void FgCmd::execute(const VerifiedCmd& input, OutputSink& out)
+{
+   assert(input.name == fgCmd::cmdName);
+
+   const int jobId = argValue<int>(input.args[0]).value_or(0);
+   Job* job = (m_jobs && jobId > 0) ? m_jobs->findJob(jobId) : nullptr;
+   if (!job)
+   {
+      out.writeLine("No job with id " + std::to_string(jobId) + ".");
+      return;
+   }
+
+   if (!job->isBackground)
+   {
+      out.writeLine("Job " + std::to_string(jobId) + " is already in the foreground.");
+      return;
+   }
+
+   const JobOutputBatch batch = job->output->takeBatch();
+   writeJobOutput(batch, out);
+
+   if (batch.isFinal)
+   {
+      m_jobs->removeJob(job->id);
+      return;
+   }
+
+   // The console displays the further output of the job as it arrives.
+   job->isBackground = false;
+   job->output->setOverflow(JobOutputOverflow::Wait);
+}
+
+} // namespace ccon
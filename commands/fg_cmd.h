@@ -0,0 +1,70 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd.h"
+#include "cmd_spec.h"
+#include "static_cmd_spec.h"
+#include <string_view>
+
+namespace ccon
+{
+class JobTable;
+}
+
+
+namespace ccon
+{
+///////////////////
+
+namespace fgCmd
+{
+
+inline constexpr std::string_view cmdName = "fg";
+
+inline constexpr StaticArgSpec argSpecs[] = {
+   {"", "", 1, "id of the job", ValueKind::Int},
+};
+
+inline constexpr StaticCmdSpec cmdSpec{
+   cmdName, "", "displays the buffered output of a background job and its further output",
+   argSpecs};
+
+} // namespace fgCmd
+
+
+inline CmdSpec makeFgCmdSpec()
+{
+   return toCmdSpec(fgCmd::cmdSpec);
+}
+
+
+///////////////////
+
+class FgCmd : public StreamingCmd
+{
+ public:
+   FgCmd() = default;
+   explicit FgCmd(JobTable* jobs);
+   ~FgCmd() = default;
+   FgCmd(const FgCmd&) = default;
+   FgCmd(FgCmd&&) = default;
+   FgCmd& operator=(const FgCmd&) = default;
+   FgCmd& operator=(FgCmd&&) = default;
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd& input, OutputSink& out) override;
+   // Changes the job table which the UI thread uses.
+   CmdThreadAffinity threadAffinity() const override
+   {
+      return CmdThreadAffinity::UIThread;
+   }
+
+ private:
+   JobTable* m_jobs = nullptr;
+};
+
+} // namespace ccon
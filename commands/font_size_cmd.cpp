@@ -5,9 +5,9 @@
 // MIT license
 //
 #include "font_size_cmd.h"
+#include "cmd_parser.h"
 #include "console_ui.h"
 #include "preferences.h"
-#include "essentutils/string_util.h"
 #include <cassert>
 #include <tuple>
 #include <utility>
@@ -19,7 +19,8 @@ namespace
 
 int interpretArgs(const ccon::VerifiedArgs& args)
 {
-   return sutil::intFromStr(args[0].values[0], 0);
+   // The value was converted to an integer during verification.
+   return ccon::argValue<int>(args[0]).value_or(0);
 }
 
 } // namespace
@@ -7,6 +7,8 @@
 #pragma once
 #include "cmd.h"
 #include "cmd_spec.h"
+#include "static_cmd_spec.h"
+#include <string_view>
 #include <utility>
 
 namespace ccon
@@ -22,21 +24,21 @@ namespace ccon
 namespace fontSizeCmd
 {
 
-const std::string cmdName = ":fontsize";
+inline constexpr std::string_view cmdName = ":fontsize";
+
+inline constexpr StaticArgSpec argSpecs[] = {
+   {"", "", 1, "font size in points; use 0 to reset to default size", ValueKind::Int},
+};
+
+inline constexpr StaticCmdSpec cmdSpec{cmdName, ":fs", "sets the font size for the console",
+                                       argSpecs};
 
 } // namespace fontSizeCmd
 
 
 inline CmdSpec makeConsoleFontSizeCmdSpec()
 {
-   return {fontSizeCmd::cmdName,
-           ":fs",
-           "sets the font size for the console",
-           {
-              ArgSpec::makePositionalArg(
-                 1, "font size in points; use 0 to reset to default size"),
-           },
-           ""};
+   return toCmdSpec(fontSizeCmd::cmdSpec);
 }
 
 
@@ -54,6 +56,11 @@ class ConsoleFontSizeCmd : public Cmd
    ConsoleFontSizeCmd& operator=(ConsoleFontSizeCmd&&) = default;
 
    CmdOutput execute(const VerifiedCmd& input) override;
+   // Changes the font of the console UI.
+   CmdThreadAffinity threadAffinity() const override
+   {
+      return CmdThreadAffinity::UIThread;
+   }
 
  private:
    std::pair<bool, std::string> canExecute() const;
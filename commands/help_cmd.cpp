@@ -11,20 +11,26 @@ namespace ccon
 {
 ///////////////////
 
-HelpCmd::HelpCmd(const std::set<CmdSpec>& specs) : m_specs(specs)
+HelpCmd::HelpCmd(const std::set<CmdSpec>& specs) : m_specs{&specs}
 {
 }
 
 
-CmdOutput HelpCmd::execute(const VerifiedCmd& input)
+void HelpCmd::execute(const VerifiedCmd& input, OutputSink& out)
 {
-   const std::string indent{"  "};
+   const std::string_view indent{"  "};
 
-   CmdOutput out;
-   out.push_back("Commands:");
-   for (const CmdSpec& spec : m_specs)
-      out.push_back(indent + spec.name() + " - " + spec.description());
-   return out;
+   out.writeLine("Commands:");
+   if (!m_specs)
+      return;
+
+   for (const CmdSpec& spec : *m_specs)
+   {
+      out.write(indent);
+      out.write(spec.name());
+      out.write(" - ");
+      out.writeLine(spec.description());
+   }
 }
 
 } // namespace ccon
@@ -7,8 +7,10 @@
 #pragma once
 #include "cmd.h"
 #include "cmd_spec.h"
+#include "static_cmd_spec.h"
 #include <set>
 #include <string>
+#include <string_view>
 
 
 namespace ccon
@@ -18,23 +20,26 @@ namespace ccon
 namespace helpCmd
 {
 
-const std::string cmdName = "help";
+inline constexpr std::string_view cmdName = "help";
+
+inline constexpr StaticCmdSpec cmdSpec{cmdName, "?", "lists all commands"};
 
 } // namespace helpCmd
 
 
 inline CmdSpec makeHelpCmdSpec()
 {
-   return {helpCmd::cmdName, "?", "lists all commands", {}, ""};
+   return toCmdSpec(helpCmd::cmdSpec);
 }
 
 
 ///////////////////
 
-class HelpCmd : public Cmd
+class HelpCmd : public StreamingCmd
 {
  public:
    HelpCmd() = default;
+   // The specs are referenced, not copied. They have to outlive the command.
    explicit HelpCmd(const std::set<CmdSpec>& specs);
    ~HelpCmd() = default;
    HelpCmd(const HelpCmd&) = default;
@@ -42,10 +47,16 @@ class HelpCmd : public Cmd
    HelpCmd& operator=(const HelpCmd&) = default;
    HelpCmd& operator=(HelpCmd&&) = default;
 
-   CmdOutput execute(const VerifiedCmd& input) override;
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd& input, OutputSink& out) override;
+   // Reads the specs which the UI thread can change.
+   CmdThreadAffinity threadAffinity() const override
+   {
+      return CmdThreadAffinity::UIThread;
+   }
 
  private:
-   std::set<CmdSpec> m_specs;
+   const std::set<CmdSpec>* m_specs = nullptr;
 };
 
 } // namespace ccon
@@ -0,0 +1,32 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "jobs_cmd.h"
+#include "jobs.h"
+
+
+namespace ccon
+{
+///////////////////
+
+JobsCmd::JobsCmd(JobTable* jobs) : m_jobs{jobs}
+{
+}
+
+
+void JobsCmd::execute(const VerifiedCmd& /*input*/, OutputSink& out)
+{
+   if (!m_jobs || m_jobs->empty())
+   {
+      out.writeLine("No jobs.");
+      return;
+   }
+
+   for (const auto& [id, job] : *m_jobs)
+      out.writeLine(describeJob(job));
+}
+
+} // namespace ccon
@@ -0,0 +1,66 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd.h"
+#include "cmd_spec.h"
+#include "static_cmd_spec.h"
+#include <string_view>
+
+namespace ccon
+{
+class JobTable;
+}
+
+
+namespace ccon
+{
+///////////////////
+
+namespace jobsCmd
+{
+
+inline constexpr std::string_view cmdName = "jobs";
+
+inline constexpr StaticCmdSpec cmdSpec{
+   cmdName, "", "lists the running and background jobs",
+   "Start a command as background job with a trailing '&'."};
+
+} // namespace jobsCmd
+
+
+inline CmdSpec makeJobsCmdSpec()
+{
+   return toCmdSpec(jobsCmd::cmdSpec);
+}
+
+
+///////////////////
+
+class JobsCmd : public StreamingCmd
+{
+ public:
+   JobsCmd() = default;
+   explicit JobsCmd(JobTable* jobs);
+   ~JobsCmd() = default;
+   JobsCmd(const JobsCmd&) = default;
+   JobsCmd(JobsCmd&&) = default;
+   JobsCmd& operator=(const JobsCmd&) = default;
+   JobsCmd& operator=(JobsCmd&&) = default;
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd& input, OutputSink& out) override;
+   // Reads the job table which the UI thread changes.
+   CmdThreadAffinity threadAffinity() const override
+   {
+      return CmdThreadAffinity::UIThread;
+   }
+
+ private:
+   JobTable* m_jobs = nullptr;
+};
+
+} // namespace ccon
@@ -0,0 +1,44 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "kill_cmd.h"
+#include "cmd_parser.h"
+#include "jobs.h"
+#include <cassert>
+
+
+namespace ccon
+{
+///////////////////
+
+KillCmd::KillCmd(JobTable* jobs) : m_jobs{jobs}
+{
+}
+
+
+void KillCmd::execute(const VerifiedCmd& input, OutputSink& out)
+{
+   assert(input.name == killCmd::cmdName);
+
+   const int jobId = argValue<int>(input.args[0]).value_or(0);
+   Job* job = (m_jobs && jobId > 0) ? m_jobs->findJob(jobId) : nullptr;
+   if (!job)
+   {
+      out.writeLine("No job with id " + std::to_string(jobId) + ".");
+      return;
+   }
+
+   if (job->output->status() == JobStatus::Running)
+   {
+      // The console reports the job when it stops.
+      job->cancellation.cancel();
+      return;
+   }
+
+   m_jobs->removeJob(job->id);
+}
+
+} // namespace ccon
@@ -0,0 +1,70 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd.h"
+#include "cmd_spec.h"
+#include "static_cmd_spec.h"
+#include <string_view>
+
+namespace ccon
+{
+class JobTable;
+}
+
+
+namespace ccon
+{
+///////////////////
+
+namespace killCmd
+{
+
+inline constexpr std::string_view cmdName = "kill";
+
+inline constexpr StaticArgSpec argSpecs[] = {
+   {"", "", 1, "id of the job", ValueKind::Int},
+};
+
+inline constexpr StaticCmdSpec cmdSpec{cmdName, "",
+                                       "cancels a running job or discards a finished one",
+                                       argSpecs};
+
+} // namespace killCmd
+
+
+inline CmdSpec makeKillCmdSpec()
+{
+   return toCmdSpec(killCmd::cmdSpec);
+}
+
+
+///////////////////
+
+class KillCmd : public StreamingCmd
+{
+ public:
+   KillCmd() = default;
+   explicit KillCmd(JobTable* jobs);
+   ~KillCmd() = default;
+   KillCmd(const KillCmd&) = default;
+   KillCmd(KillCmd&&) = default;
+   KillCmd& operator=(const KillCmd&) = default;
+   KillCmd& operator=(KillCmd&&) = default;
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd& input, OutputSink& out) override;
+   // Changes the job table which the UI thread uses.
+   CmdThreadAffinity threadAffinity() const override
+   {
+      return CmdThreadAffinity::UIThread;
+   }
+
+ private:
+   JobTable* m_jobs = nullptr;
+};
+
+} // namespace ccon
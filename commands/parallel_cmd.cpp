@@ -0,0 +1,216 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "parallel_cmd.h"
+#include "cmd_parser.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+
+namespace
+{
+///////////////////
+
+// Output of executing the command for one value.
+struct ItemResult
+{
+   ccon::CmdOutput lines;
+   bool isFailed = false;
+};
+
+
+// Limits the threads that an execution starts to the number of hardware threads.
+// Allows at least as many threads as the console has workers, so that commands that
+// block still overlap on machines with few cores.
+std::size_t maxJobs()
+{
+   const std::size_t numHardwareThreads = std::thread::hardware_concurrency();
+   return std::max(numHardwareThreads, ccon::ThreadPool::defaultThreadCount());
+}
+
+
+// Executes a command for a single value. Makes a new instance of the command unless
+// one is given. Captures failures in the output instead of throwing.
+ItemResult executeItem(const ccon::CmdDepot& cmds, const ccon::CmdSpec& spec,
+                       std::string_view value, std::unique_ptr<ccon::Cmd> cmd,
+                       const ccon::CancellationToken& cancellation)
+{
+   ItemResult result;
+
+   const ccon::CmdArgViews cmdPieces{spec.name(), value};
+   const ccon::CmdSpec::MatchView match = spec.match(cmdPieces);
+   if (!match.isMatching || !match.areArgsValid)
+   {
+      result.lines.emplace_back("Command syntax error.");
+      result.isFailed = true;
+      return result;
+   }
+
+   ccon::CollectingOutputSink out;
+   out.setCancellation(cancellation);
+   try
+   {
+      if (!cmd)
+         cmd = cmds.makeCommand(spec.nameId());
+      cmd->execute(ccon::toVerifiedCmd(match.matchedCmd), out);
+      out.setCancellation({});
+      out.flush();
+   }
+   catch (const ccon::CancelledError&)
+   {
+      // The whole execution is cancelled. Keep the partial output.
+   }
+   catch (const std::exception& ex)
+   {
+      out.setCancellation({});
+      out.writeLine(std::string{"Command failed. "} + ex.what());
+      result.isFailed = true;
+   }
+   catch (...)
+   {
+      out.setCancellation({});
+      out.writeLine("Command failed.");
+      result.isFailed = true;
+   }
+
+   result.lines = out.releaseLines();
+   return result;
+}
+
+
+// Collects the results of the executions as they finish.
+class ItemResults
+{
+ public:
+   explicit ItemResults(std::size_t numItems) : m_results(numItems), m_isDone(numItems) {}
+   ~ItemResults() = default;
+   ItemResults(const ItemResults&) = delete;
+   ItemResults(ItemResults&&) = delete;
+   ItemResults& operator=(const ItemResults&) = delete;
+   ItemResults& operator=(ItemResults&&) = delete;
+
+   void add(std::size_t itemIdx, ItemResult result)
+   {
+      {
+         std::scoped_lock lock{m_mutex};
+         m_results[itemIdx] = std::move(result);
+         m_isDone[itemIdx] = true;
+         m_finishOrder.push_back(itemIdx);
+      }
+      m_itemFinished.notify_one();
+   }
+
+   // Blocks until the n-th result in the given order is available. Returns the index
+   // of its item and the result.
+   std::pair<std::size_t, ItemResult> take(std::size_t n, bool isFinishOrder)
+   {
+      std::unique_lock lock{m_mutex};
+      m_itemFinished.wait(lock, [&]() -> bool {
+         return isFinishOrder ? m_finishOrder.size() > n : m_isDone[n];
+      });
+      const std::size_t itemIdx = isFinishOrder ? m_finishOrder[n] : n;
+      return {itemIdx, std::move(m_results[itemIdx])};
+   }
+
+ private:
+   std::mutex m_mutex;
+   std::condition_variable m_itemFinished;
+   std::vector<ItemResult> m_results;
+   std::vector<bool> m_isDone;
+   std::vector<std::size_t> m_finishOrder;
+};
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+ParallelCmd::ParallelCmd(std::shared_ptr<const CmdDepot> cmds) : m_cmds{std::move(cmds)}
+{
+}
+
+
+void ParallelCmd::execute(const VerifiedCmd& input, OutputSink& out)
+{
+   assert(input.name == parallelCmd::cmdName);
+
+   const Options opt = interpretArgs(input.args);
+
+   const CmdSpec* spec = m_cmds ? m_cmds->findCommand(opt.cmdName) : nullptr;
+   if (!spec)
+   {
+      out.writeLine("Command not found.");
+      return;
+   }
+   // Commands that access the UI cannot execute on the threads of the pool. The
+   // checked instance executes the first value.
+   std::unique_ptr<Cmd> probe = m_cmds->makeCommand(spec->nameId());
+   if (!probe || probe->threadAffinity() != CmdThreadAffinity::Any)
+   {
+      out.writeLine("Command cannot execute in parallel.");
+      return;
+   }
+
+   const std::size_t numItems = opt.values.size();
+   ItemResults results{numItems};
+   // Declared after the results, so that the executions finish before the results
+   // are destroyed when writing the output throws.
+   ThreadPool pool{std::min(opt.numJobs, numItems)};
+
+   for (std::size_t i = 0; i < numItems; ++i)
+   {
+      pool.submit(
+         [this, spec, &opt, &results, &probe, i, cancellation = out.cancellation()]() {
+            std::unique_ptr<Cmd> cmd = i == 0 ? std::move(probe) : nullptr;
+            results.add(i, executeItem(*m_cmds, *spec, opt.values[i], std::move(cmd),
+                                       cancellation));
+         });
+   }
+
+   std::size_t numFailed = 0;
+   for (std::size_t n = 0; n < numItems; ++n)
+   {
+      const auto [itemIdx, result] = results.take(n, opt.isUnordered);
+      if (result.isFailed)
+         ++numFailed;
+
+      const std::string prefix = opt.values[itemIdx] + ": ";
+      for (const std::string& line : result.lines)
+         out.writeLine(prefix + line);
+   }
+
+   if (numFailed > 0)
+      out.writeLine(std::to_string(numFailed) + " of " + std::to_string(numItems) +
+                    " executions failed.");
+}
+
+
+ParallelCmd::Options ParallelCmd::interpretArgs(const VerifiedArgs& args)
+{
+   assert(args.size() >= 2);
+
+   Options opt;
+   opt.cmdName = args[0].values[0];
+   opt.values = args[1].values;
+
+   const int numJobs = parseIntArg(args.begin(), args.end(), parallelCmd::jobsOption,
+                                   static_cast<int>(ThreadPool::defaultThreadCount()));
+   opt.numJobs = std::min(static_cast<std::size_t>(std::max(numJobs, 1)), maxJobs());
+   opt.isUnordered =
+      haveArgWithLabel(args.begin(), args.end(), parallelCmd::unorderedOption);
+
+   return opt;
+}
+
+} // namespace ccon
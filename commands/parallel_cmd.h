@@ -0,0 +1,90 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd.h"
+#include "cmd_depot.h"
+#include "cmd_spec.h"
+#include "static_cmd_spec.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+namespace parallelCmd
+{
+
+inline constexpr std::string_view cmdName = ":parallel";
+inline constexpr std::string_view jobsOption = "jobs";
+inline constexpr std::string_view unorderedOption = "unordered";
+
+inline constexpr StaticArgSpec argSpecs[] = {
+   {"", "", 1, "name of the command to execute"},
+   {"", "", ArgSpec::OneOrMore, "values to execute the command with, one execution each"},
+   {jobsOption, "j", 1,
+    "maximal number of concurrent executions, limited to the hardware threads",
+    ValueKind::Int},
+   {unorderedOption, "u", 0, "output results as executions finish, not in value order"},
+};
+
+inline constexpr StaticCmdSpec cmdSpec{
+   cmdName, ":p", "executes a command concurrently for each of a list of values",
+   argSpecs,
+   "Output lines are prefixed with the value of their execution. Failed executions "
+   "do not stop the others."};
+
+} // namespace parallelCmd
+
+
+inline CmdSpec makeParallelCmdSpec()
+{
+   return toCmdSpec(parallelCmd::cmdSpec);
+}
+
+
+///////////////////
+
+// Executes a command once for each of a list of values on a pool of threads that
+// belongs to the execution. The output of each execution is merged into the own
+// output once the execution finishes.
+class ParallelCmd : public StreamingCmd
+{
+ public:
+   ParallelCmd() = default;
+   // Executes the commands of a depot that does not change, so that the console can
+   // change its own depot while the command executes on a worker thread.
+   explicit ParallelCmd(std::shared_ptr<const CmdDepot> cmds);
+   ~ParallelCmd() = default;
+   ParallelCmd(const ParallelCmd&) = default;
+   ParallelCmd(ParallelCmd&&) = default;
+   ParallelCmd& operator=(const ParallelCmd&) = default;
+   ParallelCmd& operator=(ParallelCmd&&) = default;
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd& input, OutputSink& out) override;
+
+ private:
+   struct Options
+   {
+      std::string cmdName;
+      std::vector<std::string> values;
+      std::size_t numJobs = 0;
+      bool isUnordered = false;
+   };
+
+   static Options interpretArgs(const VerifiedArgs& args);
+
+ private:
+   std::shared_ptr<const CmdDepot> m_cmds;
+};
+
+} // namespace ccon
@@ -0,0 +1,153 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "source_cmd.h"
+#include "cmd_parser.h"
+#include "script_parser.h"
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+
+namespace
+{
+///////////////////
+
+using Clock = std::chrono::steady_clock;
+
+// Time that a step may take, so that the UI can display the output at the rate of
+// its frames.
+constexpr std::chrono::milliseconds FrameDuration{16};
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+SourceCmd::SourceCmd() : m_cmds{std::make_shared<const CmdDepot>()}
+{
+}
+
+
+SourceCmd::SourceCmd(std::shared_ptr<const CmdDepot> cmds, ExecuteFn executeFn)
+: m_cmds{std::move(cmds)}, m_executeFn{std::move(executeFn)}
+{
+}
+
+
+SourceCmd::~SourceCmd()
+{
+   // The script was cancelled or failed.
+   if (m_executingJob)
+      m_executingJob->cancellation.cancel();
+}
+
+
+CmdStep SourceCmd::start(const VerifiedCmd& input, OutputSink& out)
+{
+   assert(input.name == sourceCmd::cmdName);
+
+   const std::filesystem::path path =
+      argValue<std::filesystem::path>(input.args[0]).value_or(std::filesystem::path{});
+   auto script = std::make_unique<std::ifstream>(path);
+   if (!script->is_open())
+   {
+      out.writeLine("Cannot open script '" + path.string() + "'.");
+      return CmdStep::Done;
+   }
+
+   m_parser = std::make_unique<ScriptParser>(std::move(script), m_cmds,
+                                             [this]() { wakeUp(); });
+   return resume(out);
+}
+
+
+CmdStep SourceCmd::resume(OutputSink& out)
+{
+   assert(m_parser);
+
+   const Clock::time_point frameEnd = Clock::now() + FrameDuration;
+   do
+   {
+      // The output and the end of the job resume the step.
+      if (m_executingJob && !displayJobOutput(out, frameEnd))
+         return CmdStep::Wait;
+
+      if (m_nextLineIdx == m_lines.size())
+      {
+         // Check before taking the lines. Lines that are verified after taking
+         // them would be missed otherwise.
+         const bool isParsed = m_parser->isParsed();
+         m_lines = m_parser->takeLines();
+         m_nextLineIdx = 0;
+         // The parser wakes the command when further lines are verified.
+         if (m_lines.empty())
+            return isParsed ? CmdStep::Done : CmdStep::Wait;
+      }
+
+      executeLine(m_lines[m_nextLineIdx++], out);
+   } while (Clock::now() < frameEnd);
+
+   return CmdStep::Continue;
+}
+
+
+void SourceCmd::awaitProgress(const CancellationToken& cancellation)
+{
+   assert(m_parser);
+
+   if (m_executingJob)
+      m_executingJob->output->waitForOutput(cancellation);
+   else if (m_nextLineIdx == m_lines.size())
+      m_parser->waitForLines(cancellation);
+   // Otherwise the last step ran out of time while lines were ready.
+}
+
+
+void SourceCmd::executeLine(ScriptLine& line, OutputSink& out)
+{
+   // Lines execute one after the other. Starting a job that outlives its line
+   // would break the order.
+   if (line.isBackground)
+      out.writeLine("Line " + std::to_string(line.lineNum) +
+                    ": Background jobs are not supported in scripts.");
+   else if (!line.isMatching)
+      out.writeLine("Line " + std::to_string(line.lineNum) + ": Command not found.");
+   else if (!line.areArgsValid)
+      out.writeLine("Line " + std::to_string(line.lineNum) + ": Command syntax error.");
+   else if (m_executeFn)
+      m_executingJob = m_executeFn(std::move(line.cmd), out);
+}
+
+
+bool SourceCmd::displayJobOutput(OutputSink& out, Clock::time_point until)
+{
+   assert(m_executingJob);
+
+   // Most lines finish quickly. Wait for them within the step instead of ending it
+   // for each line that executes on a worker.
+   while (true)
+   {
+      const JobOutputBatch batch = m_executingJob->output->takeBatch();
+      writeJobOutput(batch, out);
+      if (batch.isFinal)
+      {
+         m_executingJob.reset();
+         return true;
+      }
+
+      if (out.isCancelled() || Clock::now() >= until)
+         return false;
+      m_executingJob->output->waitForOutput(out.cancellation(), until);
+   }
+}
+
+} // namespace ccon
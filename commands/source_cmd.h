@@ -0,0 +1,107 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd.h"
+#include "cmd_depot.h"
+#include "cmd_spec.h"
+#include "interactive_cmd.h"
+#include "jobs.h"
+#include "static_cmd_spec.h"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace ccon
+{
+class ScriptParser;
+struct ScriptLine;
+} // namespace ccon
+
+
+namespace ccon
+{
+///////////////////
+
+namespace sourceCmd
+{
+
+inline constexpr std::string_view cmdName = ":source";
+
+inline constexpr StaticArgSpec argSpecs[] = {
+   {"", "", 1, "path of the script", ValueKind::Path},
+};
+
+inline constexpr StaticCmdSpec cmdSpec{
+   cmdName, "", "executes the command lines of a script", argSpecs,
+   "Empty lines and lines starting with '#' are skipped. "
+   "Lines that fail do not stop the script. "
+   "Lines execute one after the other, so lines ending in '&' are rejected. "
+   "Commands that don't access the UI execute on workers to keep the UI responsive. "
+   "Commands that access the UI block it while they execute."};
+
+} // namespace sourceCmd
+
+
+inline CmdSpec makeSourceCmdSpec()
+{
+   return toCmdSpec(sourceCmd::cmdSpec);
+}
+
+
+///////////////////
+
+// Executes a script in steps. Each step executes lines until the time of a frame is
+// used up, so that the UI can display the output between steps. The lines are
+// verified ahead of their execution on another thread. A line whose command
+// executes on a worker thread has to finish before the next line executes. The
+// steps display its output meanwhile. Steps that wait for the verified lines or
+// for a line that executes longer than the frame are resumed by their progress.
+class SourceCmd : public InteractiveCmd
+{
+ public:
+   // Executes a verified command. Returns the job of a command that continues to
+   // execute on a worker thread.
+   using ExecuteFn = std::function<std::optional<Job>(VerifiedCmd cmd, OutputSink& out)>;
+
+ public:
+   SourceCmd();
+   // The lines of scripts are matched against the given depot on the thread that
+   // verifies the lines. The depot must not change.
+   SourceCmd(std::shared_ptr<const CmdDepot> cmds, ExecuteFn executeFn);
+   ~SourceCmd();
+   SourceCmd(const SourceCmd&) = delete;
+   SourceCmd(SourceCmd&&) = delete;
+   SourceCmd& operator=(const SourceCmd&) = delete;
+   SourceCmd& operator=(SourceCmd&&) = delete;
+
+   CmdStep start(const VerifiedCmd& input, OutputSink& out) override;
+   CmdStep resume(OutputSink& out) override;
+   // Waits for the output of the executing job or for the next verified lines.
+   void awaitProgress(const CancellationToken& cancellation) override;
+
+ private:
+   void executeLine(ScriptLine& line, OutputSink& out);
+   // Writes the output of the executing job until it finished or a given time is
+   // reached. Returns whether the job finished.
+   bool displayJobOutput(OutputSink& out, std::chrono::steady_clock::time_point until);
+
+ private:
+   std::shared_ptr<const CmdDepot> m_cmds;
+   ExecuteFn m_executeFn;
+   std::unique_ptr<ScriptParser> m_parser;
+   // Verified lines that wait for their execution.
+   std::vector<ScriptLine> m_lines;
+   std::size_t m_nextLineIdx = 0;
+   // Job of the line that executes on a worker thread.
+   std::optional<Job> m_executingJob;
+};
+
+} // namespace ccon
@@ -0,0 +1,197 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "completion_index.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+
+namespace
+{
+///////////////////
+
+// Smallest number of added entries that gets merged into the main table.
+constexpr std::size_t MinMergeSize = 64;
+
+
+bool startsWith(std::string_view text, std::string_view prefix)
+{
+   return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+
+// Narrows a range of sorted entries down to the entries whose keys start with a
+// given prefix.
+template <typename Entry>
+ccon::CompletionIndex::Range findPrefixRange(const std::vector<Entry>& entries,
+                                             ccon::CompletionIndex::Range range,
+                                             std::string_view prefix)
+{
+   const auto first = entries.begin() + range.first;
+   const auto last = entries.begin() + range.last;
+
+   const auto prefixFirst = std::partition_point(
+      first, last, [prefix](const Entry& entry) { return entry.key < prefix; });
+   // Keys that are not less than the prefix start with the prefix up to the first
+   // key that is greater.
+   const auto prefixLast =
+      std::partition_point(prefixFirst, last, [prefix](const Entry& entry) {
+         return startsWith(entry.key, prefix);
+      });
+
+   return {static_cast<std::size_t>(prefixFirst - entries.begin()),
+           static_cast<std::size_t>(prefixLast - entries.begin())};
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+void CompletionIndex::add(std::string key)
+{
+   add(std::move(key), {});
+}
+
+
+void CompletionIndex::add(std::string key, std::string completion)
+{
+   if (completion == key)
+      completion.clear();
+   if (completion.empty())
+      m_fuzzyKeys.add(key);
+
+   const auto pos = std::upper_bound(
+      m_addedEntries.begin(), m_addedEntries.end(), key,
+      [](const std::string& value, const Entry& entry) { return value < entry.key; });
+   m_addedEntries.insert(pos, {std::move(key), std::move(completion)});
+
+   const auto maxAdded = static_cast<std::size_t>(std::sqrt(m_entries.size()));
+   if (m_addedEntries.size() > std::max(MinMergeSize, maxAdded))
+      mergeAddedEntries();
+}
+
+
+CompletionIndex::Matches CompletionIndex::match(std::string_view pattern,
+                                                CompletionMode mode) const
+{
+   Matches matches;
+   matches.pattern = pattern;
+   matches.mode = mode;
+
+   if (mode == CompletionMode::Fuzzy)
+   {
+      matches.fuzzyMatches = m_fuzzyKeys.match(pattern);
+   }
+   else
+   {
+      matches.mainRange = findPrefixRange(m_entries, {0, m_entries.size()}, pattern);
+      matches.addedRange =
+         findPrefixRange(m_addedEntries, {0, m_addedEntries.size()}, pattern);
+   }
+
+   return matches;
+}
+
+
+void CompletionIndex::narrow(Matches& matches, std::string_view pattern) const
+{
+   assert(startsWith(pattern, matches.pattern) &&
+          "Matches can only be narrowed down to patterns that extend their pattern.");
+   matches.pattern = pattern;
+
+   // The entries for an extended prefix lie within the ranges of the prefix.
+   if (matches.mode == CompletionMode::Fuzzy)
+   {
+      m_fuzzyKeys.narrow(matches.fuzzyMatches, pattern);
+   }
+   else
+   {
+      matches.mainRange = findPrefixRange(m_entries, matches.mainRange, pattern);
+      matches.addedRange = findPrefixRange(m_addedEntries, matches.addedRange, pattern);
+   }
+}
+
+
+std::vector<std::string> CompletionIndex::completions(const Matches& matches,
+                                                      std::size_t maxResults) const
+{
+   if (matches.mode == CompletionMode::Fuzzy)
+      return m_fuzzyKeys.best(matches.fuzzyMatches, maxResults);
+
+   std::vector<std::string> completions;
+   completions.reserve((matches.mainRange.last - matches.mainRange.first) +
+                       (matches.addedRange.last - matches.addedRange.first));
+   bool hasAliases = false;
+
+   // Merges the entries of both tables.
+   auto mainPos = m_entries.begin() + matches.mainRange.first;
+   const auto mainEnd = m_entries.begin() + matches.mainRange.last;
+   auto addedPos = m_addedEntries.begin() + matches.addedRange.first;
+   const auto addedEnd = m_addedEntries.begin() + matches.addedRange.last;
+   while (mainPos != mainEnd || addedPos != addedEnd)
+   {
+      const bool isMainNext =
+         addedPos == addedEnd || (mainPos != mainEnd && mainPos->key <= addedPos->key);
+      const Entry& entry = isMainNext ? *mainPos++ : *addedPos++;
+      hasAliases = hasAliases || !entry.completion.empty();
+      completions.push_back(entry.completion.empty() ? entry.key : entry.completion);
+   }
+
+   // Keys that complete to themselves are sorted already. Completions of other keys
+   // can be out of order or the same, e.g. for a name and its abbreviation.
+   if (hasAliases)
+   {
+      std::sort(completions.begin(), completions.end());
+      completions.erase(std::unique(completions.begin(), completions.end()),
+                        completions.end());
+   }
+   if (completions.size() > maxResults)
+      completions.resize(maxResults);
+   return completions;
+}
+
+
+std::vector<std::string> CompletionIndex::find(std::string_view prefix) const
+{
+   return completions(match(prefix, CompletionMode::Prefix),
+                      std::numeric_limits<std::size_t>::max());
+}
+
+
+std::vector<std::string> CompletionIndex::findFuzzy(std::string_view pattern,
+                                                    std::size_t maxResults) const
+{
+   return completions(match(pattern, CompletionMode::Fuzzy), maxResults);
+}
+
+
+void CompletionIndex::clear()
+{
+   m_entries.clear();
+   m_addedEntries.clear();
+   m_fuzzyKeys.clear();
+}
+
+
+void CompletionIndex::mergeAddedEntries()
+{
+   const auto byKey = [](const Entry& a, const Entry& b) { return a.key < b.key; };
+   const auto numSorted = static_cast<std::ptrdiff_t>(m_entries.size());
+   m_entries.insert(m_entries.end(), std::make_move_iterator(m_addedEntries.begin()),
+                    std::make_move_iterator(m_addedEntries.end()));
+   std::inplace_merge(m_entries.begin(), m_entries.begin() + numSorted, m_entries.end(),
+                      byKey);
+   m_addedEntries.clear();
+}
+
+} // namespace ccon
@@ -0,0 +1,111 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "fuzzy_index.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+enum class CompletionMode
+{
+   // Completions start with the input.
+   Prefix,
+   // Completions contain the characters of the input in the same order. They are
+   // ordered by how well they match, best match first.
+   Fuzzy
+};
+
+
+// Completion keys that are kept sorted, so that the keys with a given prefix can
+// be found with a binary search. Looking up a prefix costs O(prefix * log(n) +
+// results) instead of a scan over all keys.
+// The keys are stored in a flat table that is cheap to scan. Keys that are added
+// later go into a small sorted table first, which is merged into the main table
+// once it grows beyond the square root of its size. That keeps adding keys one by
+// one at amortized O(sqrt(n)).
+class CompletionIndex
+{
+ public:
+   // Range of entries in one of the tables.
+   struct Range
+   {
+      std::size_t first = 0;
+      std::size_t last = 0;
+   };
+
+   // Keys that match a pattern. Refers to the index and gets invalid when keys are
+   // added to the index or it is cleared.
+   struct Matches
+   {
+      std::string pattern;
+      CompletionMode mode = CompletionMode::Prefix;
+      // Ranges of matching entries for prefix completion. Keys with the same prefix
+      // are next to each other.
+      Range mainRange;
+      Range addedRange;
+      // Matching keys for fuzzy completion.
+      std::vector<FuzzyMatch> fuzzyMatches;
+   };
+
+ public:
+   CompletionIndex() = default;
+   ~CompletionIndex() = default;
+   CompletionIndex(const CompletionIndex&) = default;
+   CompletionIndex(CompletionIndex&&) = default;
+   CompletionIndex& operator=(const CompletionIndex&) = default;
+   CompletionIndex& operator=(CompletionIndex&&) = default;
+
+   // Adds a key that completes to itself.
+   void add(std::string key);
+   // Adds a key that completes to a different text, e.g. an abbreviation that
+   // completes to the full name.
+   void add(std::string key, std::string completion);
+   // Fuzzy matching only considers keys that complete to themselves (see
+   // FuzzyIndex).
+   Matches match(std::string_view pattern, CompletionMode mode) const;
+   // Narrows matches down to a pattern that starts with their pattern. Only the
+   // matches get searched instead of the whole index.
+   void narrow(Matches& matches, std::string_view pattern) const;
+   // Returns the completions of up to a given number of matches. Completions of
+   // prefix matches are sorted alphabetically, those of fuzzy matches best match
+   // first. They contain no duplicates.
+   std::vector<std::string> completions(const Matches& matches,
+                                        std::size_t maxResults) const;
+   // Returns the completions of the keys that start with a given prefix.
+   std::vector<std::string> find(std::string_view prefix) const;
+   // Returns up to a given number of keys that fuzzily match a pattern.
+   std::vector<std::string> findFuzzy(std::string_view pattern,
+                                      std::size_t maxResults) const;
+   std::size_t size() const { return m_entries.size() + m_addedEntries.size(); }
+   bool empty() const { return size() == 0; }
+   void clear();
+
+ private:
+   struct Entry
+   {
+      std::string key;
+      // Empty if the key completes to itself.
+      std::string completion;
+   };
+
+   void mergeAddedEntries();
+
+ private:
+   // Entries sorted by their keys.
+   std::vector<Entry> m_entries;
+   // Entries that were added since the last merge. Sorted by their keys.
+   std::vector<Entry> m_addedEntries;
+   FuzzyIndex m_fuzzyKeys;
+};
+
+} // namespace ccon
@@ -0,0 +1,128 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+
+namespace ccon
+{
+///////////////////
+
+// Lock-free queue for passing items from any number of producer threads to a
+// single consumer thread.
+// Producers push items onto a linked stack with a single atomic exchange loop. The
+// consumer takes the whole stack at once and processes it in the order in which
+// the items were pushed.
+template <typename T> class ConcurrentQueue
+{
+ public:
+   ConcurrentQueue() = default;
+   ~ConcurrentQueue();
+   ConcurrentQueue(const ConcurrentQueue&) = delete;
+   ConcurrentQueue(ConcurrentQueue&&) = delete;
+   ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+   ConcurrentQueue& operator=(ConcurrentQueue&&) = delete;
+
+   // Can be called from any thread.
+   void push(T item);
+   // Passes all queued items to a given function in the order they were pushed.
+   // Returns the number of processed items. Must only be called from the consumer
+   // thread.
+   template <typename Fn> std::size_t drain(Fn processItem);
+   bool empty() const { return m_head.load(std::memory_order_acquire) == nullptr; }
+
+ private:
+   struct Node
+   {
+      T item;
+      Node* next = nullptr;
+   };
+
+   static Node* reverse(Node* list);
+   static void destroy(Node* list);
+
+ private:
+   std::atomic<Node*> m_head = nullptr;
+};
+
+
+template <typename T> ConcurrentQueue<T>::~ConcurrentQueue()
+{
+   destroy(m_head.load(std::memory_order_acquire));
+}
+
+
+template <typename T> void ConcurrentQueue<T>::push(T item)
+{
+   Node* node = new Node{std::move(item), m_head.load(std::memory_order_relaxed)};
+   while (!m_head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                        std::memory_order_relaxed))
+   {
+   }
+}
+
+
+template <typename T>
+template <typename Fn>
+std::size_t ConcurrentQueue<T>::drain(Fn processItem)
+{
+   // Take all pushed items at once. They are linked in reverse order.
+   Node* list = reverse(m_head.exchange(nullptr, std::memory_order_acquire));
+
+   std::size_t numItems = 0;
+   while (list)
+   {
+      Node* node = list;
+      list = list->next;
+
+      T item = std::move(node->item);
+      delete node;
+
+      ++numItems;
+      try
+      {
+         processItem(std::move(item));
+      }
+      catch (...)
+      {
+         // The remaining items are dropped.
+         destroy(list);
+         throw;
+      }
+   }
+   return numItems;
+}
+
+
+template <typename T>
+typename ConcurrentQueue<T>::Node* ConcurrentQueue<T>::reverse(Node* list)
+{
+   Node* reversed = nullptr;
+   while (list)
+   {
+      Node* next = list->next;
+      list->next = reversed;
+      reversed = list;
+      list = next;
+   }
+   return reversed;
+}
+
+
+template <typename T> void ConcurrentQueue<T>::destroy(Node* list)
+{
+   while (list)
+   {
+      Node* next = list->next;
+      delete list;
+      list = next;
+   }
+}
+
+} // namespace ccon
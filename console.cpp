@@ -5,34 +5,144 @@
 // MIT license
 //
 #include "console.h"
+#include "cmd_binding.h"
 #include "cmd_parser.h"
 #include "commands/colors_cmd.h"
 #include "commands/exit_cmd.h"
 #include "commands/font_size_cmd.h"
+#include "commands/fg_cmd.h"
 #include "commands/help_cmd.h"
+#include "commands/jobs_cmd.h"
+#include "commands/kill_cmd.h"
+#include "commands/parallel_cmd.h"
+#include "commands/source_cmd.h"
 #include "console_ui.h"
-#include "essentutils/string_util.h"
+#include "console_util.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <exception>
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <utility>
 
 
 namespace
 {
 ///////////////////
 
-ccon::CmdOutput splitAtNewlines(const ccon::CmdOutput& src)
+// Extracts the common timeout argument from the arguments of a command, so that
+// commands don't see it. Returns nothing if the argument was not given.
+std::optional<std::chrono::milliseconds> extractTimeoutArg(ccon::VerifiedArgs& args)
 {
-   ccon::CmdOutput out;
-   for (const std::string& line : src)
+   // Arguments of the command's own specs with the same label are left alone.
+   const auto timeoutArg =
+      std::find_if(begin(args), end(args), [](const ccon::VerifiedArg& arg) {
+         return arg.specIdx == ccon::NoArgSpecIdx &&
+                arg.labelId == ccon::TimeoutArgSpec.labelId();
+      });
+   if (timeoutArg == end(args))
+      return std::nullopt;
+
+   const int timeoutMs = ccon::argValue<int>(*timeoutArg).value_or(0);
+   args.erase(timeoutArg);
+   return std::chrono::milliseconds{timeoutMs};
+}
+
+
+const char* describeCancellation(ccon::CancelReason reason)
+{
+   return reason == ccon::CancelReason::TimedOut ? "Command timed out."
+                                                 : "Command cancelled.";
+}
+
+
+// Executes a step of a command and reports failures and cancellations as output.
+// Failed and cancelled steps end the command.
+template <typename StepFn>
+ccon::CmdStep runCommandStep(ccon::OutputSink& out, StepFn executeStep)
+{
+   ccon::CmdStep step = ccon::CmdStep::Done;
+   std::string failure;
+   try
+   {
+      step = executeStep();
+   }
+   catch (const ccon::CancelledError&)
+   {
+      // Reported below.
+   }
+   catch (const std::exception& ex)
+   {
+      failure = std::string{"Command failed. "} + ex.what();
+   }
+   catch (...)
+   {
+      failure = "Command failed.";
+   }
+
+   // Commands might also stop cooperatively without throwing.
+   const ccon::CancelReason cancelReason = out.cancellation().reason();
+   // Keep the partial output of cancelled commands and allow reporting to the sink.
+   out.setCancellation({});
+   out.flush();
+
+   if (cancelReason != ccon::CancelReason::None)
+   {
+      out.writeLine(describeCancellation(cancelReason));
+      return ccon::CmdStep::Done;
+   }
+   if (!failure.empty())
    {
-      const std::vector<std::string> pieces = sutil::split(line, "\n");
-      std::copy(pieces.begin(), pieces.end(), std::back_inserter(out));
+      out.writeLine(failure);
+      return ccon::CmdStep::Done;
    }
+   return step;
+}
 
-   return out;
+
+// Executes a command and reports failures and cancellations as output. Returns
+// whether the command completed.
+bool runCommand(ccon::Cmd& cmd, const ccon::VerifiedCmd& input, ccon::OutputSink& out)
+{
+   bool isCompleted = false;
+   runCommandStep(out, [&]() {
+      cmd.execute(input, out);
+      isCompleted = !out.isCancelled();
+      return ccon::CmdStep::Done;
+   });
+   return isCompleted;
 }
 
+
+// Passes the output of a command on to another sink and keeps a copy of it.
+class RecordingOutputSink : public ccon::OutputSink
+{
+ public:
+   explicit RecordingOutputSink(ccon::OutputSink& out) : m_out{out} {}
+   ~RecordingOutputSink() = default;
+   RecordingOutputSink(const RecordingOutputSink&) = delete;
+   RecordingOutputSink(RecordingOutputSink&&) = delete;
+   RecordingOutputSink& operator=(const RecordingOutputSink&) = delete;
+   RecordingOutputSink& operator=(RecordingOutputSink&&) = delete;
+
+   ccon::CmdOutput releaseLines() { return std::move(m_lines); }
+
+ protected:
+   void consumeLine(std::string_view line) override
+   {
+      m_lines.emplace_back(line);
+      m_out.writeLine(line);
+   }
+
+ private:
+   ccon::OutputSink& m_out;
+   ccon::CmdOutput m_lines;
+};
+
 } // namespace
 
 
@@ -40,6 +150,51 @@ namespace ccon
 {
 ///////////////////
 
+// Passes the output of a command that executes on a worker thread to the UI
+// thread through the output buffer of the command's job.
+class Console::AsyncOutputSink : public OutputSink
+{
+ public:
+   AsyncOutputSink(Console& console, std::shared_ptr<JobOutput> output,
+                   CancellationToken jobCancellation)
+   : m_console{console}, m_output{std::move(output)},
+     m_jobCancellation{std::move(jobCancellation)}
+   {
+   }
+   ~AsyncOutputSink() = default;
+   AsyncOutputSink(const AsyncOutputSink&) = delete;
+   AsyncOutputSink(AsyncOutputSink&&) = delete;
+   AsyncOutputSink& operator=(const AsyncOutputSink&) = delete;
+   AsyncOutputSink& operator=(AsyncOutputSink&&) = delete;
+
+   // Marks the end of the command's output.
+   void finish(JobStatus status)
+   {
+      flush();
+      m_output->finish(status);
+      m_console.notifyPendingOutput();
+   }
+
+ protected:
+   void consumeLine(std::string_view line) override
+   {
+      // The UI takes all buffered lines at once. Notify only when the first line
+      // of a batch arrives.
+      if (m_output->push(line, m_jobCancellation))
+         m_console.notifyPendingOutput();
+   }
+
+ private:
+   Console& m_console;
+   std::shared_ptr<JobOutput> m_output;
+   // The sink's own cancellation is replaced while the output gets recorded. Waiting
+   // for space in the buffer has to end when the job is cancelled regardless.
+   CancellationToken m_jobCancellation;
+};
+
+
+///////////////////
+
 Console::Console(ConsoleUI& ui, const std::string& prompt)
 : m_ui{ui}, m_blackboard{prompt}
 {
@@ -49,9 +204,133 @@ Console::Console(ConsoleUI& ui, const std::string& prompt)
 }
 
 
+Console::~Console()
+{
+   // Don't wait for long running commands when the workers get joined. This
+   // includes background jobs.
+   for (auto& [id, job] : m_jobs)
+      job.cancellation.cancel();
+   // Interactive commands cancel the commands that they started on the workers.
+   m_interactiveCmd.reset();
+}
+
+
 void Console::addCommand(const CmdSpec& spec, CmdFactoryFn factoryFn)
 {
-   m_cmds.addCommand(spec, factoryFn);
+   {
+      std::scoped_lock lock{m_cmdsSnapshotMutex};
+      m_cmds.addCommand(spec, factoryFn);
+      m_cmdsSnapshot.reset();
+   }
+   m_autoCompletion.addCmd(spec);
+}
+
+
+void Console::addCommand(const CmdSpec& spec, CmdFactoryFn factoryFn,
+                         CmdLifetime lifetime, std::size_t numInstances)
+{
+   {
+      std::scoped_lock lock{m_cmdsSnapshotMutex};
+      m_cmds.addCommand(spec, factoryFn, lifetime, numInstances);
+      m_cmdsSnapshot.reset();
+   }
+   m_autoCompletion.addCmd(spec);
+}
+
+
+void Console::addCommand(const BoundCmd& cmd)
+{
+   addCommand(cmd.spec, cmd.factory);
+}
+
+
+void Console::execute(std::string_view cmdLine, OutputSink& out)
+{
+   // Background jobs don't apply. Commands always execute synchronously.
+   cmdLine = stripBackgroundMarker(cmdLine);
+   if (cmdLine.empty())
+      return;
+
+   // Commands can execute other command lines while the console processes its
+   // input line. Use an arena of its own instead of the console's.
+   CmdArena arena;
+   const CmdArgViews cmdPieces = splitCmdLine(cmdLine, arena.resource());
+   const CmdSpec::MatchView cmdMatch = m_cmds.matchCommand(cmdPieces);
+   if (cmdMatch.isMatching && cmdMatch.areArgsValid)
+      executeInline(toVerifiedCmd(cmdMatch.matchedCmd), out);
+   else if (cmdMatch.isMatching && !cmdMatch.areArgsValid)
+      out.writeLine("Command syntax error.");
+   else
+      out.writeLine("Command not found.");
+}
+
+
+CmdOutput Console::execute(std::string_view cmdLine)
+{
+   CollectingOutputSink out;
+   execute(cmdLine, out);
+   return out.releaseLines();
+}
+
+
+void Console::execute(VerifiedCmd cmd, OutputSink& out)
+{
+   // Commands that were verified by a different console might not exist here.
+   if (!m_cmds.findCommand(cmd.nameId))
+   {
+      out.writeLine("Command not found.");
+      return;
+   }
+   executeInline(std::move(cmd), out);
+}
+
+
+CmdOutput Console::execute(VerifiedCmd cmd)
+{
+   CollectingOutputSink out;
+   execute(std::move(cmd), out);
+   return out.releaseLines();
+}
+
+
+std::optional<VerifiedCmd> Console::verifyCommand(std::string_view cmdLine) const
+{
+   cmdLine = stripBackgroundMarker(cmdLine);
+   if (cmdLine.empty())
+      return std::nullopt;
+
+   CmdArena arena;
+   const CmdArgViews cmdPieces = splitCmdLine(cmdLine, arena.resource());
+   const CmdSpec::MatchView cmdMatch = m_cmds.matchCommand(cmdPieces);
+   if (!cmdMatch.isMatching || !cmdMatch.areArgsValid)
+      return std::nullopt;
+   return toVerifiedCmd(cmdMatch.matchedCmd);
+}
+
+
+void Console::invalidateResults(const std::string& cmdName)
+{
+   if (const CmdSpec* spec = m_cmds.findCommand(cmdName))
+      m_results.invalidate(spec->nameId());
+}
+
+
+void Console::invalidateAllResults()
+{
+   m_results.invalidateAll();
+}
+
+
+void Console::setResultCacheLimits(std::size_t maxEntries,
+                                   std::optional<std::chrono::milliseconds> ttl)
+{
+   m_results.setLimits(maxEntries, ttl);
+}
+
+
+void Console::setAutoCompletionMode(CompletionMode mode)
+{
+   m_autoCompletion.setMode(mode);
 }
 
 
@@ -94,18 +373,38 @@ void Console::setInputLine(const std::string& text)
 
 void Console::processInputLine()
 {
+   // Display the output of earlier commands before the output of the new one.
+   processPendingOutput();
+
    m_blackboard.commitInputLine();
+   const std::string input = m_blackboard.enteredInputText();
+   // Start the next input line right away. Output is inserted before it, so that
+   // the input line stays editable while commands execute on worker threads.
+   m_blackboard.startNewInputLine();
 
-   const CmdOutput output = processRawInput(m_blackboard.enteredInputText());
-   for (const std::string& outLine : output)
-      m_blackboard.appendLine(outLine);
+   // Output of commands that execute synchronously and of errors goes directly to
+   // the blackboard.
+   BlackboardOutputSink out{m_blackboard};
+   if (isAwaitingInput())
+   {
+      // The input belongs to the interactive command.
+      stepInteractiveCmd([&input](InteractiveCmd& cmd, OutputSink& cmdOut) {
+         return cmd.resumeWithInput(input, cmdOut);
+      });
+   }
+   else
+   {
+      processRawInput(input, out);
+   }
+   out.flush();
+   // Free the transient objects of processing the input all at once.
+   m_arena.release();
 
    // Put empty line between output and next input line to create a visual
-   // break.
-   if (!output.empty())
-      m_blackboard.appendLine("\n");
+   // break. Interactive commands get the break once they finish.
+   if (out.countLines() > 0)
+      m_blackboard.insertOutputLine("\n");
 
-   m_blackboard.startNewInputLine();
    m_autoCompletion.reset();
 }
 
@@ -132,6 +431,65 @@ void Console::nextAutoCompletion()
 }
 
 
+void Console::processPendingOutput()
+{
+   // Reset before taking the output, so that output that arrives meanwhile notifies
+   // the UI again.
+   m_isOutputNotified = false;
+
+   for (auto pos = m_jobs.begin(); pos != m_jobs.end();)
+   {
+      Job& job = pos->second;
+      const bool canRemove =
+         job.isBackground ? reportBackgroundJob(job) : displayJobOutput(job);
+      pos = canRemove ? m_jobs.removeJob(pos) : std::next(pos);
+   }
+
+   resumeInteractiveCmd();
+}
+
+
+void Console::cancelCommands()
+{
+   // Commands that execute on the UI thread have finished by the time the UI can
+   // process user input. Background jobs have to be killed explicitly.
+   for (auto& [id, job] : m_jobs)
+      if (!job.isBackground)
+         job.cancellation.cancel();
+
+   // Interactive commands execute in steps on the UI thread. End them between
+   // steps.
+   if (m_interactiveCmd)
+   {
+      m_blackboard.insertOutputLine(describeCancellation(CancelReason::Cancelled));
+      m_blackboard.insertOutputLine("\n");
+      m_interactiveCmd.reset();
+   }
+}
+
+
+void Console::waitForCommands()
+{
+   // Check regularly for foreground jobs that wait for their output to be displayed.
+   constexpr std::chrono::milliseconds PollInterval{10};
+
+   while (!m_workers.waitUntilIdle(PollInterval))
+   {
+      displayFullJobOutputs();
+      // Interactive commands might wait for commands that they started on the
+      // workers.
+      resumeInteractiveCmd();
+   }
+   processPendingOutput();
+   while (isResumable())
+   {
+      if (m_interactiveCmd->step == CmdStep::Wait)
+         m_interactiveCmd->cmd->awaitProgress(m_interactiveCmd->cancellation.token());
+      processPendingOutput();
+   }
+}
+
+
 void Console::initCommands()
 {
    m_cmds.addCommand(makeConsoleColorsCmdSpec(),
@@ -143,43 +501,349 @@ void Console::initCommands()
    m_cmds.addCommand(makeHelpCmdSpec(), [this]() {
       return std::make_unique<HelpCmd>(m_cmds.availableCommands());
    });
+   m_cmds.addCommand(makeJobsCmdSpec(),
+                     [this]() { return std::make_unique<JobsCmd>(&m_jobs); });
+   m_cmds.addCommand(makeFgCmdSpec(),
+                     [this]() { return std::make_unique<FgCmd>(&m_jobs); });
+   m_cmds.addCommand(makeKillCmdSpec(),
+                     [this]() { return std::make_unique<KillCmd>(&m_jobs); });
+   m_cmds.addCommand(makeParallelCmdSpec(),
+                     [this]() { return std::make_unique<ParallelCmd>(cmdsSnapshot()); });
+   m_cmds.addCommand(makeSourceCmdSpec(), [this]() {
+      return std::make_unique<SourceCmd>(
+         cmdsSnapshot(),
+         [this](VerifiedCmd cmd, OutputSink& out) {
+            return executeScriptCmd(std::move(cmd), out);
+         });
+   });
 }
 
 
-CmdOutput Console::processRawInput(const std::string& rawInput) const
+void Console::processRawInput(const std::string& rawInput, OutputSink& out)
 {
+   const bool isBackground = hasBackgroundMarker(rawInput);
+   const std::string_view cmdLine = stripBackgroundMarker(rawInput);
+
    // No input. Output nothing.
-   if (rawInput.empty())
-      return {};
+   if (cmdLine.empty())
+      return;
+
+   // The words of the input and the matched arguments are allocated from the arena.
+   // Only the command's input is copied to the heap.
+   const CmdArgViews cmdPieces = splitCmdLine(cmdLine, m_arena.resource());
+   const CmdSpec::MatchView cmdMatch = m_cmds.matchCommand(cmdPieces);
+   if (cmdMatch.isMatching && cmdMatch.areArgsValid)
+      executeCommand(toVerifiedCmd(cmdMatch.matchedCmd), cmdLine, isBackground, out);
+   else if (cmdMatch.isMatching && !cmdMatch.areArgsValid)
+      out.writeLine("Command syntax error.");
+   else
+      out.writeLine("Command not found.");
+}
+
+
+void Console::executeCommand(VerifiedCmd cmdInput, std::string_view cmdLine,
+                             bool isBackground, OutputSink& out)
+{
+   std::optional<PreparedCmd> prepared = prepareCommand(cmdInput, out);
+   if (!prepared)
+      return;
 
-   CmdSpec::Match cmdMatch;
-   for (const CmdSpec& spec : m_cmds.availableCommands())
+   if (auto* interactiveCmd = dynamic_cast<InteractiveCmd*>(prepared->cmd.get()))
    {
-      cmdMatch = spec.match(rawInput);
-      if (cmdMatch.isMatching)
-         break;
+      // Only one command can receive the user's input.
+      if (m_interactiveCmd)
+      {
+         out.writeLine("Another interactive command is executing.");
+         return;
+      }
+
+      prepared->cmd.release();
+      startInteractiveCmd(std::unique_ptr<InteractiveCmd>{interactiveCmd}, cmdInput,
+                          std::move(prepared->cancellation));
+      return;
    }
 
-   if (cmdMatch.isMatching && cmdMatch.areArgsValid)
-      return executeCommand(cmdMatch.matchedCmd);
-   else if (cmdMatch.isMatching && !cmdMatch.areArgsValid)
-      return {"Command syntax error."};
-   return {"Command not found."};
+   // Commands with UI thread affinity execute synchronously even when they are
+   // started as background job.
+   if (prepared->cmd->threadAffinity() == CmdThreadAffinity::UIThread)
+   {
+      out.setCancellation(prepared->cancellation.token());
+      runCommand(*prepared->cmd, cmdInput, prepared->pendingResult, out);
+      out.setCancellation({});
+      return;
+   }
+
+   Job& job = m_jobs.addJob(std::string{cmdLine}, isBackground);
+   job.cancellation = std::move(prepared->cancellation);
+   if (isBackground)
+      out.writeLine(describeJob(job));
+
+   executeOnWorker(std::move(prepared->cmd), std::move(cmdInput),
+                   std::move(prepared->pendingResult), job);
+}
+
+
+void Console::executeInline(VerifiedCmd cmdInput, OutputSink& out)
+{
+   std::optional<PreparedCmd> prepared = prepareCommand(cmdInput, out);
+   if (prepared)
+      runPreparedInline(*prepared, cmdInput, out);
 }
 
 
-CmdOutput Console::executeCommand(const VerifiedCmd& cmdInput) const
+std::optional<Job> Console::executeScriptCmd(VerifiedCmd cmdInput, OutputSink& out)
+{
+   std::optional<PreparedCmd> prepared = prepareCommand(cmdInput, out);
+   if (!prepared)
+      return std::nullopt;
+
+   // Includes interactive commands.
+   if (prepared->cmd->threadAffinity() == CmdThreadAffinity::UIThread)
+   {
+      runPreparedInline(*prepared, cmdInput, out);
+      return std::nullopt;
+   }
+
+   // The script waits for the job before it executes its next line. Its output is
+   // never dropped.
+   Job job;
+   job.cancellation = std::move(prepared->cancellation);
+   job.output->setOverflow(JobOutputOverflow::Wait);
+   executeOnWorker(std::move(prepared->cmd), std::move(cmdInput),
+                   std::move(prepared->pendingResult), job);
+   return job;
+}
+
+
+void Console::runPreparedInline(PreparedCmd& prepared, const VerifiedCmd& cmdInput,
+                                OutputSink& out)
+{
+   // Commands without time limit are cancelled together with the caller.
+   const CancellationToken callerCancellation = out.cancellation();
+   if (prepared.hasTimeout)
+      out.setCancellation(prepared.cancellation.token());
+   // Interactive commands execute their steps in a row.
+   runCommand(*prepared.cmd, cmdInput, prepared.pendingResult, out);
+   out.setCancellation(callerCancellation);
+}
+
+
+std::optional<Console::PreparedCmd> Console::prepareCommand(VerifiedCmd& cmdInput,
+                                                             OutputSink& out)
 {
    if (containsHelpParameter(cmdInput.args))
-      return m_cmds.getCommandHelp(cmdInput.name);
+   {
+      for (const std::string& helpLine : m_cmds.getCommandHelp(cmdInput.name))
+         out.writeLine(helpLine);
+      return std::nullopt;
+   }
+
+   const CmdSpec* spec = m_cmds.findCommand(cmdInput.nameId);
+   PreparedCmd prepared;
+
+   // The timeout argument of the execution takes precedence over the timeout of
+   // the spec. Timeouts that are not positive disable the time limit.
+   std::optional<std::chrono::milliseconds> timeout = extractTimeoutArg(cmdInput.args);
+   if (!timeout.has_value() && spec)
+      timeout = spec->timeout();
+   if (timeout.has_value() && timeout->count() > 0)
+   {
+      prepared.cancellation.cancelAfter(*timeout);
+      prepared.hasTimeout = true;
+   }
+
+   // Pure commands output the result of an earlier execution with the same
+   // arguments without being instantiated.
+   if (spec && spec->isPure())
+   {
+      std::string key = makeResultKey(cmdInput);
+      if (const std::optional<CmdOutput> result = m_results.find(key))
+      {
+         for (const std::string& line : *result)
+            out.writeLine(line);
+         return std::nullopt;
+      }
+      prepared.pendingResult =
+         PendingResult{std::move(key), cmdInput.nameId, m_results.generation()};
+   }
+
+   prepared.cmd = m_cmds.makeCommand(cmdInput.nameId);
+   if (!prepared.cmd)
+   {
+      assert(false && "Command was already validated against a spec. We should be "
+                      "able to instantiate it!");
+      out.writeLine("Internal error. Failed to instantiate command.");
+      return std::nullopt;
+   }
+   return prepared;
+}
+
+
+void Console::executeOnWorker(std::unique_ptr<Cmd> cmd, VerifiedCmd cmdInput,
+                              std::optional<PendingResult> pendingResult, Job& job)
+{
+   // Tasks have to be copyable.
+   std::shared_ptr<Cmd> sharedCmd = std::move(cmd);
+
+   m_workers.submit([this, sharedCmd, input = std::move(cmdInput),
+                     result = std::move(pendingResult), output = job.output,
+                     token = job.cancellation.token()]() {
+      AsyncOutputSink out{*this, output, token};
+      out.setCancellation(token);
+      runCommand(*sharedCmd, input, result, out);
+      out.finish(toJobStatus(token.reason()));
+   });
+}
+
+
+void Console::runCommand(Cmd& cmd, const VerifiedCmd& input,
+                         const std::optional<PendingResult>& result, OutputSink& out)
+{
+   if (!result)
+   {
+      ::runCommand(cmd, input, out);
+      return;
+   }
+
+   // The recording sink observes the cancellation instead of the sink that it
+   // writes to. Otherwise reporting the cancellation would fail.
+   RecordingOutputSink recorder{out};
+   recorder.setCancellation(out.cancellation());
+   out.setCancellation({});
+
+   if (::runCommand(cmd, input, recorder))
+      m_results.insert(result->key, result->cmdNameId, recorder.releaseLines(),
+                       result->generation);
+}
+
+
+void Console::startInteractiveCmd(std::unique_ptr<InteractiveCmd> cmd,
+                                  const VerifiedCmd& cmdInput,
+                                  CancellationSource cancellation)
+{
+   // Waiting commands are resumed when the UI processes the pending output.
+   cmd->setWakeUpHandler([this]() { notifyPendingOutput(); });
+   m_interactiveCmd = InteractiveExecution{std::move(cmd), std::move(cancellation)};
+   stepInteractiveCmd([&cmdInput](InteractiveCmd& interactiveCmd, OutputSink& out) {
+      return interactiveCmd.start(cmdInput, out);
+   });
+}
+
 
-   auto cmd = m_cmds.makeCommand(cmdInput.name);
-   if (cmd)
-      return splitAtNewlines(cmd->execute(cmdInput));
+template <typename StepFn> void Console::stepInteractiveCmd(StepFn executeStep)
+{
+   assert(m_interactiveCmd);
+   InteractiveExecution& execution = *m_interactiveCmd;
+
+   BlackboardOutputSink out{m_blackboard};
+   out.setCancellation(execution.cancellation.token());
+   execution.step =
+      runCommandStep(out, [&]() { return executeStep(*execution.cmd, out); });
+   execution.numLines += out.countLines();
+
+   switch (execution.step)
+   {
+   case CmdStep::Continue:
+      // Schedule the next step after the UI processed its pending messages.
+      notifyPendingOutput();
+      return;
+   case CmdStep::Wait:
+      // The command wakes itself up or output of the commands that it started
+      // arrives.
+   case CmdStep::AwaitInput:
+      return;
+   case CmdStep::Done:
+      break;
+   }
 
-   assert(false && "Command was already validated against a spec. We should be able to "
-                   "instantiate it!");
-   return {"Internal error. Failed to instantiate command."};
+   // Put empty line between output and next input line to create a visual
+   // break.
+   if (execution.numLines > 0)
+      m_blackboard.insertOutputLine("\n");
+   m_interactiveCmd.reset();
+}
+
+
+void Console::resumeInteractiveCmd()
+{
+   if (isResumable())
+      stepInteractiveCmd(
+         [](InteractiveCmd& cmd, OutputSink& out) { return cmd.resume(out); });
+}
+
+
+bool Console::isResumable() const
+{
+   return m_interactiveCmd && (m_interactiveCmd->step == CmdStep::Continue ||
+                               m_interactiveCmd->step == CmdStep::Wait);
+}
+
+
+bool Console::isAwaitingInput() const
+{
+   return m_interactiveCmd && m_interactiveCmd->step == CmdStep::AwaitInput;
+}
+
+
+bool Console::displayJobOutput(Job& job)
+{
+   // Insert the output that arrived since the last time at once.
+   const JobOutputBatch batch = job.output->takeBatch();
+   BlackboardOutputSink out{m_blackboard};
+   writeJobOutput(batch, out);
+   job.numDisplayedLines += out.countLines();
+
+   // Put empty line between output and following lines to create a visual break.
+   if (batch.isFinal && job.numDisplayedLines > 0)
+      m_blackboard.insertOutputLine("\n");
+   return batch.isFinal;
+}
+
+
+void Console::displayFullJobOutputs()
+{
+   for (auto pos = m_jobs.begin(); pos != m_jobs.end();)
+   {
+      Job& job = pos->second;
+      const bool canRemove =
+         !job.isBackground && job.output->isFull() && displayJobOutput(job);
+      pos = canRemove ? m_jobs.removeJob(pos) : std::next(pos);
+   }
+}
+
+
+bool Console::reportBackgroundJob(Job& job)
+{
+   if (job.isFinishReported)
+      return false;
+
+   const JobStatus status = job.output->status();
+   if (status == JobStatus::Running)
+      return false;
+
+   m_blackboard.insertOutputLine(describeJob(job));
+   job.isFinishReported = true;
+
+   // Keep the output of the job until it is brought to the foreground. Jobs that
+   // were killed are discarded.
+   return status == JobStatus::Cancelled || !job.output->hasLines();
+}
+
+
+std::shared_ptr<const CmdDepot> Console::cmdsSnapshot()
+{
+   std::scoped_lock lock{m_cmdsSnapshotMutex};
+   if (!m_cmdsSnapshot)
+      m_cmdsSnapshot = std::make_shared<const CmdDepot>(m_cmds);
+   return m_cmdsSnapshot;
+}
+
+
+void Console::notifyPendingOutput()
+{
+   // Notify only once until the UI processes the output.
+   if (!m_isOutputNotified.exchange(true))
+      m_ui.notifyPendingOutput();
 }
 
 } // namespace ccon
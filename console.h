@@ -8,14 +8,26 @@
 #include "auto_completion.h"
 #include "blackboard.h"
 #include "cmd.h"
+#include "cmd_arena.h"
 #include "cmd_depot.h"
 #include "console_content.h"
+#include "interactive_cmd.h"
+#include "jobs.h"
+#include "result_cache.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace ccon
 {
+struct BoundCmd;
 struct ConsoleUI;
 }
 
@@ -33,13 +45,46 @@ class Console : public ConsoleContent
 {
 public:
    Console(ConsoleUI& ui, const std::string& prompt = DefaultPrompt);
-   ~Console() = default;
+   // Cancels the executing commands and waits for them to finish.
+   ~Console();
    Console(const Console&) = delete;
    Console(Console&&) = delete;
    Console& operator=(const Console&) = delete;
    Console& operator=(Console&&) = delete;
 
    void addCommand(const CmdSpec& spec, CmdFactoryFn factoryFn);
+   // Adds a command whose instances are reused (see CmdDepot::addCommand).
+   void addCommand(const CmdSpec& spec, CmdFactoryFn factoryFn, CmdLifetime lifetime,
+                   std::size_t numInstances = 1);
+   // Adds a command that is bound to a function (see bindCommand).
+   void addCommand(const BoundCmd& cmd);
+   // Executes a command line synchronously on the calling thread and writes the
+   // output to a given sink or returns it. The line is neither displayed nor added
+   // to the input history. Has to be called from the UI thread.
+   void execute(std::string_view cmdLine, OutputSink& out);
+   CmdOutput execute(std::string_view cmdLine);
+   // Executes a command that was verified with verifyCommand. Allows executing
+   // the same command repeatedly without parsing it each time.
+   void execute(VerifiedCmd cmd, OutputSink& out);
+   CmdOutput execute(VerifiedCmd cmd);
+   // Returns nothing if the line does not match a command or its arguments are
+   // invalid.
+   std::optional<VerifiedCmd> verifyCommand(std::string_view cmdLine) const;
+   // Pure commands (see CmdSpec::setPure) output the results of earlier executions
+   // with the same arguments. Their results have to be invalidated when the state
+   // that they depend on changes.
+   void invalidateResults(const std::string& cmdName);
+   void invalidateAllResults();
+   // Results are kept indefinitely if no time to live is given.
+   void setResultCacheLimits(std::size_t maxEntries,
+                             std::optional<std::chrono::milliseconds> ttl);
+   void setAutoCompletionMode(CompletionMode mode);
+   // Worker threads that execute the commands.
+   ThreadPool& workers() { return m_workers; }
+   // Threads for the lookups of argument value completions (see
+   // AsyncValueCompletionProvider). Separate from the workers of the commands, so
+   // that completions stay available while commands execute.
+   ThreadPool& completionWorkers() { return m_completionWorkers; }
    std::size_t countLines() const override;
    std::string lineText(std::size_t lineIdx) const override;
    bool isEnteredLine(std::size_t lineIdx) const override;
@@ -50,17 +95,112 @@ public:
    void goToPreviousInput() override;
    void goToNextInput() override;
    void nextAutoCompletion() override;
+   void processPendingOutput() override;
+   void cancelCommands() override;
+   // Blocks until all commands that execute on worker threads are finished and
+   // displays their output.
+   void waitForCommands();
+
+private:
+   class AsyncOutputSink;
+
+   // Completion lookups are debounced on their thread, so a few threads suffice.
+   static constexpr std::size_t NumCompletionWorkers = 2;
+
+   // Where to store the output of an execution of a pure command.
+   struct PendingResult
+   {
+      std::string key;
+      SymbolId cmdNameId = NoSymbol;
+      // Generation of the result cache when the execution started.
+      std::uint64_t generation = 0;
+   };
+
+   // Command that is ready to execute.
+   struct PreparedCmd
+   {
+      std::unique_ptr<Cmd> cmd;
+      CancellationSource cancellation;
+      bool hasTimeout = false;
+      std::optional<PendingResult> pendingResult;
+   };
+
+   // Interactive command that executes in steps on the UI thread.
+   struct InteractiveExecution
+   {
+      std::unique_ptr<InteractiveCmd> cmd;
+      CancellationSource cancellation;
+      CmdStep step = CmdStep::Done;
+      // Number of output lines of all steps so far.
+      std::size_t numLines = 0;
+   };
 
 private:
    void initCommands();
-   CmdOutput processRawInput(const std::string& rawInput) const;
-   CmdOutput executeCommand(const VerifiedCmd& cmdInput) const;
+   void processRawInput(const std::string& rawInput, OutputSink& out);
+   void executeCommand(VerifiedCmd cmdInput, std::string_view cmdLine, bool isBackground,
+                       OutputSink& out);
+   // Executes a command synchronously on the calling thread, independent of its
+   // thread affinity.
+   void executeInline(VerifiedCmd cmdInput, OutputSink& out);
+   // Executes a command of a script. Commands that can execute on a worker thread are
+   // started there and their job is returned. The job is not added to the job table,
+   // the script displays its output. Other commands execute synchronously.
+   std::optional<Job> executeScriptCmd(VerifiedCmd cmdInput, OutputSink& out);
+   void runPreparedInline(PreparedCmd& prepared, const VerifiedCmd& cmdInput,
+                          OutputSink& out);
+   // Handles the help argument, the timeout and the cached results of a command.
+   // Returns nothing if the command does not have to execute.
+   std::optional<PreparedCmd> prepareCommand(VerifiedCmd& cmdInput, OutputSink& out);
+   void executeOnWorker(std::unique_ptr<Cmd> cmd, VerifiedCmd cmdInput,
+                        std::optional<PendingResult> pendingResult, Job& job);
+   // Stores the output of completed executions of pure commands. Can be called from
+   // worker threads.
+   void runCommand(Cmd& cmd, const VerifiedCmd& input,
+                   const std::optional<PendingResult>& result, OutputSink& out);
+   void startInteractiveCmd(std::unique_ptr<InteractiveCmd> cmd,
+                            const VerifiedCmd& cmdInput, CancellationSource cancellation);
+   template <typename StepFn> void stepInteractiveCmd(StepFn executeStep);
+   // Executes the next step of an interactive command that returned Continue or
+   // Wait. Waiting commands check whether they can progress.
+   void resumeInteractiveCmd();
+   bool isResumable() const;
+   bool isAwaitingInput() const;
+   // Both return whether the job can be removed.
+   bool displayJobOutput(Job& job);
+   bool reportBackgroundJob(Job& job);
+   // Displays the output of foreground jobs whose buffer is full, so that the jobs
+   // can continue.
+   void displayFullJobOutputs();
+   void notifyPendingOutput();
+   // Returns an unchanging copy of the commands for commands that execute other
+   // commands on worker threads. Can be called from worker threads.
+   std::shared_ptr<const CmdDepot> cmdsSnapshot();
 
 private:
    ConsoleUI& m_ui;
    CmdDepot m_cmds;
+   // Guards the commands against changes while a snapshot is copied from them on a
+   // worker thread. Reads on the UI thread don't need the lock because only the UI
+   // thread changes the commands.
+   std::mutex m_cmdsSnapshotMutex;
+   // Copied on demand and dropped when commands are added, so that all executions
+   // share one copy until the commands change.
+   std::shared_ptr<const CmdDepot> m_cmdsSnapshot;
    Blackboard m_blackboard;
    AutoCompletion m_autoCompletion;
+   // Memory for processing a single input line.
+   CmdArena m_arena;
+   // Commands that execute on worker threads.
+   JobTable m_jobs;
+   std::optional<InteractiveExecution> m_interactiveCmd;
+   CmdResultCache m_results;
+   // Prevents notifying the UI again before it processed the pending output.
+   std::atomic<bool> m_isOutputNotified = false;
+   // Declared last, so that the executing commands and lookups finish before the
+   // members that they use are destroyed.
+   ThreadPool m_workers;
+   ThreadPool m_completionWorkers{NumCompletionWorkers};
 };
 
 } // namespace ccon
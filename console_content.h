@@ -39,6 +39,11 @@ struct ConsoleContent
    virtual void goToPreviousInput() = 0;
    virtual void goToNextInput() = 0;
    virtual void nextAutoCompletion() = 0;
+   // Displays the output of commands that execute on worker threads. Has to be
+   // called on the UI thread.
+   virtual void processPendingOutput() = 0;
+   // Cancels the commands that are executing, e.g. when the user presses Ctrl-C.
+   virtual void cancelCommands() = 0;
 };
 
 } // namespace ccon
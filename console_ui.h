@@ -34,6 +34,10 @@ struct ConsoleUI
    virtual void setInputTextColor(const sutil::Rgb& color) = 0;
    virtual void resetColors() = 0;
    virtual void setFontSize(int sizeInPoints) = 0;
+   // Called from any thread when commands that execute on worker threads have
+   // output pending. The UI should call ConsoleContent::processPendingOutput on its
+   // own thread in response.
+   virtual void notifyPendingOutput() = 0;
 };
 
 } // namespace ccon
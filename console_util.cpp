@@ -6,6 +6,24 @@
 //
 #include "console_util.h"
 #include "essentutils/string_util.h"
+#include <algorithm>
+#include <cctype>
+
+
+namespace
+{
+///////////////////
+
+constexpr char BackgroundMarker = '&';
+
+
+std::string_view trimRight(std::string_view s)
+{
+   const std::size_t end = s.find_last_not_of(" \t");
+   return end != std::string_view::npos ? s.substr(0, end + 1) : std::string_view{};
+}
+
+} // namespace
 
 
 namespace ccon
@@ -17,4 +35,81 @@ std::string stripArgSeparators(const std::string& s)
    return sutil::trimLeft(s, '-');
 }
 
+
+std::string_view stripArgSeparatorsView(std::string_view s)
+{
+   const std::size_t firstNonSep = s.find_first_not_of('-');
+   if (firstNonSep == std::string_view::npos)
+      return s.substr(s.size());
+   return s.substr(firstNonSep);
+}
+
+
+bool isArgLabel(std::string_view word)
+{
+   if (word.empty())
+      return false;
+
+   auto charIter = std::begin(word);
+   auto charEnd = std::end(word);
+   while (charIter != charEnd && *charIter == ' ')
+      ++charIter;
+
+   std::size_t numDashes = 0;
+   while (charIter != charEnd && *charIter == '-')
+   {
+      ++numDashes;
+      ++charIter;
+   }
+
+   return numDashes == 1 || numDashes == 2;
+}
+
+
+CmdArgViews splitCmdLine(std::string_view cmdLine, std::pmr::memory_resource* resource)
+{
+   // Same semantics as splitting with sutil::split at single spaces, i.e. consecutive
+   // spaces produce empty words.
+   CmdArgViews words{resource};
+   words.reserve(std::count(cmdLine.begin(), cmdLine.end(), ' ') + 1);
+
+   std::size_t pos = 0;
+   std::size_t next = cmdLine.find(' ', pos);
+   while (next != std::string_view::npos)
+   {
+      words.push_back(cmdLine.substr(pos, next - pos));
+      pos = next + 1;
+      next = cmdLine.find(' ', pos);
+   }
+   words.push_back(cmdLine.substr(pos));
+
+   return words;
+}
+
+
+bool hasBackgroundMarker(std::string_view cmdLine)
+{
+   cmdLine = trimRight(cmdLine);
+   return !cmdLine.empty() && cmdLine.back() == BackgroundMarker;
+}
+
+
+std::string_view stripBackgroundMarker(std::string_view cmdLine)
+{
+   cmdLine = trimRight(cmdLine);
+   if (!cmdLine.empty() && cmdLine.back() == BackgroundMarker)
+      cmdLine = trimRight(cmdLine.substr(0, cmdLine.size() - 1));
+   return cmdLine;
+}
+
+
+bool equalsLowercase(std::string_view s, std::string_view lowercase)
+{
+   if (s.size() != lowercase.size())
+      return false;
+   return std::equal(s.begin(), s.end(), lowercase.begin(), [](char a, char b) {
+      return std::tolower(static_cast<unsigned char>(a)) == b;
+   });
+}
+
 } // namespace ccon
@@ -5,7 +5,10 @@
 // MIT license
 //
 #pragma once
+#include "cmd.h"
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 
 namespace ccon
@@ -13,5 +16,26 @@ namespace ccon
 ///////////////////
 
 std::string stripArgSeparators(const std::string& s);
+// Non-allocating version that returns a view into the passed text.
+std::string_view stripArgSeparatorsView(std::string_view s);
+// Checks if a command line word is an argument label, i.e. starts with one or two
+// dashes.
+bool isArgLabel(std::string_view word);
+
+// Splits a command line into words. The words refer to the passed text. The
+// collection of words is allocated from a given memory resource.
+CmdArgViews splitCmdLine(std::string_view cmdLine, std::pmr::memory_resource* resource =
+                                                      std::pmr::get_default_resource());
+
+// Checks if a command line ends in the marker '&' that starts the command as
+// background job. Trailing whitespace is ignored.
+bool hasBackgroundMarker(std::string_view cmdLine);
+// Removes trailing whitespace and a trailing background marker from a command line.
+// Returns a view into the passed text.
+std::string_view stripBackgroundMarker(std::string_view cmdLine);
+
+// Checks if a given text matches a lowercase text when ignoring the case of the
+// text.
+bool equalsLowercase(std::string_view s, std::string_view lowercase);
 
 } // namespace ccon
@@ -118,7 +118,7 @@ template <typename Str> std::vector<Str> split(const Str& s, const Str& separato
 template <typename Iter, typename Str> Str join(Iter it, Iter end, const Str& separator)
 {
    static_assert(isStdString<Str>);
-   static_assert(std::is_same_v<std::iterator_traits<Iter>::value_type, Str>);
+   static_assert(std::is_same_v<typename std::iterator_traits<Iter>::value_type, Str>);
 
    Str joined;
    for (; it != end; ++it)
@@ -0,0 +1,322 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "fuzzy_index.h"
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CCON_FUZZY_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CCON_FUZZY_SSE2
+#endif
+
+
+namespace
+{
+///////////////////
+
+constexpr int ScoreMatch = 16;
+constexpr int BonusWordStart = 8;
+constexpr int BonusConsecutive = 8;
+constexpr int BonusFirstChar = 8;
+constexpr int PenaltyGapStart = 3;
+constexpr int PenaltyGapExtension = 1;
+
+
+// Score of alignments that are not possible.
+constexpr int NoScore = std::numeric_limits<int>::min() / 2;
+
+
+char toLower(char ch)
+{
+   return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+
+bool isWordSeparator(char ch)
+{
+   switch (ch)
+   {
+   case ' ':
+   case '-':
+   case '_':
+   case ':':
+   case '.':
+   case '/':
+   case '\\':
+      return true;
+   default:
+      return false;
+   }
+}
+
+
+bool isWordStart(std::string_view text, std::size_t pos)
+{
+   return pos == 0 || isWordSeparator(text[pos - 1]);
+}
+
+
+// Score of a pattern character that matches at a given position without the bonus
+// for following the previous match.
+int matchScore(std::string_view text, std::size_t pos)
+{
+   int score = ScoreMatch;
+   if (isWordStart(text, pos))
+      score += BonusWordStart;
+   if (pos == 0)
+      score += BonusFirstChar;
+   return score;
+}
+
+
+// Buffers of fuzzyScore that are reused between calls, so that scoring does not
+// allocate once they are large enough.
+struct ScoreBuffers
+{
+   // Earliest and latest position in the text at which each pattern character can
+   // match.
+   std::vector<std::size_t> first;
+   std::vector<std::size_t> last;
+   // Best scores of the alignments of the pattern up to the previous and up to the
+   // current character that end with a match at each text position.
+   std::vector<int> prevRow;
+   std::vector<int> row;
+};
+
+
+// Character class of a lowercase character. Letters and digits have classes of
+// their own, separators and all other characters share classes.
+int charClass(char ch)
+{
+   if (ch >= 'a' && ch <= 'z')
+      return ch - 'a';
+   if (ch >= '0' && ch <= '9')
+      return 26 + (ch - '0');
+   if (isWordSeparator(ch))
+      return 36;
+   return 37;
+}
+
+
+// Calls a given function with the indices of the masks that contain all bits of a
+// required mask.
+template <typename Fn>
+void forEachCandidate(const std::uint64_t* masks, std::size_t numMasks,
+                      std::uint64_t required, Fn processCandidate)
+{
+   std::size_t idx = 0;
+
+#if defined(CCON_FUZZY_AVX2)
+   const __m256i requiredLanes = _mm256_set1_epi64x(static_cast<long long>(required));
+   for (; idx + 4 <= numMasks; idx += 4)
+   {
+      const __m256i lanes =
+         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(masks + idx));
+      const __m256i isContained =
+         _mm256_cmpeq_epi64(_mm256_and_si256(lanes, requiredLanes), requiredLanes);
+      const int laneBits = _mm256_movemask_pd(_mm256_castsi256_pd(isContained));
+      for (int lane = 0; laneBits != 0 && lane < 4; ++lane)
+         if (laneBits & (1 << lane))
+            processCandidate(idx + lane);
+   }
+#elif defined(CCON_FUZZY_SSE2)
+   // SSE2 has no 64-bit comparison. Both 32-bit halves of a lane have to be equal.
+   const __m128i requiredLanes = _mm_set1_epi64x(static_cast<long long>(required));
+   for (; idx + 2 <= numMasks; idx += 2)
+   {
+      const __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + idx));
+      const __m128i isContained =
+         _mm_cmpeq_epi32(_mm_and_si128(lanes, requiredLanes), requiredLanes);
+      const int halfBits = _mm_movemask_ps(_mm_castsi128_ps(isContained));
+      if ((halfBits & 0x3) == 0x3)
+         processCandidate(idx);
+      if ((halfBits & 0xC) == 0xC)
+         processCandidate(idx + 1);
+   }
+#endif
+
+   for (; idx < numMasks; ++idx)
+      if ((masks[idx] & required) == required)
+         processCandidate(idx);
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+std::optional<int> fuzzyScore(std::string_view pattern, std::string_view text)
+{
+   if (pattern.empty())
+      return 0;
+
+   thread_local ScoreBuffers buffers;
+   std::vector<std::size_t>& first = buffers.first;
+   std::vector<std::size_t>& last = buffers.last;
+   first.resize(pattern.size());
+   last.resize(pattern.size());
+
+   // Matching greedily from the front gives the earliest positions of the pattern
+   // characters.
+   std::size_t patternPos = 0;
+   for (std::size_t pos = 0; pos < text.size() && patternPos < pattern.size(); ++pos)
+      if (toLower(text[pos]) == pattern[patternPos])
+         first[patternPos++] = pos;
+   if (patternPos < pattern.size())
+      return std::nullopt;
+
+   // Matching greedily from the back gives the latest positions.
+   for (std::size_t pos = text.size(); patternPos > 0;)
+      if (toLower(text[--pos]) == pattern[patternPos - 1])
+         last[--patternPos] = pos;
+
+   // Score the best alignment instead of the first one, e.g. an alignment at word
+   // starts later in the text. Each row extends the alignments by one pattern
+   // character.
+   std::vector<int>& prevRow = buffers.prevRow;
+   std::vector<int>& row = buffers.row;
+   prevRow.resize(text.size());
+   row.resize(text.size());
+
+   for (std::size_t i = 0; i < pattern.size(); ++i)
+   {
+      // Best score of the alignments up to the previous character that are
+      // followed by a gap up to the current position.
+      int gapScore = NoScore;
+
+      // Start after the earliest previous match to collect the gaps that lead to
+      // the earliest match of this character.
+      const std::size_t start = (i == 0) ? first[0] : first[i - 1] + 1;
+      for (std::size_t pos = start; pos <= last[i]; ++pos)
+      {
+         int score = NoScore;
+         if (pos >= first[i] && toLower(text[pos]) == pattern[i])
+         {
+            score = 0;
+            if (i > 0)
+            {
+               const int consecutiveScore =
+                  prevRow[pos - 1] != NoScore ? prevRow[pos - 1] + BonusConsecutive
+                                              : NoScore;
+               score = std::max(consecutiveScore, gapScore);
+            }
+            if (score != NoScore)
+               score += matchScore(text, pos);
+         }
+         row[pos] = score;
+
+         if (i > 0)
+         {
+            if (gapScore != NoScore)
+               gapScore -= PenaltyGapExtension;
+            if (prevRow[pos - 1] != NoScore)
+               gapScore = std::max(gapScore, prevRow[pos - 1] - PenaltyGapStart);
+         }
+      }
+
+      // The next character reads the scores up to its own latest position.
+      if (i + 1 < pattern.size())
+         std::fill(row.begin() + last[i] + 1, row.begin() + last[i + 1], NoScore);
+      std::swap(prevRow, row);
+   }
+
+   const std::size_t lastIdx = pattern.size() - 1;
+   return *std::max_element(prevRow.begin() + first[lastIdx],
+                            prevRow.begin() + last[lastIdx] + 1);
+}
+
+
+std::uint64_t charClassMask(std::string_view text)
+{
+   std::uint64_t mask = 0;
+   for (char ch : text)
+      mask |= std::uint64_t{1} << charClass(toLower(ch));
+   return mask;
+}
+
+
+///////////////////
+
+void FuzzyIndex::add(std::string text)
+{
+   m_masks.push_back(charClassMask(text));
+   m_texts.push_back(std::move(text));
+}
+
+
+std::vector<FuzzyMatch> FuzzyIndex::match(std::string_view pattern) const
+{
+   std::vector<FuzzyMatch> matches;
+   forEachCandidate(m_masks.data(), m_masks.size(), charClassMask(pattern),
+                    [this, pattern, &matches](std::size_t textIdx) {
+                       if (const std::optional<int> score =
+                              fuzzyScore(pattern, m_texts[textIdx]))
+                       {
+                          matches.push_back({*score, textIdx});
+                       }
+                    });
+   return matches;
+}
+
+
+void FuzzyIndex::narrow(std::vector<FuzzyMatch>& matches, std::string_view pattern) const
+{
+   const std::uint64_t patternMask = charClassMask(pattern);
+
+   const auto isMismatch = [this, pattern, patternMask](FuzzyMatch& match) {
+      if ((m_masks[match.textIdx] & patternMask) != patternMask)
+         return true;
+      const std::optional<int> score = fuzzyScore(pattern, m_texts[match.textIdx]);
+      if (!score)
+         return true;
+      match.score = *score;
+      return false;
+   };
+   matches.erase(std::remove_if(matches.begin(), matches.end(), isMismatch),
+                 matches.end());
+}
+
+
+std::vector<std::string> FuzzyIndex::best(std::vector<FuzzyMatch> matches,
+                                          std::size_t maxResults) const
+{
+   const auto isBetter = [this](const FuzzyMatch& a, const FuzzyMatch& b) {
+      if (a.score != b.score)
+         return a.score > b.score;
+      const std::string& textA = m_texts[a.textIdx];
+      const std::string& textB = m_texts[b.textIdx];
+      if (textA.size() != textB.size())
+         return textA.size() < textB.size();
+      return textA < textB;
+   };
+
+   // Only the best matches need to be ordered.
+   const std::size_t numResults = std::min(maxResults, matches.size());
+   std::partial_sort(matches.begin(), matches.begin() + numResults, matches.end(),
+                     isBetter);
+
+   std::vector<std::string> results;
+   results.reserve(numResults);
+   for (std::size_t i = 0; i < numResults; ++i)
+      results.push_back(m_texts[matches[i].textIdx]);
+   return results;
+}
+
+
+void FuzzyIndex::clear()
+{
+   m_texts.clear();
+   m_masks.clear();
+}
+
+} // namespace ccon
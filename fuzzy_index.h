@@ -0,0 +1,82 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+// Scores how well a text matches a pattern whose characters occur in the text in
+// the same order, but not necessarily next to each other. Consecutive matches and
+// matches at word starts score higher, gaps between matches lower. Scores the
+// best of all positions at which the pattern occurs. Ignores the case of the text.
+// The pattern has to be lowercase.
+// Returns nothing if the pattern is not a subsequence of the text.
+std::optional<int> fuzzyScore(std::string_view pattern, std::string_view text);
+
+// Bit set of the character classes that occur in a text. A text can only match a
+// pattern if its set contains the set of the pattern.
+std::uint64_t charClassMask(std::string_view text);
+
+
+///////////////////
+
+// Text of a fuzzy index that matches a pattern.
+struct FuzzyMatch
+{
+   int score = 0;
+   std::size_t textIdx = 0;
+};
+
+
+// Texts that get ranked by how well they fuzzily match a pattern.
+// The character class masks of the texts are stored contiguously, so that texts
+// that cannot match are skipped with vector instructions (AVX2 or SSE2 with a
+// scalar fallback) before the remaining texts get scored.
+class FuzzyIndex
+{
+ public:
+   FuzzyIndex() = default;
+   ~FuzzyIndex() = default;
+   FuzzyIndex(const FuzzyIndex&) = default;
+   FuzzyIndex(FuzzyIndex&&) = default;
+   FuzzyIndex& operator=(const FuzzyIndex&) = default;
+   FuzzyIndex& operator=(FuzzyIndex&&) = default;
+
+   void add(std::string text);
+   // Returns the texts that match a pattern in no particular order.
+   std::vector<FuzzyMatch> match(std::string_view pattern) const;
+   // Narrows the matches of a pattern down to a pattern that extends it. Texts that
+   // don't match a pattern cannot match its extensions, so only the matches get
+   // scored again.
+   void narrow(std::vector<FuzzyMatch>& matches, std::string_view pattern) const;
+   // Returns the texts of up to a given number of matches, best match first. Texts
+   // with the same score are ordered by length and then alphabetically.
+   std::vector<std::string> best(std::vector<FuzzyMatch> matches,
+                                 std::size_t maxResults) const;
+   std::vector<std::string> rank(std::string_view pattern, std::size_t maxResults) const
+   {
+      return best(match(pattern), maxResults);
+   }
+   std::size_t size() const { return m_texts.size(); }
+   bool empty() const { return m_texts.empty(); }
+   void clear();
+
+ private:
+   std::vector<std::string> m_texts;
+   // Character class masks of the texts by the indices of the texts.
+   std::vector<std::uint64_t> m_masks;
+};
+
+} // namespace ccon
@@ -0,0 +1,76 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "interactive_cmd.h"
+#include <utility>
+
+
+namespace ccon
+{
+///////////////////
+
+CmdStep InteractiveCmd::resume(OutputSink& /*out*/)
+{
+   return CmdStep::Done;
+}
+
+
+CmdStep InteractiveCmd::resumeWithInput(std::string_view /*inputLine*/,
+                                        OutputSink& /*out*/)
+{
+   return CmdStep::Done;
+}
+
+
+void InteractiveCmd::awaitProgress(const CancellationToken& cancellation)
+{
+   std::unique_lock lock{m_wakeUpMutex};
+   waitUnlessCancelled(m_wokenUp, lock, cancellation, [this]() { return m_isWokenUp; });
+   m_isWokenUp = false;
+}
+
+
+void InteractiveCmd::setWakeUpHandler(std::function<void()> handler)
+{
+   m_wakeUpHandler = std::move(handler);
+}
+
+
+void InteractiveCmd::execute(const VerifiedCmd& input, OutputSink& out)
+{
+   CmdStep step = start(input, out);
+   // Steps that return Wait wait for another thread. Block until it progressed
+   // instead of spinning. Steps that produce no output would not notice a
+   // cancellation, so check it here.
+   while ((step == CmdStep::Continue || step == CmdStep::Wait) && !out.isCancelled())
+   {
+      if (step == CmdStep::Wait)
+      {
+         awaitProgress(out.cancellation());
+         if (out.isCancelled())
+            break;
+      }
+      step = resume(out);
+   }
+
+   if (step == CmdStep::AwaitInput)
+      out.writeLine("Command requires user input.");
+}
+
+
+void InteractiveCmd::wakeUp()
+{
+   {
+      std::scoped_lock lock{m_wakeUpMutex};
+      m_isWokenUp = true;
+   }
+   m_wokenUp.notify_all();
+
+   if (m_wakeUpHandler)
+      m_wakeUpHandler();
+}
+
+} // namespace ccon
@@ -0,0 +1,81 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cancellation.h"
+#include "cmd.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+
+namespace ccon
+{
+///////////////////
+
+// How an interactive command continues after a step.
+enum class CmdStep
+{
+   // The command has finished.
+   Done,
+   // The command yields to the UI and wants to be resumed soon, e.g. to report
+   // progress while it works through its task in slices.
+   Continue,
+   // The command waits for something that happens on another thread, e.g. a
+   // command executing on a worker. It is resumed after it wakes itself up.
+   Wait,
+   // The command waits for the next line that the user enters.
+   AwaitInput
+};
+
+
+// Command that executes in steps on the UI thread. Between steps the console
+// processes user input and other output, so that interactive commands can ask for
+// confirmation or stream progress without blocking the UI or using threads.
+// Commands keep their state in members between steps. Each step writes its output
+// to the passed sink. The console schedules the steps:
+// - start is called when the command is entered.
+// - resume is called after a step that returned Continue, and after a step that
+//   returned Wait once the command called wakeUp.
+// - resumeWithInput is called with the next entered line after a step that
+//   returned AwaitInput.
+// - awaitProgress is called after a step that returned Wait by callers that
+//   execute the steps in a row, so that they block instead of spinning.
+// Commands are registered with the console like other commands.
+class InteractiveCmd : public StreamingCmd
+{
+ public:
+   virtual CmdStep start(const VerifiedCmd& input, OutputSink& out) = 0;
+   virtual CmdStep resume(OutputSink& out);
+   virtual CmdStep resumeWithInput(std::string_view inputLine, OutputSink& out);
+   // Blocks until the command woke itself up or the cancellation is requested.
+   // Commands can override it to wait for the other thread directly.
+   virtual void awaitProgress(const CancellationToken& cancellation);
+   // Sets the handler that schedules the command when it wakes up. Called by the
+   // console before the command starts.
+   void setWakeUpHandler(std::function<void()> handler);
+
+   // Executes the steps in a row for callers that cannot schedule them. Fails when
+   // the command waits for input.
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd& input, OutputSink& out) override;
+   // The steps interleave with the processing of user input on the UI thread.
+   CmdThreadAffinity threadAffinity() const final { return CmdThreadAffinity::UIThread; }
+
+ protected:
+   // Asks for the command to be resumed after a step that returned Wait. Can be
+   // called from any thread.
+   void wakeUp();
+
+ private:
+   std::function<void()> m_wakeUpHandler;
+   std::mutex m_wakeUpMutex;
+   std::condition_variable m_wokenUp;
+   bool m_isWokenUp = false;
+};
+
+} // namespace ccon
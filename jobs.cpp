@@ -0,0 +1,211 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "jobs.h"
+#include "output_sink.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+
+namespace
+{
+///////////////////
+
+std::string_view describe(ccon::JobStatus status)
+{
+   switch (status)
+   {
+   case ccon::JobStatus::Running:
+      return "Running";
+   case ccon::JobStatus::Done:
+      return "Done";
+   case ccon::JobStatus::Cancelled:
+      return "Cancelled";
+   case ccon::JobStatus::TimedOut:
+      return "Timed out";
+   }
+   return {};
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+JobStatus toJobStatus(CancelReason reason)
+{
+   switch (reason)
+   {
+   case CancelReason::Cancelled:
+      return JobStatus::Cancelled;
+   case CancelReason::TimedOut:
+      return JobStatus::TimedOut;
+   case CancelReason::None:
+      break;
+   }
+   return JobStatus::Done;
+}
+
+
+void writeJobOutput(const JobOutputBatch& batch, OutputSink& out)
+{
+   if (batch.numDropped > 0)
+      out.writeLine("... " + std::to_string(batch.numDropped) + " lines dropped");
+   for (const std::string& line : batch.lines)
+      out.writeLine(line);
+}
+
+
+///////////////////
+
+JobOutput::JobOutput(std::size_t capacity, JobOutputOverflow overflow)
+: m_lines{capacity}, m_overflow{overflow}
+{
+}
+
+
+bool JobOutput::push(std::string_view line, const CancellationToken& cancellation)
+{
+   std::unique_lock lock{m_mutex};
+   waitUnlessCancelled(m_spaceAvailable, lock, cancellation, [this]() {
+      return !m_lines.full() || m_overflow != JobOutputOverflow::Wait;
+   });
+
+   const bool wasEmpty = m_lines.empty();
+   if (m_lines.push(std::string{line}))
+      ++m_numDropped;
+   lock.unlock();
+
+   if (wasEmpty)
+      m_outputAvailable.notify_all();
+   return wasEmpty;
+}
+
+
+void JobOutput::setOverflow(JobOutputOverflow overflow)
+{
+   {
+      std::scoped_lock lock{m_mutex};
+      m_overflow = overflow;
+   }
+   m_spaceAvailable.notify_all();
+}
+
+
+void JobOutput::finish(JobStatus status)
+{
+   assert(status != JobStatus::Running);
+   {
+      std::scoped_lock lock{m_mutex};
+      m_status = status;
+   }
+   m_outputAvailable.notify_all();
+}
+
+
+JobOutputBatch JobOutput::takeBatch()
+{
+   JobOutputBatch batch;
+
+   std::unique_lock lock{m_mutex};
+   batch.lines.reserve(m_lines.size());
+   m_lines.drain(
+      [&batch](std::string&& line) { batch.lines.push_back(std::move(line)); });
+   batch.numDropped = std::exchange(m_numDropped, 0);
+   batch.isFinal = m_status != JobStatus::Running;
+   lock.unlock();
+
+   m_spaceAvailable.notify_all();
+   return batch;
+}
+
+
+void JobOutput::waitForOutput(const CancellationToken& cancellation,
+                              std::chrono::steady_clock::time_point until)
+{
+   std::unique_lock lock{m_mutex};
+   waitUnlessCancelled(m_outputAvailable, lock, cancellation, until, [this]() {
+      return !m_lines.empty() || m_status != JobStatus::Running;
+   });
+}
+
+
+bool JobOutput::hasLines() const
+{
+   std::scoped_lock lock{m_mutex};
+   return !m_lines.empty();
+}
+
+
+bool JobOutput::isFull() const
+{
+   std::scoped_lock lock{m_mutex};
+   return m_lines.full();
+}
+
+
+JobStatus JobOutput::status() const
+{
+   std::scoped_lock lock{m_mutex};
+   return m_status;
+}
+
+
+///////////////////
+
+std::string describeJob(const Job& job)
+{
+   constexpr std::size_t StatusWidth = 12;
+
+   std::string descr = "[" + std::to_string(job.id) + "] ";
+   const std::string_view status = describe(job.output->status());
+   descr += status;
+   descr.append(StatusWidth - std::min(status.size(), StatusWidth - 1), ' ');
+   descr += job.cmdLine;
+   if (job.isBackground)
+      descr += " &";
+   return descr;
+}
+
+
+///////////////////
+
+Job& JobTable::addJob(std::string cmdLine, bool isBackground)
+{
+   const std::size_t id = m_jobs.empty() ? 1 : m_jobs.rbegin()->first + 1;
+
+   Job& job = m_jobs[id];
+   job.id = id;
+   job.cmdLine = std::move(cmdLine);
+   job.isBackground = isBackground;
+   job.output->setOverflow(isBackground ? JobOutputOverflow::DropOldest
+                                        : JobOutputOverflow::Wait);
+   return job;
+}
+
+
+Job* JobTable::findJob(std::size_t id)
+{
+   const auto pos = m_jobs.find(id);
+   return pos != m_jobs.end() ? &pos->second : nullptr;
+}
+
+
+bool JobTable::removeJob(std::size_t id)
+{
+   return m_jobs.erase(id) > 0;
+}
+
+
+JobTable::Iter_t JobTable::removeJob(Iter_t pos)
+{
+   return m_jobs.erase(pos);
+}
+
+} // namespace ccon
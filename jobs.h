@@ -0,0 +1,173 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cancellation.h"
+#include "ring_buffer.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ccon
+{
+class OutputSink;
+}
+
+
+namespace ccon
+{
+///////////////////
+
+enum class JobStatus
+{
+   Running,
+   Done,
+   Cancelled,
+   TimedOut
+};
+
+JobStatus toJobStatus(CancelReason reason);
+
+
+///////////////////
+
+// Output lines of a job that were taken from its buffer at once.
+struct JobOutputBatch
+{
+   std::vector<std::string> lines;
+   // Number of lines that were dropped before the batch was taken because the
+   // buffer was full.
+   std::size_t numDropped = 0;
+   // Whether the job has finished and the batch contains its last output.
+   bool isFinal = false;
+};
+
+// Writes the lines of a batch to a sink. Notes dropped lines before the lines.
+void writeJobOutput(const JobOutputBatch& batch, OutputSink& out);
+
+
+// How a job's output buffer handles lines that arrive while it is full.
+enum class JobOutputOverflow
+{
+   // Keeps the most recent lines. For jobs whose output is not displayed yet.
+   DropOldest,
+   // Blocks the job until the UI thread takes the buffered lines. For jobs whose
+   // output is displayed as it arrives.
+   Wait
+};
+
+
+// Output of a job that is buffered until the UI thread displays it.
+// The job and the UI thread can access the output concurrently. A mutex guards the
+// buffer, because waiting jobs block on a condition variable and because the UI
+// thread takes the buffered lines as one batch together with the dropped count.
+class JobOutput
+{
+ public:
+   static constexpr std::size_t DefaultCapacity = 10000;
+
+ public:
+   explicit JobOutput(std::size_t capacity = DefaultCapacity,
+                      JobOutputOverflow overflow = JobOutputOverflow::DropOldest);
+   ~JobOutput() = default;
+   JobOutput(const JobOutput&) = delete;
+   JobOutput(JobOutput&&) = delete;
+   JobOutput& operator=(const JobOutput&) = delete;
+   JobOutput& operator=(JobOutput&&) = delete;
+
+   // Returns whether the buffer was empty before, i.e. whether the UI has to be
+   // notified about the pending output.
+   // Waiting for space stops when the given cancellation is cancelled. The oldest
+   // line is dropped then.
+   bool push(std::string_view line, const CancellationToken& cancellation = {});
+   // Wakes a job that waits for space when switching to dropping lines.
+   void setOverflow(JobOutputOverflow overflow);
+   // Marks the end of the output. The status has to be final.
+   void finish(JobStatus status);
+   JobOutputBatch takeBatch();
+   // Blocks until lines are buffered, the job finished, the given cancellation is
+   // cancelled or a given time is reached.
+   void waitForOutput(const CancellationToken& cancellation,
+                      std::chrono::steady_clock::time_point until =
+                         std::chrono::steady_clock::time_point::max());
+   bool hasLines() const;
+   bool isFull() const;
+   JobStatus status() const;
+
+ private:
+   mutable std::mutex m_mutex;
+   // Signaled when lines are taken from the buffer.
+   std::condition_variable m_spaceAvailable;
+   // Signaled when the first line of a batch arrives or the job finishes.
+   std::condition_variable m_outputAvailable;
+   RingBuffer<std::string> m_lines;
+   JobOutputOverflow m_overflow = JobOutputOverflow::DropOldest;
+   std::size_t m_numDropped = 0;
+   JobStatus m_status = JobStatus::Running;
+};
+
+
+///////////////////
+
+// Command that executes on a worker thread.
+struct Job
+{
+   std::size_t id = 0;
+   // Input that started the job.
+   std::string cmdLine;
+   // Output of background jobs stays buffered until they are brought to the
+   // foreground. Their output buffer drops the oldest lines when full, the buffer
+   // of foreground jobs makes them wait instead.
+   bool isBackground = false;
+   CancellationSource cancellation;
+   std::shared_ptr<JobOutput> output = std::make_shared<JobOutput>();
+   // Number of output lines that were displayed.
+   std::size_t numDisplayedLines = 0;
+   // Whether the user was told that the background job finished.
+   bool isFinishReported = false;
+};
+
+// Describes a job for listing, e.g. "[2] Running   count &".
+std::string describeJob(const Job& job);
+
+
+// Jobs by their ids. Only accessed from the UI thread.
+class JobTable
+{
+ public:
+   using Iter_t = std::map<std::size_t, Job>::iterator;
+
+ public:
+   JobTable() = default;
+   ~JobTable() = default;
+   JobTable(const JobTable&) = delete;
+   JobTable(JobTable&&) = delete;
+   JobTable& operator=(const JobTable&) = delete;
+   JobTable& operator=(JobTable&&) = delete;
+
+   // Ids continue after the highest id in use, like in shells. They start at one
+   // again once all jobs are removed.
+   Job& addJob(std::string cmdLine, bool isBackground);
+   Job* findJob(std::size_t id);
+   bool removeJob(std::size_t id);
+   Iter_t removeJob(Iter_t pos);
+   bool empty() const { return m_jobs.empty(); }
+   std::size_t size() const { return m_jobs.size(); }
+
+   Iter_t begin() { return m_jobs.begin(); }
+   Iter_t end() { return m_jobs.end(); }
+
+ private:
+   std::map<std::size_t, Job> m_jobs;
+};
+
+} // namespace ccon
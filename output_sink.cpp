@@ -0,0 +1,102 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "output_sink.h"
+#include <utility>
+
+
+namespace ccon
+{
+///////////////////
+
+void OutputSink::writeLine(std::string_view line)
+{
+   throwIfCancelled();
+
+   if (m_pending.empty())
+   {
+      emitLines(line);
+      return;
+   }
+
+   m_pending.append(line);
+   const std::string completed = std::move(m_pending);
+   m_pending.clear();
+   emitLines(completed);
+}
+
+
+void OutputSink::write(std::string_view text)
+{
+   throwIfCancelled();
+
+   m_pending.append(text);
+
+   // Pass on the completed lines and keep the incomplete rest.
+   std::size_t pos = 0;
+   for (std::size_t next = m_pending.find('\n'); next != std::string::npos;
+        next = m_pending.find('\n', pos))
+   {
+      emitLine(std::string_view{m_pending}.substr(pos, next - pos));
+      pos = next + 1;
+   }
+   m_pending.erase(0, pos);
+}
+
+
+void OutputSink::flush()
+{
+   if (m_pending.empty())
+      return;
+
+   emitLine(m_pending);
+   m_pending.clear();
+}
+
+
+void OutputSink::throwIfCancelled() const
+{
+   if (const CancelReason reason = m_cancellation.reason(); reason != CancelReason::None)
+      throw CancelledError{reason};
+}
+
+
+void OutputSink::emitLines(std::string_view text)
+{
+   // Split at line breaks without copying the text.
+   std::size_t pos = 0;
+   for (std::size_t next = text.find('\n'); next != std::string_view::npos;
+        next = text.find('\n', pos))
+   {
+      emitLine(text.substr(pos, next - pos));
+      pos = next + 1;
+   }
+   emitLine(text.substr(pos));
+}
+
+
+void OutputSink::emitLine(std::string_view line)
+{
+   consumeLine(line);
+   ++m_numLines;
+}
+
+
+///////////////////
+
+std::vector<std::string> CollectingOutputSink::releaseLines()
+{
+   flush();
+   return std::move(m_lines);
+}
+
+
+void CollectingOutputSink::consumeLine(std::string_view line)
+{
+   m_lines.emplace_back(line);
+}
+
+} // namespace ccon
@@ -0,0 +1,90 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cancellation.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+// Receives the output of a command while the command executes. Commands can write
+// complete lines or arbitrary chunks of text. Both are split into lines at embedded
+// line breaks before they reach the sink's consumer.
+// The sink also carries the cancellation of the command. Writing to the sink of a
+// cancelled command throws CancelledError, which aborts commands that do not check
+// for cancellation themselves at their next output.
+class OutputSink
+{
+ public:
+   OutputSink() = default;
+   virtual ~OutputSink() = default;
+   OutputSink(const OutputSink&) = delete;
+   OutputSink(OutputSink&&) = delete;
+   OutputSink& operator=(const OutputSink&) = delete;
+   OutputSink& operator=(OutputSink&&) = delete;
+
+   // Writes a line. Completes any pending text that was written with write() first.
+   void writeLine(std::string_view line);
+   // Writes text without completing the current line.
+   void write(std::string_view text);
+   // Completes the pending text that was written with write(), if any.
+   void flush();
+   // Number of lines that were passed to the consumer so far.
+   std::size_t countLines() const { return m_numLines; }
+
+   void setCancellation(CancellationToken token) { m_cancellation = std::move(token); }
+   const CancellationToken& cancellation() const { return m_cancellation; }
+   // Long running commands should check this regularly and return early.
+   bool isCancelled() const { return m_cancellation.isCancelled(); }
+
+ protected:
+   // Receives each complete output line. Lines contain no line breaks.
+   virtual void consumeLine(std::string_view line) = 0;
+
+ private:
+   // Passes each line break separated piece of a given text to the consumer.
+   void emitLines(std::string_view text);
+   void emitLine(std::string_view line);
+   void throwIfCancelled() const;
+
+ private:
+   CancellationToken m_cancellation;
+   std::string m_pending;
+   std::size_t m_numLines = 0;
+};
+
+
+///////////////////
+
+// Sink that collects the output lines in a vector.
+class CollectingOutputSink : public OutputSink
+{
+ public:
+   CollectingOutputSink() = default;
+   ~CollectingOutputSink() = default;
+   CollectingOutputSink(const CollectingOutputSink&) = delete;
+   CollectingOutputSink(CollectingOutputSink&&) = delete;
+   CollectingOutputSink& operator=(const CollectingOutputSink&) = delete;
+   CollectingOutputSink& operator=(CollectingOutputSink&&) = delete;
+
+   const std::vector<std::string>& lines() const { return m_lines; }
+   std::vector<std::string> releaseLines();
+
+ protected:
+   void consumeLine(std::string_view line) override;
+
+ private:
+   std::vector<std::string> m_lines;
+};
+
+} // namespace ccon
@@ -0,0 +1,317 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "path_completion.h"
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#define CCON_HAVE_INOTIFY
+#endif
+
+namespace fs = std::filesystem;
+
+
+namespace
+{
+///////////////////
+
+#if defined(_WIN32)
+constexpr char PathSeparators[] = "/\\";
+#else
+constexpr char PathSeparators[] = "/";
+#endif
+
+
+bool startsWith(std::string_view text, std::string_view prefix)
+{
+   return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+DirectoryCache::DirectoryCache(std::size_t maxDirs)
+: m_maxDirs{std::max<std::size_t>(maxDirs, 1)}
+{
+}
+
+
+DirectoryCache::~DirectoryCache()
+{
+#if defined(CCON_HAVE_INOTIFY)
+   // Closing the instance removes its watches.
+   if (m_inotifyFd >= 0)
+      close(m_inotifyFd);
+#endif
+}
+
+
+std::optional<std::vector<DirEntry>> DirectoryCache::find(const fs::path& dir,
+                                                          std::string_view prefix)
+{
+   std::lock_guard lock{m_mutex};
+   processChanges();
+
+   // Different paths of the same directory share a listing.
+   std::error_code ec;
+   const fs::path canonicalDir = fs::canonical(dir, ec);
+   if (ec)
+      return std::nullopt;
+
+   const Listing* listing = findListing(canonicalDir.string(), canonicalDir);
+   if (!listing)
+      return std::nullopt;
+
+   const auto first = std::partition_point(
+      listing->entries.begin(), listing->entries.end(),
+      [prefix](const DirEntry& entry) { return entry.name < prefix; });
+   const auto last = std::partition_point(
+      first, listing->entries.end(),
+      [prefix](const DirEntry& entry) { return startsWith(entry.name, prefix); });
+   return std::vector<DirEntry>(first, last);
+}
+
+
+void DirectoryCache::clear()
+{
+   std::lock_guard lock{m_mutex};
+   for (auto& [key, listing] : m_listings)
+      unwatch(listing);
+   m_listings.clear();
+}
+
+
+std::size_t DirectoryCache::size() const
+{
+   std::lock_guard lock{m_mutex};
+   return m_listings.size();
+}
+
+
+std::size_t DirectoryCache::countScans() const
+{
+   std::lock_guard lock{m_mutex};
+   return m_numScans;
+}
+
+
+DirectoryCache::Listing* DirectoryCache::findListing(const std::string& key,
+                                                     const fs::path& dir)
+{
+   auto pos = m_listings.find(key);
+   if (pos == m_listings.end())
+   {
+      pos = m_listings.emplace(key, Listing{}).first;
+      // Watch before reading the directory, so that no change gets lost.
+      watch(key, pos->second);
+      pos->second.isStale = true;
+   }
+   else if (pos->second.watchId < 0 && !pos->second.isStale)
+   {
+      // Without a watch only the modification time tells whether the directory
+      // changed.
+      std::error_code ec;
+      const fs::file_time_type writeTime = fs::last_write_time(dir, ec);
+      pos->second.isStale = ec || writeTime != pos->second.writeTime;
+   }
+
+   Listing& listing = pos->second;
+   listing.lastUse = ++m_useCounter;
+   if (listing.isStale && !scan(dir, listing))
+   {
+      unwatch(listing);
+      m_listings.erase(pos);
+      return nullptr;
+   }
+
+   evictExcessListings();
+   return &listing;
+}
+
+
+bool DirectoryCache::scan(const fs::path& dir, Listing& listing)
+{
+   ++m_numScans;
+   listing.isStale = false;
+
+   std::error_code ec;
+   listing.writeTime = fs::last_write_time(dir, ec);
+
+   std::vector<DirEntry> entries;
+   for (fs::directory_iterator iter{dir, fs::directory_options::skip_permission_denied, ec};
+        !ec && iter != fs::directory_iterator{}; iter.increment(ec))
+   {
+      std::error_code typeEc;
+      entries.push_back({iter->path().filename().string(), iter->is_directory(typeEc)});
+   }
+   if (ec)
+      return false;
+
+   std::sort(entries.begin(), entries.end(),
+             [](const DirEntry& a, const DirEntry& b) { return a.name < b.name; });
+   listing.entries = std::move(entries);
+   return true;
+}
+
+
+void DirectoryCache::watch(const std::string& key, Listing& listing)
+{
+#if defined(CCON_HAVE_INOTIFY)
+   if (m_inotifyFd < 0 && !m_isInotifyFailed)
+   {
+      m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      m_isInotifyFailed = m_inotifyFd < 0;
+   }
+   if (m_inotifyFd < 0)
+      return;
+
+   // Fails when the watch limit is reached. The listing falls back to checking the
+   // modification time then.
+   const int watchId =
+      inotify_add_watch(m_inotifyFd, key.c_str(),
+                        IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                           IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR);
+   if (watchId < 0)
+      return;
+
+   listing.watchId = watchId;
+   m_watchedDirs[watchId] = key;
+#else
+   (void)key;
+   (void)listing;
+#endif
+}
+
+
+void DirectoryCache::unwatch(Listing& listing)
+{
+   if (listing.watchId < 0)
+      return;
+
+#if defined(CCON_HAVE_INOTIFY)
+   inotify_rm_watch(m_inotifyFd, listing.watchId);
+#endif
+   m_watchedDirs.erase(listing.watchId);
+   listing.watchId = -1;
+}
+
+
+void DirectoryCache::processChanges()
+{
+#if defined(CCON_HAVE_INOTIFY)
+   if (m_inotifyFd < 0)
+      return;
+
+   alignas(inotify_event) char buffer[4096];
+   for (ssize_t numRead = read(m_inotifyFd, buffer, sizeof(buffer)); numRead > 0;
+        numRead = read(m_inotifyFd, buffer, sizeof(buffer)))
+   {
+      for (const char* pos = buffer; pos < buffer + numRead;)
+      {
+         const auto* event = reinterpret_cast<const inotify_event*>(pos);
+         pos += sizeof(inotify_event) + event->len;
+
+         // Events were dropped. Any directory could have changed.
+         if (event->mask & IN_Q_OVERFLOW)
+         {
+            for (auto& [key, listing] : m_listings)
+               listing.isStale = true;
+            continue;
+         }
+
+         const auto watchedDir = m_watchedDirs.find(event->wd);
+         if (watchedDir == m_watchedDirs.end())
+            continue;
+         const auto listing = m_listings.find(watchedDir->second);
+         if (listing == m_listings.end())
+            continue;
+
+         // Directories that were removed or moved away are dropped. Their paths get
+         // looked up again.
+         if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+         {
+            unwatch(listing->second);
+            m_listings.erase(listing);
+         }
+         else
+         {
+            listing->second.isStale = true;
+         }
+      }
+   }
+#endif
+}
+
+
+void DirectoryCache::evictExcessListings()
+{
+   while (m_listings.size() > m_maxDirs)
+   {
+      const auto leastRecentlyUsed =
+         std::min_element(m_listings.begin(), m_listings.end(),
+                          [](const auto& a, const auto& b) {
+                             return a.second.lastUse < b.second.lastUse;
+                          });
+      unwatch(leastRecentlyUsed->second);
+      m_listings.erase(leastRecentlyUsed);
+   }
+}
+
+
+///////////////////
+
+PathCompletionProvider::PathCompletionProvider(fs::path baseDir, std::size_t maxDirs)
+: m_baseDir{std::move(baseDir)}, m_cache{maxDirs}
+{
+}
+
+
+std::optional<std::vector<std::string>>
+PathCompletionProvider::complete(const std::string& prefix)
+{
+   // The entered directory up to and including its last separator is kept as is.
+   const std::size_t sepPos = prefix.find_last_of(PathSeparators);
+   const std::string dirPart =
+      sepPos == std::string::npos ? std::string{} : prefix.substr(0, sepPos + 1);
+   const std::string namePrefix = prefix.substr(dirPart.size());
+
+   fs::path dir = dirPart.empty() ? fs::path{"."} : fs::path{dirPart};
+   if (dir.is_relative() && !m_baseDir.empty())
+      dir = m_baseDir / dir;
+
+   std::vector<std::string> completions;
+   const std::optional<std::vector<DirEntry>> entries = m_cache.find(dir, namePrefix);
+   if (!entries)
+      return completions;
+
+   const bool withHidden = startsWith(namePrefix, ".");
+   completions.reserve(entries->size());
+   for (const DirEntry& entry : *entries)
+   {
+      if (!withHidden && startsWith(entry.name, "."))
+         continue;
+      completions.push_back(dirPart + entry.name);
+      if (entry.isDirectory)
+         completions.back().push_back(static_cast<char>(fs::path::preferred_separator));
+   }
+   return completions;
+}
+
+
+void PathCompletionProvider::invalidate()
+{
+   m_cache.clear();
+}
+
+} // namespace ccon
@@ -0,0 +1,116 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "value_completion.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+struct DirEntry
+{
+   std::string name;
+   bool isDirectory = false;
+};
+
+
+// Listings of directories whose entries are sorted by name, so that the entries
+// with a given prefix are found with a binary search even in large directories.
+// Listings are only read again after their directory changed. On Linux changes are
+// reported by inotify, elsewhere the modification time of the directory is checked
+// on each lookup. Evicts the least recently used listing when full.
+// Thread-safe.
+class DirectoryCache
+{
+ public:
+   static constexpr std::size_t DefaultMaxDirs = 64;
+
+ public:
+   explicit DirectoryCache(std::size_t maxDirs = DefaultMaxDirs);
+   ~DirectoryCache();
+   DirectoryCache(const DirectoryCache&) = delete;
+   DirectoryCache(DirectoryCache&&) = delete;
+   DirectoryCache& operator=(const DirectoryCache&) = delete;
+   DirectoryCache& operator=(DirectoryCache&&) = delete;
+
+   // Returns the entries of a directory whose names start with a given prefix,
+   // sorted by name. Returns nothing if the directory cannot be read.
+   std::optional<std::vector<DirEntry>> find(const std::filesystem::path& dir,
+                                             std::string_view prefix);
+   void clear();
+   std::size_t size() const;
+   // Number of times that directories were read. Changes only when a directory is
+   // looked up for the first time or after it changed.
+   std::size_t countScans() const;
+
+ private:
+   struct Listing
+   {
+      // Sorted by name.
+      std::vector<DirEntry> entries;
+      // Inotify watch of the directory or -1.
+      int watchId = -1;
+      std::filesystem::file_time_type writeTime;
+      bool isStale = false;
+      std::uint64_t lastUse = 0;
+   };
+
+   Listing* findListing(const std::string& key, const std::filesystem::path& dir);
+   bool scan(const std::filesystem::path& dir, Listing& listing);
+   void watch(const std::string& key, Listing& listing);
+   void unwatch(Listing& listing);
+   void processChanges();
+   void evictExcessListings();
+
+ private:
+   mutable std::mutex m_mutex;
+   std::size_t m_maxDirs = DefaultMaxDirs;
+   // Listings by the canonical paths of their directories.
+   std::unordered_map<std::string, Listing> m_listings;
+   // Paths of the watched directories by their watch ids.
+   std::unordered_map<int, std::string> m_watchedDirs;
+   // Inotify instance. Created with the first watch. -1 if not available.
+   int m_inotifyFd = -1;
+   bool m_isInotifyFailed = false;
+   std::uint64_t m_useCounter = 0;
+   std::size_t m_numScans = 0;
+};
+
+
+///////////////////
+
+// Completes values of path arguments with the entries of the entered directory.
+// Relative paths are resolved against a given base directory or the current
+// directory. Completed directories end with a separator, so that their entries can
+// be completed next. Hidden entries are only completed when their name is entered
+// with its leading dot.
+class PathCompletionProvider : public ValueCompletionProvider
+{
+ public:
+   explicit PathCompletionProvider(std::filesystem::path baseDir = {},
+                                   std::size_t maxDirs = DirectoryCache::DefaultMaxDirs);
+
+   std::optional<std::vector<std::string>> complete(const std::string& prefix) override;
+   void invalidate() override;
+   const DirectoryCache& cache() const { return m_cache; }
+
+ private:
+   std::filesystem::path m_baseDir;
+   DirectoryCache m_cache;
+};
+
+} // namespace ccon
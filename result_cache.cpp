@@ -0,0 +1,191 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "result_cache.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+// Prefixes texts with their lengths, so that the concatenated pieces of different
+// commands cannot collide.
+void appendPiece(std::string& key, std::string_view piece)
+{
+   key += std::to_string(piece.size());
+   key += ':';
+   key += piece;
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+std::string makeResultKey(const VerifiedCmd& cmd)
+{
+   // Positional arguments already come in the order of their specs. Optional
+   // arguments can be entered in any order.
+   std::vector<const VerifiedArg*> args;
+   args.reserve(cmd.args.size());
+   for (const VerifiedArg& arg : cmd.args)
+      args.push_back(&arg);
+   std::stable_sort(args.begin(), args.end(), [](const VerifiedArg* a, const VerifiedArg* b) {
+      if (a->specIdx != b->specIdx)
+         return a->specIdx < b->specIdx;
+      return a->label < b->label;
+   });
+
+   std::string key;
+   appendPiece(key, cmd.name);
+   for (const VerifiedArg* arg : args)
+   {
+      key += '|';
+      appendPiece(key, arg->label);
+      for (const std::string& value : arg->values)
+         appendPiece(key, value);
+   }
+   return key;
+}
+
+
+///////////////////
+
+CmdResultCache::CmdResultCache(std::size_t maxEntries,
+                               std::optional<std::chrono::milliseconds> ttl)
+: m_maxEntries{maxEntries}, m_ttl{ttl}
+{
+}
+
+
+std::optional<CmdOutput> CmdResultCache::find(const std::string& key)
+{
+   std::scoped_lock lock{m_mutex};
+
+   const auto indexPos = m_index.find(key);
+   if (indexPos == m_index.end())
+      return std::nullopt;
+
+   const EntryList_t::iterator entryPos = indexPos->second;
+   if (isExpired(*entryPos, Clock_t::now()))
+   {
+      erase(entryPos);
+      return std::nullopt;
+   }
+
+   m_entries.splice(m_entries.begin(), m_entries, entryPos);
+   return entryPos->output;
+}
+
+
+void CmdResultCache::insert(std::string key, SymbolId cmdNameId, CmdOutput output,
+                            std::uint64_t startGeneration)
+{
+   std::scoped_lock lock{m_mutex};
+
+   if (startGeneration != m_generation || m_maxEntries == 0)
+      return;
+
+   if (const auto indexPos = m_index.find(key); indexPos != m_index.end())
+      erase(indexPos->second);
+
+   m_entries.push_front(Entry{std::move(key), cmdNameId, std::move(output), Clock_t::now()});
+   m_index.emplace(m_entries.front().key, m_entries.begin());
+   evictExcessEntries();
+}
+
+
+std::uint64_t CmdResultCache::generation() const
+{
+   std::scoped_lock lock{m_mutex};
+   return m_generation;
+}
+
+
+void CmdResultCache::invalidate(SymbolId cmdNameId)
+{
+   std::scoped_lock lock{m_mutex};
+
+   ++m_generation;
+   for (auto pos = m_entries.begin(); pos != m_entries.end();)
+   {
+      const auto next = std::next(pos);
+      if (pos->cmdNameId == cmdNameId)
+         erase(pos);
+      pos = next;
+   }
+}
+
+
+void CmdResultCache::invalidateAll()
+{
+   std::scoped_lock lock{m_mutex};
+
+   ++m_generation;
+   m_index.clear();
+   m_entries.clear();
+}
+
+
+void CmdResultCache::setLimits(std::size_t maxEntries,
+                               std::optional<std::chrono::milliseconds> ttl)
+{
+   std::scoped_lock lock{m_mutex};
+
+   m_maxEntries = maxEntries;
+   m_ttl = ttl;
+   evictExcessEntries();
+   evictExpiredEntries();
+}
+
+
+std::size_t CmdResultCache::size() const
+{
+   std::scoped_lock lock{m_mutex};
+   return m_entries.size();
+}
+
+
+void CmdResultCache::evictExcessEntries()
+{
+   while (m_entries.size() > m_maxEntries)
+      erase(std::prev(m_entries.end()));
+}
+
+
+void CmdResultCache::evictExpiredEntries()
+{
+   // The order of use does not tell the age of the entries. Check them all.
+   const Clock_t::time_point now = Clock_t::now();
+   for (auto pos = m_entries.begin(); pos != m_entries.end();)
+   {
+      const auto next = std::next(pos);
+      if (isExpired(*pos, now))
+         erase(pos);
+      pos = next;
+   }
+}
+
+
+void CmdResultCache::erase(EntryList_t::iterator pos)
+{
+   m_index.erase(pos->key);
+   m_entries.erase(pos);
+}
+
+
+bool CmdResultCache::isExpired(const Entry& entry, Clock_t::time_point now) const
+{
+   return m_ttl.has_value() && now - entry.insertTime >= *m_ttl;
+}
+
+} // namespace ccon
@@ -0,0 +1,91 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd.h"
+#include "symbol_table.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+
+namespace ccon
+{
+///////////////////
+
+// Returns a key that identifies the result of executing a command with given
+// arguments. Arguments are ordered like their specs, so that the order in which
+// optional arguments were entered does not matter.
+std::string makeResultKey(const VerifiedCmd& cmd);
+
+
+// Outputs of pure commands by the keys of their inputs. Evicts the least recently
+// used result when full. Results that are older than the time to live are dropped
+// when they are looked up.
+// Thread-safe.
+class CmdResultCache
+{
+ public:
+   using Clock_t = std::chrono::steady_clock;
+
+   static constexpr std::size_t DefaultMaxEntries = 256;
+
+ public:
+   // Results are kept indefinitely if no time to live is given.
+   explicit CmdResultCache(std::size_t maxEntries = DefaultMaxEntries,
+                           std::optional<std::chrono::milliseconds> ttl = std::nullopt);
+   ~CmdResultCache() = default;
+   CmdResultCache(const CmdResultCache&) = delete;
+   CmdResultCache(CmdResultCache&&) = delete;
+   CmdResultCache& operator=(const CmdResultCache&) = delete;
+   CmdResultCache& operator=(CmdResultCache&&) = delete;
+
+   std::optional<CmdOutput> find(const std::string& key);
+   // Results of executions that started before an invalidation are not stored,
+   // because they might be outdated. Pass the generation at the start of the
+   // execution.
+   void insert(std::string key, SymbolId cmdNameId, CmdOutput output,
+               std::uint64_t startGeneration);
+   // Changes with each invalidation.
+   std::uint64_t generation() const;
+   // Drops the results of a given command.
+   void invalidate(SymbolId cmdNameId);
+   void invalidateAll();
+   // Evicts results that exceed a new limit right away.
+   void setLimits(std::size_t maxEntries, std::optional<std::chrono::milliseconds> ttl);
+   std::size_t size() const;
+
+ private:
+   struct Entry
+   {
+      std::string key;
+      SymbolId cmdNameId = NoSymbol;
+      CmdOutput output;
+      Clock_t::time_point insertTime;
+   };
+   using EntryList_t = std::list<Entry>;
+
+   void evictExcessEntries();
+   void evictExpiredEntries();
+   void erase(EntryList_t::iterator pos);
+   bool isExpired(const Entry& entry, Clock_t::time_point now) const;
+
+ private:
+   mutable std::mutex m_mutex;
+   std::size_t m_maxEntries = DefaultMaxEntries;
+   std::optional<std::chrono::milliseconds> m_ttl;
+   // Most recently used entries first.
+   EntryList_t m_entries;
+   std::unordered_map<std::string, EntryList_t::iterator> m_index;
+   std::uint64_t m_generation = 0;
+};
+
+} // namespace ccon
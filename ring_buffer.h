@@ -0,0 +1,122 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+// Queue with a fixed capacity. When full, pushing an item overwrites the oldest
+// item.
+// The storage grows on demand up to the capacity, so that buffers with a large
+// capacity that hold few items stay small.
+template <typename T> class RingBuffer
+{
+ public:
+   explicit RingBuffer(std::size_t capacity);
+   ~RingBuffer() = default;
+   RingBuffer(const RingBuffer&) = default;
+   RingBuffer(RingBuffer&&) = default;
+   RingBuffer& operator=(const RingBuffer&) = default;
+   RingBuffer& operator=(RingBuffer&&) = default;
+
+   std::size_t capacity() const { return m_capacity; }
+   std::size_t size() const { return m_size; }
+   bool empty() const { return m_size == 0; }
+   bool full() const { return m_size == m_capacity; }
+
+   // Appends an item. Returns whether the oldest item was overwritten.
+   bool push(T item);
+   // Removes the oldest item and returns it.
+   T pop();
+   // Passes all items to a given function from oldest to newest and removes them.
+   // Returns the number of processed items.
+   template <typename Fn> std::size_t drain(Fn processItem);
+   void clear();
+
+ private:
+   std::size_t storageIdx(std::size_t idx) const { return (m_head + idx) % m_items.size(); }
+
+ private:
+   std::size_t m_capacity = 0;
+   std::vector<T> m_items;
+   // Storage index of the oldest item.
+   std::size_t m_head = 0;
+   std::size_t m_size = 0;
+};
+
+
+template <typename T> RingBuffer<T>::RingBuffer(std::size_t capacity) : m_capacity{capacity}
+{
+   assert(m_capacity > 0 && "Ring buffer needs space for at least one item.");
+}
+
+
+template <typename T> bool RingBuffer<T>::push(T item)
+{
+   if (m_size < m_items.size())
+   {
+      m_items[storageIdx(m_size)] = std::move(item);
+      ++m_size;
+      return false;
+   }
+
+   if (m_items.size() < m_capacity)
+   {
+      // Appending to the storage requires the items to start at its beginning.
+      std::rotate(m_items.begin(), m_items.begin() + m_head, m_items.end());
+      m_head = 0;
+      m_items.push_back(std::move(item));
+      ++m_size;
+      return false;
+   }
+
+   // Full. Overwrite the oldest item.
+   m_items[m_head] = std::move(item);
+   m_head = (m_head + 1) % m_items.size();
+   return true;
+}
+
+
+template <typename T> T RingBuffer<T>::pop()
+{
+   assert(!empty());
+   T item = std::move(m_items[m_head]);
+   --m_size;
+   m_head = m_size > 0 ? (m_head + 1) % m_items.size() : 0;
+   return item;
+}
+
+
+template <typename T>
+template <typename Fn>
+std::size_t RingBuffer<T>::drain(Fn processItem)
+{
+   std::size_t numItems = 0;
+   while (!empty())
+   {
+      processItem(pop());
+      ++numItems;
+   }
+   return numItems;
+}
+
+
+template <typename T> void RingBuffer<T>::clear()
+{
+   m_items.clear();
+   m_head = 0;
+   m_size = 0;
+}
+
+} // namespace ccon
@@ -0,0 +1,148 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "script_parser.h"
+#include "console_util.h"
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+
+namespace
+{
+///////////////////
+
+bool isSkippedLine(std::string_view line)
+{
+   const std::size_t start = line.find_first_not_of(" \t");
+   return start == std::string_view::npos || line[start] == '#';
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+ScriptParser::ScriptParser(std::unique_ptr<std::istream> script,
+                           std::shared_ptr<const CmdDepot> cmds, NotifyFn onLinesAvailable)
+: m_cmds{std::move(cmds)}, m_onLinesAvailable{std::move(onLinesAvailable)}
+{
+   m_thread = std::thread{[this, script = std::move(script)]() { parse(*script); }};
+}
+
+
+ScriptParser::~ScriptParser()
+{
+   {
+      std::scoped_lock lock{m_mutex};
+      m_isStopping = true;
+   }
+   m_spaceAvailable.notify_one();
+   m_thread.join();
+}
+
+
+std::vector<ScriptLine> ScriptParser::takeLines()
+{
+   std::vector<ScriptLine> lines;
+   {
+      std::scoped_lock lock{m_mutex};
+      for (std::vector<ScriptLine>& batch : m_batches)
+      {
+         if (lines.empty())
+            lines = std::move(batch);
+         else
+            lines.insert(lines.end(), std::make_move_iterator(batch.begin()),
+                         std::make_move_iterator(batch.end()));
+      }
+      m_batches.clear();
+      m_numAhead -= lines.size();
+   }
+
+   if (!lines.empty())
+      m_spaceAvailable.notify_one();
+   return lines;
+}
+
+
+void ScriptParser::waitForLines(const CancellationToken& cancellation)
+{
+   std::unique_lock lock{m_mutex};
+   waitUnlessCancelled(m_linesAvailable, lock, cancellation,
+                       [this]() { return m_numAhead > 0 || m_isParsed; });
+}
+
+
+void ScriptParser::parse(std::istream& script)
+{
+   std::vector<ScriptLine> batch;
+   std::size_t lineNum = 0;
+   std::string text;
+
+   while (!m_isStopping && std::getline(script, text))
+   {
+      ++lineNum;
+      // Scripts might have been written with Windows line endings.
+      if (!text.empty() && text.back() == '\r')
+         text.pop_back();
+      if (isSkippedLine(text))
+         continue;
+
+      ScriptLine& line = batch.emplace_back();
+      line.lineNum = lineNum;
+      line.isBackground = hasBackgroundMarker(text);
+      if (line.isBackground)
+         text = std::string{stripBackgroundMarker(text)};
+      CmdSpec::Match match = m_cmds->matchCommand(text);
+      line.isMatching = match.isMatching;
+      line.areArgsValid = match.areArgsValid;
+      line.cmd = std::move(match.matchedCmd);
+
+      if (batch.size() == BatchSize)
+      {
+         publishLines(std::move(batch));
+         batch.clear();
+         waitForSpace();
+      }
+   }
+
+   if (!batch.empty())
+      publishLines(std::move(batch));
+
+   {
+      std::scoped_lock lock{m_mutex};
+      m_isParsed = true;
+   }
+   m_linesAvailable.notify_one();
+   if (m_onLinesAvailable)
+      m_onLinesAvailable();
+}
+
+
+void ScriptParser::publishLines(std::vector<ScriptLine> batch)
+{
+   {
+      std::scoped_lock lock{m_mutex};
+      m_numAhead += batch.size();
+      m_batches.push_back(std::move(batch));
+   }
+   m_linesAvailable.notify_one();
+   if (m_onLinesAvailable)
+      m_onLinesAvailable();
+}
+
+
+void ScriptParser::waitForSpace()
+{
+   std::unique_lock lock{m_mutex};
+   m_spaceAvailable.wait(
+      lock, [this]() { return m_numAhead < MaxLinesAhead || m_isStopping; });
+}
+
+} // namespace ccon
@@ -0,0 +1,101 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cancellation.h"
+#include "cmd.h"
+#include "cmd_depot.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+// Line of a script that was matched against the available commands.
+struct ScriptLine
+{
+   // One-based number of the line within the script.
+   std::size_t lineNum = 0;
+   bool isMatching = false;
+   bool areArgsValid = false;
+   // Whether the line ends in a background marker. The marker is not matched as
+   // argument.
+   bool isBackground = false;
+   VerifiedCmd cmd;
+};
+
+
+// Reads the lines of a script and verifies them on a thread of its own, so that the
+// lines are ready by the time they get executed. Empty lines and comment lines
+// starting with '#' are skipped.
+// Reading stays a limited number of lines ahead of the execution.
+class ScriptParser
+{
+ public:
+   // Lines are passed to the executing thread in batches.
+   static constexpr std::size_t BatchSize = 256;
+   static constexpr std::size_t MaxLinesAhead = 16 * 1024;
+
+ public:
+   // Called on the reading thread when lines are ready to be taken or when all
+   // lines were verified.
+   using NotifyFn = std::function<void()>;
+
+ public:
+   // Starts reading the script right away. The lines are matched against the
+   // commands of a given depot, which must not change while the script is read.
+   ScriptParser(std::unique_ptr<std::istream> script, std::shared_ptr<const CmdDepot> cmds,
+                NotifyFn onLinesAvailable = {});
+   // Stops reading the script.
+   ~ScriptParser();
+   ScriptParser(const ScriptParser&) = delete;
+   ScriptParser(ScriptParser&&) = delete;
+   ScriptParser& operator=(const ScriptParser&) = delete;
+   ScriptParser& operator=(ScriptParser&&) = delete;
+
+   // Returns the lines that were verified since the last call. Must only be called
+   // from one thread.
+   std::vector<ScriptLine> takeLines();
+   // Whether all lines of the script were verified. They might not be taken yet.
+   bool isParsed() const { return m_isParsed; }
+   // Blocks until lines are ready to be taken, all lines were verified or the
+   // given cancellation is cancelled.
+   void waitForLines(const CancellationToken& cancellation);
+
+ private:
+   void parse(std::istream& script);
+   void publishLines(std::vector<ScriptLine> batch);
+   void waitForSpace();
+
+ private:
+   std::shared_ptr<const CmdDepot> m_cmds;
+   NotifyFn m_onLinesAvailable;
+   // Guards the batches and the waiting of the reading thread for space and of the
+   // executing thread for lines.
+   std::mutex m_mutex;
+   std::deque<std::vector<ScriptLine>> m_batches;
+   // Signaled when lines are taken or when reading stops.
+   std::condition_variable m_spaceAvailable;
+   // Signaled when lines are ready to be taken or when all lines were verified.
+   std::condition_variable m_linesAvailable;
+   // Number of lines that were verified but not taken yet.
+   std::size_t m_numAhead = 0;
+   std::atomic<bool> m_isParsed = false;
+   std::atomic<bool> m_isStopping = false;
+   std::thread m_thread;
+};
+
+} // namespace ccon
@@ -0,0 +1,71 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "static_cmd_spec.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace
+{
+///////////////////
+
+ccon::ArgSpec makeArgSpec(const ccon::StaticArgSpec& staticSpec)
+{
+   const std::string label{staticSpec.label};
+   const std::string abbrev{staticSpec.abbrev};
+   const std::string description{staticSpec.description};
+
+   if (label.empty() && abbrev.empty())
+      return ccon::ArgSpec::makePositionalArg(staticSpec.numValues, description,
+                                              staticSpec.valueKind);
+   if (staticSpec.numValues == 0)
+      return ccon::ArgSpec::makeFlagArg(label, abbrev, description);
+   return ccon::ArgSpec::makeOptionalArg(label, staticSpec.numValues, abbrev, description,
+                                         staticSpec.valueKind);
+}
+
+
+ccon::CmdSpec makeCmdSpec(const ccon::StaticCmdSpec& staticSpec)
+{
+   std::vector<ccon::ArgSpec> argSpecs;
+   argSpecs.reserve(staticSpec.numArgs);
+   for (std::size_t i = 0; i < staticSpec.numArgs; ++i)
+      argSpecs.push_back(makeArgSpec(staticSpec.args[i]));
+
+   return {std::string{staticSpec.name}, std::string{staticSpec.abbrev},
+           std::string{staticSpec.description}, std::move(argSpecs),
+           std::string{staticSpec.notes}};
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+CmdSpec toCmdSpec(const StaticCmdSpec& staticSpec)
+{
+   // Static specs live for the duration of the process, so their addresses
+   // identify them.
+   static std::mutex cacheMutex;
+   static std::unordered_map<const StaticCmdSpec*, CmdSpec> cache;
+
+   std::lock_guard<std::mutex> lock{cacheMutex};
+
+   const auto cachePos = cache.find(&staticSpec);
+   if (cachePos != cache.end())
+      return cachePos->second;
+
+   const CmdSpec spec = makeCmdSpec(staticSpec);
+   cache.emplace(&staticSpec, spec);
+   return spec;
+}
+
+} // namespace ccon
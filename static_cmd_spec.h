@@ -0,0 +1,69 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cmd_spec.h"
+#include <cstddef>
+#include <string_view>
+
+
+namespace ccon
+{
+///////////////////
+
+// Argument spec that can be declared as constexpr data.
+// - Positional arguments have no label.
+// - Flag arguments have a label and no values.
+// - Optional arguments have a label and values.
+struct StaticArgSpec
+{
+   std::string_view label;
+   std::string_view abbrev;
+   std::size_t numValues = 0;
+   std::string_view description;
+   ValueKind valueKind = ValueKind::Text;
+};
+
+
+// Command spec that can be declared as constexpr data. The argument specs are
+// referenced as a fixed array.
+// Example:
+//    constexpr StaticArgSpec myArgs[] = {{"", "", 1, "target"}, {"verbose", "v"}};
+//    constexpr StaticCmdSpec mySpec{"mycmd", "m", "does things", myArgs};
+struct StaticCmdSpec
+{
+   constexpr StaticCmdSpec(std::string_view name_, std::string_view abbrev_,
+                           std::string_view description_, std::string_view notes_ = {})
+   : name{name_}, abbrev{abbrev_}, description{description_}, notes{notes_}
+   {
+   }
+
+   template <std::size_t N>
+   constexpr StaticCmdSpec(std::string_view name_, std::string_view abbrev_,
+                           std::string_view description_,
+                           const StaticArgSpec (&args_)[N], std::string_view notes_ = {})
+   : name{name_}, abbrev{abbrev_}, description{description_}, args{args_}, numArgs{N},
+     notes{notes_}
+   {
+   }
+
+   std::string_view name;
+   std::string_view abbrev;
+   std::string_view description;
+   const StaticArgSpec* args = nullptr;
+   std::size_t numArgs = 0;
+   std::string_view notes;
+};
+
+
+// Returns the command spec for a static spec. The spec's data is created once per
+// process and shared by all returned specs, so repeated calls (e.g. for each
+// console instance) do not copy it again.
+// The static spec is identified by its address, so it has to have static storage
+// duration.
+CmdSpec toCmdSpec(const StaticCmdSpec& staticSpec);
+
+} // namespace ccon
@@ -0,0 +1,124 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "symbol_table.h"
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+
+namespace
+{
+///////////////////
+
+ccon::SymbolTable& globalSymbols()
+{
+   static ccon::SymbolTable symbols;
+   return symbols;
+}
+
+
+bool hasUppercase(std::string_view s)
+{
+   return std::any_of(s.begin(), s.end(), [](char ch) {
+      return std::isupper(static_cast<unsigned char>(ch)) != 0;
+   });
+}
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+SymbolId SymbolTable::intern(std::string_view name)
+{
+   if (name.empty())
+      return NoSymbol;
+
+   if (const SymbolId id = find(name); id != NoSymbol)
+      return id;
+
+   std::unique_lock lock{m_mutex};
+
+   // Check again. Another thread might have added the name in the meantime.
+   const auto idIter = m_ids.find(name);
+   if (idIter != m_ids.end())
+      return idIter->second;
+
+   m_names.emplace_back(name);
+   // Ids start after NoSymbol.
+   const SymbolId id = static_cast<SymbolId>(m_names.size());
+   m_ids.emplace(m_names.back(), id);
+   return id;
+}
+
+
+SymbolId SymbolTable::find(std::string_view name) const
+{
+   if (name.empty())
+      return NoSymbol;
+
+   std::shared_lock lock{m_mutex};
+   const auto idIter = m_ids.find(name);
+   if (idIter != m_ids.end())
+      return idIter->second;
+   return NoSymbol;
+}
+
+
+std::string_view SymbolTable::name(SymbolId id) const
+{
+   std::shared_lock lock{m_mutex};
+   if (id == NoSymbol || id > m_names.size())
+      return {};
+   return m_names[id - 1];
+}
+
+
+std::size_t SymbolTable::size() const
+{
+   std::shared_lock lock{m_mutex};
+   return m_names.size();
+}
+
+
+///////////////////
+
+SymbolId internSymbol(std::string_view name)
+{
+   return globalSymbols().intern(name);
+}
+
+
+SymbolId findSymbol(std::string_view name)
+{
+   return globalSymbols().find(name);
+}
+
+
+SymbolId findSymbolIgnoringCase(std::string_view name)
+{
+   // Command and argument names are interned in lowercase. Only make a lowercase copy
+   // if necessary.
+   if (!hasUppercase(name))
+      return findSymbol(name);
+
+   std::string lowercased{name};
+   std::transform(lowercased.begin(), lowercased.end(), lowercased.begin(), [](char ch) {
+      return static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+   });
+   return findSymbol(lowercased);
+}
+
+
+std::string_view symbolName(SymbolId id)
+{
+   return globalSymbols().name(id);
+}
+
+} // namespace ccon
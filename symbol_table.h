@@ -0,0 +1,63 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+
+namespace ccon
+{
+///////////////////
+
+// Id of an interned name.
+using SymbolId = std::uint32_t;
+// Id of the empty name and of names that are not interned.
+inline constexpr SymbolId NoSymbol = 0;
+
+
+// Table of interned names. Each distinct name gets a small integer id, so that names
+// can be compared by comparing their ids.
+// Thread-safe. Names are never removed, so ids and the text of interned names stay
+// valid for the lifetime of the table.
+class SymbolTable
+{
+ public:
+   SymbolTable() = default;
+   ~SymbolTable() = default;
+   SymbolTable(const SymbolTable&) = delete;
+   SymbolTable(SymbolTable&&) = delete;
+   SymbolTable& operator=(const SymbolTable&) = delete;
+   SymbolTable& operator=(SymbolTable&&) = delete;
+
+   // Returns the id of a given name. Adds the name if it is not interned yet.
+   SymbolId intern(std::string_view name);
+   // Returns the id of a given name or NoSymbol if the name is not interned.
+   SymbolId find(std::string_view name) const;
+   // Returns the name of a given id. Returns an empty string for unknown ids.
+   std::string_view name(SymbolId id) const;
+   std::size_t size() const;
+
+ private:
+   mutable std::shared_mutex m_mutex;
+   // Deque elements never relocate, so the map can refer to their text.
+   std::deque<std::string> m_names;
+   std::unordered_map<std::string_view, SymbolId> m_ids;
+};
+
+
+// Access to the process-wide table that holds the names of commands and arguments.
+SymbolId internSymbol(std::string_view name);
+SymbolId findSymbol(std::string_view name);
+// Looks up the lowercase version of a given name.
+SymbolId findSymbolIgnoringCase(std::string_view name);
+std::string_view symbolName(SymbolId id);
+
+} // namespace ccon
@@ -6,9 +6,13 @@
 //
 #include "auto_completion_tests.h"
 #include "auto_completion.h"
+#include "value_completion.h"
 #include "test_util.h"
+#include <chrono>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 using namespace ccon;
 
@@ -205,6 +209,296 @@ void testAutoCompletionReset()
    }
 }
 
+
+
+void testAutoCompletionAddCmd()
+{
+   {
+      const std::string caseLabel = "AutoCompletion::addCmd for command added later";
+      std::set<CmdSpec> specs = {{"test", "ts", "", {}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+      ac.addCmd({"teach", "ta", "", {}, ""});
+
+      const auto all = ac.all("te");
+
+      VERIFY(all == std::vector<std::string>({"teach", "test"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "AutoCompletion::addCmd for known command";
+      AutoCompletion ac;
+      ac.addCmd({"test", "ts", "", {}, ""});
+      ac.addCmd({"test", "ts", "", {}, ""});
+
+      VERIFY(ac.all("te") == std::vector<std::string>{"test"}, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "AutoCompletion::setCmds for replacing commands added earlier";
+      AutoCompletion ac;
+      ac.addCmd({"teach", "ta", "", {}, ""});
+      ac.setCmds({{"test", "ts", "", {}, ""}});
+
+      VERIFY(ac.all("te") == std::vector<std::string>{"test"}, caseLabel);
+   }
+}
+
+
+void testAutoCompletionAbbreviations()
+{
+   {
+      const std::string caseLabel =
+         "AutoCompletion::all for command abbreviation completing to name";
+      std::set<CmdSpec> specs = {{"fontsize", "fs", "", {}, ""},
+                                 {"colors", "c", "", {}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      VERIFY(ac.all("fs") == std::vector<std::string>{"fontsize"}, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "AutoCompletion::all for argument abbreviation completing to label";
+      std::set<CmdSpec> specs = {
+         {"resize",
+          "r",
+          "",
+          {ArgSpec::makeOptionalArg("width", 1, "w"), ArgSpec::makeFlagArg("keepratio", "k")},
+          ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      VERIFY(ac.all("resize -k") == std::vector<std::string>{"resize -keepratio"},
+             caseLabel);
+      ac.reset();
+      VERIFY(ac.all("r --w") == std::vector<std::string>{"r --width"}, caseLabel);
+   }
+   {
+      const std::string caseLabel = "AutoCompletion::all for argument of unknown command";
+      std::set<CmdSpec> specs = {
+         {"resize", "r", "", {ArgSpec::makeOptionalArg("width", 1, "w")}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      VERIFY(ac.all("scale -w").empty(), caseLabel);
+   }
+}
+
+
+
+void testAutoCompletionFuzzyMode()
+{
+   {
+      const std::string caseLabel = "AutoCompletion fuzzy mode for command names";
+      std::set<CmdSpec> specs = {{"fontsize", "fs", "", {}, ""},
+                                 {"colors", "c", "", {}, ""},
+                                 {"fastsave", "f", "", {}, ""},
+                                 {"zap", "z", "", {}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+      ac.setMode(CompletionMode::Fuzzy);
+
+      const std::vector<std::string> expected = {"fastsave", "fontsize"};
+      VERIFY(ac.all("fs") == expected, caseLabel);
+      VERIFY(ac.next("fs") == "fastsave", caseLabel);
+      VERIFY(ac.next("fs") == "fontsize", caseLabel);
+   }
+   {
+      const std::string caseLabel = "AutoCompletion fuzzy mode for argument labels";
+      std::set<CmdSpec> specs = {{"resize",
+                                  "r",
+                                  "",
+                                  {ArgSpec::makeOptionalArg("width", 1, "w"),
+                                   ArgSpec::makeFlagArg("keepratio", "k")},
+                                  ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+      ac.setMode(CompletionMode::Fuzzy);
+
+      VERIFY(ac.all("resize -kr") == std::vector<std::string>{"resize -keepratio"},
+             caseLabel);
+      ac.reset();
+      const std::vector<std::string> all = ac.all("resize -");
+      VERIFY(all.size() == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "AutoCompletion::setMode for switching back to prefix";
+      std::set<CmdSpec> specs = {{"fontsize", "fs", "", {}, ""},
+                                 {"fastsave", "f", "", {}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+      ac.setMode(CompletionMode::Fuzzy);
+      ac.all("fs");
+      ac.setMode(CompletionMode::Prefix);
+
+      VERIFY(ac.all("fs") == std::vector<std::string>{"fontsize"}, caseLabel);
+   }
+}
+
+
+
+void testAutoCompletionNarrowing()
+{
+   const std::set<CmdSpec> specs = {{"teach", "ta", "", {}, ""},
+                                    {"temp", "tp", "", {}, ""},
+                                    {"test", "ts", "", {}, ""},
+                                    {"tax", "tx", "", {}, ""},
+                                    {"zap", "z", "", {}, ""},
+                                    {"resize",
+                                     "r",
+                                     "",
+                                     {ArgSpec::makeOptionalArg("width", 1, "w"),
+                                      ArgSpec::makeFlagArg("wrap")},
+                                     ""}};
+
+   // Completes each input with the narrowed matches of the previous inputs and with
+   // a fresh completion.
+   const auto verifyNarrowing = [&specs](CompletionMode mode,
+                                         const std::vector<std::string>& inputs,
+                                         const std::string& caseLabel) {
+      AutoCompletion ac;
+      ac.setCmds(specs);
+      ac.setMode(mode);
+      for (const std::string& input : inputs)
+      {
+         ac.reset();
+         const std::vector<std::string> narrowed = ac.all(input);
+
+         AutoCompletion fresh;
+         fresh.setCmds(specs);
+         fresh.setMode(mode);
+         VERIFY(narrowed == fresh.all(input), caseLabel + " for '" + input + "'");
+      }
+   };
+
+   verifyNarrowing(CompletionMode::Prefix, {"t", "te", "tes", "test", "testx"},
+                   "AutoCompletion narrowing for extended command name");
+   verifyNarrowing(CompletionMode::Fuzzy, {"t", "te", "tes", "test", "testx"},
+                   "AutoCompletion fuzzy narrowing for extended command name");
+   verifyNarrowing(CompletionMode::Prefix, {"te", "t", "ta", "z"},
+                   "AutoCompletion narrowing for shrinking or changing input");
+   verifyNarrowing(CompletionMode::Fuzzy, {"te", "t", "ta", "z"},
+                   "AutoCompletion fuzzy narrowing for shrinking or changing input");
+   verifyNarrowing(CompletionMode::Prefix,
+                   {"r", "resize", "resize -", "resize -w", "resize -wi", "resize -wr"},
+                   "AutoCompletion narrowing for arguments");
+   verifyNarrowing(CompletionMode::Fuzzy,
+                   {"r", "resize", "resize -", "resize -w", "resize -wi", "resize -wr"},
+                   "AutoCompletion fuzzy narrowing for arguments");
+   verifyNarrowing(CompletionMode::Prefix, {"t", "t -w", "r -w", "r -wi"},
+                   "AutoCompletion narrowing for different commands");
+
+   {
+      const std::string caseLabel = "AutoCompletion narrowing for command added later";
+      AutoCompletion ac;
+      ac.setCmds(specs);
+      VERIFY(ac.all("te").size() == 3, caseLabel);
+
+      ac.addCmd({"tease", "", "", {}, ""});
+      ac.reset();
+      VERIFY(ac.all("tea") == std::vector<std::string>({"teach", "tease"}), caseLabel);
+   }
+}
+
+
+
+void testAutoCompletionArgValues()
+{
+   const auto makeProvider = [](std::vector<std::string> values) {
+      return std::make_shared<SyncValueCompletionProvider>(
+         [values](const std::string& prefix, const CancellationToken&) {
+            std::vector<std::string> matching;
+            for (const std::string& value : values)
+               if (value.compare(0, prefix.size(), prefix) == 0)
+                  matching.push_back(value);
+            return matching;
+         });
+   };
+
+   {
+      const std::string caseLabel = "AutoCompletion::all for value of optional argument";
+      ArgSpec hostArg = ArgSpec::makeOptionalArg("host", 1, "h");
+      hostArg.setCompletionProvider(makeProvider({"alpha", "beta", "beta2"}));
+      std::set<CmdSpec> specs = {
+         {"connect", "c", "", {hostArg, ArgSpec::makeFlagArg("verbose")}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      VERIFY(ac.all("connect -host be") ==
+                std::vector<std::string>({"connect -host beta", "connect -host beta2"}),
+             caseLabel);
+      ac.reset();
+      VERIFY(ac.all("c -h ").size() == 3, caseLabel);
+      // Labels are completed after the values.
+      ac.reset();
+      VERIFY(ac.all("connect -host alpha -v") ==
+                std::vector<std::string>{"connect -host alpha -verbose"},
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "AutoCompletion::all for values of positional arguments";
+      ArgSpec fromArg = ArgSpec::makePositionalArg(1);
+      fromArg.setCompletionProvider(makeProvider({"src"}));
+      ArgSpec toArg = ArgSpec::makePositionalArg(1);
+      toArg.setCompletionProvider(makeProvider({"dest"}));
+      std::set<CmdSpec> specs = {{"copy", "", "", {fromArg, toArg}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      VERIFY(ac.all("copy ") == std::vector<std::string>{"copy src"}, caseLabel);
+      ac.reset();
+      VERIFY(ac.all("copy src ") == std::vector<std::string>{"copy src dest"}, caseLabel);
+      ac.reset();
+      VERIFY(ac.all("copy src dest ").empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "AutoCompletion::all for enum value";
+      std::set<CmdSpec> specs = {
+         {"paint",
+          "",
+          "",
+          {ArgSpec::makeOptionalArg("color", 1, "c", "",
+                                    ValueType::makeEnum({"Red", "Green", "Rose"}))},
+          ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      VERIFY(ac.all("paint -color R") ==
+                std::vector<std::string>({"paint -color red", "paint -color rose"}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "AutoCompletion::all for value of argument without completion";
+      std::set<CmdSpec> specs = {
+         {"resize", "", "", {ArgSpec::makeOptionalArg("width", 1, "w")}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      VERIFY(ac.all("resize -width 1").empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "AutoCompletion::all for value whose completions are pending";
+      ThreadPool workers{2};
+      auto provider = std::make_shared<AsyncValueCompletionProvider>(
+         workers, [](const std::string&, const CancellationToken&) {
+            return std::vector<std::string>{"later"};
+         },
+         std::chrono::milliseconds{0});
+      ArgSpec arg = ArgSpec::makePositionalArg(1);
+      arg.setCompletionProvider(provider);
+      std::set<CmdSpec> specs = {{"wait", "", "", {arg}, ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      VERIFY(ac.all("wait l").empty(), caseLabel);
+      provider->waitUntilIdle();
+      // Completes again without a reset, because the completions were pending.
+      VERIFY(ac.all("wait l") == std::vector<std::string>{"wait later"}, caseLabel);
+   }
+}
+
 } // namespace
 
 
@@ -213,4 +507,9 @@ void testAutoCompletion()
    testAutoCompletionNext();
    testAutoCompletionAll();
    testAutoCompletionReset();
+   testAutoCompletionAddCmd();
+   testAutoCompletionAbbreviations();
+   testAutoCompletionFuzzyMode();
+   testAutoCompletionNarrowing();
+   testAutoCompletionArgValues();
 }
@@ -149,6 +149,23 @@ void testBlackboardAppendLine()
 }
 
 
+void testBlackboardInsertOutputLine()
+{
+   {
+      const std::string caseLabel = "Blackboard::insertOutputLine";
+      Blackboard board{StdPrompt};
+      board.setEnteredInputText("typing");
+      board.insertOutputLine("line 1");
+      board.insertOutputLine("line 2");
+      VERIFY(board.countLines() == 3, caseLabel);
+      VERIFY(board.lineText(0) == "line 1", caseLabel);
+      VERIFY(board.lineText(1) == "line 2", caseLabel);
+      VERIFY(!board.isEnteredLine(1), caseLabel);
+      VERIFY(board.enteredInputText() == "typing", caseLabel);
+   }
+}
+
+
 void testBlackboardInputLineText()
 {
    {
@@ -376,6 +393,7 @@ void testBlackboard()
    testBlackboardLineText();
    testBlackboardIsEnteredLine();
    testBlackboardAppendLine();
+   testBlackboardInsertOutputLine();
    testBlackboardInputLineText();
    testBlackboardEnteredInputText();
    testBlackboardSetInputLine();
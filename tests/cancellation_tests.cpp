@@ -0,0 +1,200 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "cancellation_tests.h"
+#include "cancellation.h"
+#include "test_util.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void testCancellationTokenDefaultCtor()
+{
+   {
+      const std::string caseLabel = "CancellationToken default ctor is never cancelled";
+      CancellationToken token;
+      VERIFY(!token.isCancelled(), caseLabel);
+      VERIFY(token.reason() == CancelReason::None, caseLabel);
+   }
+}
+
+
+void testCancellationSourceCancel()
+{
+   {
+      const std::string caseLabel = "CancellationSource::cancel cancels tokens";
+      CancellationSource source;
+      CancellationToken token = source.token();
+      VERIFY(!token.isCancelled(), caseLabel);
+
+      source.cancel();
+
+      VERIFY(token.isCancelled(), caseLabel);
+      VERIFY(token.reason() == CancelReason::Cancelled, caseLabel);
+      VERIFY(source.isCancelled(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CancellationSource::cancel for copied source";
+      CancellationSource source;
+      CancellationSource copy = source;
+      copy.cancel();
+      VERIFY(source.token().isCancelled(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CancellationSource::cancel for other source";
+      CancellationSource source;
+      CancellationSource other;
+      other.cancel();
+      VERIFY(!source.token().isCancelled(), caseLabel);
+   }
+}
+
+
+void testCancellationSourceCancelAfter()
+{
+   {
+      const std::string caseLabel = "CancellationSource::cancelAfter for passed timeout";
+      CancellationSource source;
+      source.cancelAfter(std::chrono::milliseconds{0});
+      VERIFY(source.token().reason() == CancelReason::TimedOut, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CancellationSource::cancelAfter for future timeout";
+      CancellationSource source;
+      source.cancelAfter(std::chrono::hours{1});
+      VERIFY(!source.token().isCancelled(), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "CancellationSource::cancelAfter keeps earlier explicit cancellation";
+      CancellationSource source;
+      source.cancel();
+      source.cancelAfter(std::chrono::milliseconds{0});
+      VERIFY(source.token().reason() == CancelReason::Cancelled, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "CancellationSource::cancel keeps earlier timeout";
+      CancellationSource source;
+      source.cancelAfter(std::chrono::milliseconds{0});
+      VERIFY(source.token().reason() == CancelReason::TimedOut, caseLabel);
+      source.cancel();
+      VERIFY(source.token().reason() == CancelReason::TimedOut, caseLabel);
+   }
+}
+
+
+void testWaitUnlessCancelled()
+{
+   {
+      const std::string caseLabel = "waitUnlessCancelled for satisfied predicate";
+      std::mutex mutex;
+      std::condition_variable cv;
+      CancellationSource source;
+      std::unique_lock lock{mutex};
+      VERIFY(waitUnlessCancelled(cv, lock, source.token(), []() { return true; }),
+             caseLabel);
+      VERIFY(lock.owns_lock(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "waitUnlessCancelled wakes when the predicate holds";
+      std::mutex mutex;
+      std::condition_variable cv;
+      bool isReady = false;
+      CancellationSource source;
+
+      std::thread notifier{[&]() {
+         {
+            std::scoped_lock lock{mutex};
+            isReady = true;
+         }
+         cv.notify_all();
+      }};
+
+      std::unique_lock lock{mutex};
+      VERIFY(waitUnlessCancelled(cv, lock, source.token(), [&]() { return isReady; }),
+             caseLabel);
+      lock.unlock();
+      notifier.join();
+   }
+   {
+      const std::string caseLabel = "waitUnlessCancelled wakes when cancelled";
+      std::mutex mutex;
+      std::condition_variable cv;
+      CancellationSource source;
+
+      std::thread canceller{[&]() { source.cancel(); }};
+
+      std::unique_lock lock{mutex};
+      VERIFY(!waitUnlessCancelled(cv, lock, source.token(), []() { return false; }),
+             caseLabel);
+      VERIFY(lock.owns_lock(), caseLabel);
+      lock.unlock();
+      canceller.join();
+   }
+   {
+      const std::string caseLabel = "waitUnlessCancelled wakes when timed out";
+      std::mutex mutex;
+      std::condition_variable cv;
+      CancellationSource source;
+      source.cancelAfter(std::chrono::milliseconds{5});
+
+      std::unique_lock lock{mutex};
+      VERIFY(!waitUnlessCancelled(cv, lock, source.token(), []() { return false; }),
+             caseLabel);
+      VERIFY(source.token().reason() == CancelReason::TimedOut, caseLabel);
+   }
+   {
+      const std::string caseLabel = "waitUnlessCancelled wakes at the given time";
+      std::mutex mutex;
+      std::condition_variable cv;
+      const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds{5};
+
+      std::unique_lock lock{mutex};
+      VERIFY(!waitUnlessCancelled(cv, lock, CancellationToken{}, until,
+                                  []() { return false; }),
+             caseLabel);
+      VERIFY(std::chrono::steady_clock::now() >= until, caseLabel);
+   }
+}
+
+
+void testCancelledError()
+{
+   {
+      const std::string caseLabel = "CancelledError for cancellation";
+      const CancelledError err{CancelReason::Cancelled};
+      VERIFY(err.reason() == CancelReason::Cancelled, caseLabel);
+      VERIFY(std::string{err.what()} == "Cancelled.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "CancelledError for timeout";
+      const CancelledError err{CancelReason::TimedOut};
+      VERIFY(err.reason() == CancelReason::TimedOut, caseLabel);
+      VERIFY(std::string{err.what()} == "Timed out.", caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testCancellation()
+{
+   testCancellationTokenDefaultCtor();
+   testCancellationSourceCancel();
+   testCancellationSourceCancelAfter();
+   testWaitUnlessCancelled();
+   testCancelledError();
+}
@@ -6,12 +6,30 @@
 //
 #include "auto_completion_tests.h"
 #include "blackboard_tests.h"
+#include "cancellation_tests.h"
+#include "cmd_arena_tests.h"
+#include "cmd_binding_tests.h"
 #include "cmd_depot_tests.h"
 #include "cmd_parser_tests.h"
 #include "cmd_spec_tests.h"
+#include "completion_index_tests.h"
+#include "concurrent_queue_tests.h"
+#include "console_tests.h"
 #include "console_util_tests.h"
 #include "formatting_tests.h"
+#include "fuzzy_index_tests.h"
+#include "interactive_cmd_tests.h"
+#include "jobs_tests.h"
+#include "output_sink_tests.h"
+#include "path_completion_tests.h"
 #include "preferences_tests.h"
+#include "result_cache_tests.h"
+#include "ring_buffer_tests.h"
+#include "script_parser_tests.h"
+#include "static_cmd_spec_tests.h"
+#include "symbol_table_tests.h"
+#include "thread_pool_tests.h"
+#include "value_completion_tests.h"
 #include <cstdlib>
 #include <iostream>
 
@@ -20,12 +38,30 @@ int main()
 {
    testAutoCompletion();
    testBlackboard();
+   testCancellation();
+   testCmdArena();
+   testCmdBinding();
    testCmdDepot();
    testCmdParser();
    testCmdSpec();
+   testCompletionIndex();
+   testConcurrentQueue();
+   testConsole();
    testConsoleUtil();
    testFormatting();
+   testFuzzyIndex();
+   testInteractiveCmd();
+   testJobs();
+   testOutputSink();
+   testPathCompletion();
    testPreferences();
+   testResultCache();
+   testRingBuffer();
+   testScriptParser();
+   testStaticCmdSpec();
+   testSymbolTable();
+   testThreadPool();
+   testValueCompletion();
 
    std::cout << "ccon tests finished.\n";
    return EXIT_SUCCESS;
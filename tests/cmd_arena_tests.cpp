@@ -0,0 +1,145 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "cmd_arena_tests.h"
+#include "cmd_arena.h"
+#include "cmd_depot.h"
+#include "console.h"
+#include "console_ui.h"
+#include "console_util.h"
+#include "test_util.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+struct NullConsoleUI : public ConsoleUI
+{
+   void setContent(ConsoleContent*) override {}
+   void showConsole() override {}
+   void hideConsole() override {}
+   void setBackgroundColor(const sutil::Rgb&) override {}
+   void setOutputTextColor(const sutil::Rgb&) override {}
+   void setInputTextColor(const sutil::Rgb&) override {}
+   void resetColors() override {}
+   void setFontSize(int) override {}
+   void notifyPendingOutput() override {}
+};
+
+
+struct EchoCmd : public Cmd
+{
+   CmdOutput execute(const VerifiedCmd& input) override { return {input.args[0].values[0]}; }
+};
+
+
+CmdSpec makeEchoCmdSpec()
+{
+   return {"echo",
+           "e",
+           "",
+           {ArgSpec::makePositionalArg(2), ArgSpec::makeFlagArg("verbose", "v"),
+            ArgSpec::makeOptionalArg("size", 1, "s", "", ValueKind::Int)},
+           ""};
+}
+
+
+void testCmdArenaRelease()
+{
+   {
+      const std::string caseLabel = "CmdArena reuses its memory after release";
+      CmdArena arena;
+      void* first = arena.resource()->allocate(64);
+      arena.release();
+      void* second = arena.resource()->allocate(64);
+      VERIFY(first == second, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdArena for allocations beyond inline buffer";
+      CmdArena arena;
+      void* mem = arena.resource()->allocate(CmdArena::InlineSize * 2);
+      VERIFY(mem != nullptr, caseLabel);
+      arena.release();
+   }
+}
+
+
+void testCmdArenaMatchWithoutHeapAllocations()
+{
+   {
+      const std::string caseLabel = "Matching command lines in arena makes no heap allocations";
+      CmdDepot depot;
+      depot.addCommand(makeEchoCmdSpec(), []() { return std::make_unique<EchoCmd>(); });
+      const std::string cmdLine = "echo first second -v --size 10";
+
+      CmdArena arena;
+      std::size_t numAllocs = 0;
+      bool areAllValid = true;
+      for (int i = 0; i < 10; ++i)
+      {
+         const std::size_t allocsBefore = countHeapAllocations();
+         {
+            const CmdArgViews cmdPieces = splitCmdLine(cmdLine, arena.resource());
+            const CmdSpec::MatchView match = depot.matchCommand(cmdPieces);
+            areAllValid = areAllValid && match.areArgsValid;
+         }
+         arena.release();
+         numAllocs = countHeapAllocations() - allocsBefore;
+      }
+
+      VERIFY(areAllValid, caseLabel);
+      VERIFY(numAllocs == 0, caseLabel);
+   }
+}
+
+
+void testConsoleSteadyStateAllocations()
+{
+   {
+      const std::string caseLabel =
+         "Processing a command line makes a bounded number of heap allocations";
+      NullConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeEchoCmdSpec(), []() { return std::make_unique<EchoCmd>(); });
+
+      auto countAllocsForLine = [&console](const std::string& cmdLine) {
+         const std::size_t allocsBefore = countHeapAllocations();
+         console.setInputLine(cmdLine);
+         console.processInputLine();
+         console.waitForCommands();
+         return countHeapAllocations() - allocsBefore;
+      };
+
+      // Warm up.
+      countAllocsForLine("echo first second -v --size 10");
+
+      std::size_t maxAllocs = 0;
+      for (int i = 0; i < 100; ++i)
+         maxAllocs = std::max(maxAllocs, countAllocsForLine("echo first second -v --size 10"));
+
+      // The remaining allocations are for the command's owning input, its instance,
+      // its output and for recording the lines in the console's history. The bound
+      // leaves room for the bookkeeping of checked containers in debug builds.
+      VERIFY(maxAllocs <= 32, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testCmdArena()
+{
+   testCmdArenaRelease();
+   testCmdArenaMatchWithoutHeapAllocations();
+   testConsoleSteadyStateAllocations();
+}
@@ -0,0 +1,148 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "cmd_binding_tests.h"
+#include "cmd_binding.h"
+#include "cmd_depot.h"
+#include "test_util.h"
+#include <optional>
+#include <string>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+CmdOutput resize(int width, const std::string& unit, std::optional<int> height,
+                 std::optional<sutil::Rgb> color, bool keepRatio)
+{
+   return {std::to_string(width) + unit, height ? std::to_string(*height) : "none",
+           color ? std::to_string(color->r) : "none", keepRatio ? "keep" : "free"};
+}
+
+
+std::string greet(const std::string& name)
+{
+   return "Hello " + name;
+}
+
+
+int numResets = 0;
+
+void reset()
+{
+   ++numResets;
+}
+
+
+CmdOutput runBoundCmd(const BoundCmd& bound, const std::string& cmdLine)
+{
+   CmdSpec::Match match = bound.spec.match(cmdLine);
+   if (!match.areArgsValid)
+      return {"invalid"};
+   return bound.factory()->execute(match.matchedCmd);
+}
+
+
+void testBindCommandSpec()
+{
+   {
+      const std::string caseLabel = "bindCommand derives arg specs from parameter types";
+      const BoundCmd bound = bindCommand<&resize>("resize", "r", "resizes",
+                                                  {{"", "", "width"},
+                                                   {"", "", "unit"},
+                                                   {"height", "h", "the height"},
+                                                   {"color", "c", "the color"},
+                                                   {"keep", "k", "keep ratio"}});
+
+      VERIFY(bound.spec.name() == "resize", caseLabel);
+      VERIFY(bound.spec.abbreviation() == "r", caseLabel);
+      VERIFY(bound.spec.end() - bound.spec.begin() == 5, caseLabel);
+
+      auto argSpec = bound.spec.begin();
+      VERIFY(argSpec->isRequired(), caseLabel);
+      VERIFY(argSpec->valueType().kind() == ValueKind::Int, caseLabel);
+      ++argSpec;
+      VERIFY(argSpec->isRequired(), caseLabel);
+      VERIFY(argSpec->valueType().isText(), caseLabel);
+      ++argSpec;
+      VERIFY(!argSpec->isRequired(), caseLabel);
+      VERIFY(argSpec->label() == "height", caseLabel);
+      VERIFY(argSpec->valueType().kind() == ValueKind::Int, caseLabel);
+      ++argSpec;
+      VERIFY(argSpec->valueType().kind() == ValueKind::HexColor, caseLabel);
+      ++argSpec;
+      VERIFY(!argSpec->isRequired(), caseLabel);
+      VERIFY(argSpec->label() == "keep", caseLabel);
+   }
+   {
+      const std::string caseLabel = "bindCommand for function without parameters";
+      const BoundCmd bound = bindCommand<&reset>("reset", "", "resets");
+      VERIFY(bound.spec.begin() == bound.spec.end(), caseLabel);
+   }
+}
+
+
+void testBindCommandExecute()
+{
+   const BoundCmd bound = bindCommand<&resize>("resize", "r", "resizes",
+                                               {{"", "", "width"},
+                                                {"", "", "unit"},
+                                                {"height", "h", "the height"},
+                                                {"color", "c", "the color"},
+                                                {"keep", "k", "keep ratio"}});
+   {
+      const std::string caseLabel = "Bound command with only positional args";
+      const CmdOutput out = runBoundCmd(bound, "resize 10 px");
+      VERIFY(out == CmdOutput({"10px", "none", "none", "free"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Bound command with all args";
+      const CmdOutput out = runBoundCmd(bound, "resize 10 px -k -c 0a0000 --height 20");
+      VERIFY(out == CmdOutput({"10px", "20", "10", "keep"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Bound command with invalid value";
+      const CmdOutput out = runBoundCmd(bound, "resize 10 px -h high");
+      VERIFY(out == CmdOutput({"invalid"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Bound command returning a string";
+      const BoundCmd greetCmd = bindCommand<&greet>("greet", "g", "", {{"", "", "name"}});
+      const CmdOutput out = runBoundCmd(greetCmd, "greet you");
+      VERIFY(out == CmdOutput({"Hello you"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Bound command returning nothing";
+      const BoundCmd resetCmd = bindCommand<&reset>("reset", "", "");
+      numResets = 0;
+      const CmdOutput out = runBoundCmd(resetCmd, "reset");
+      VERIFY(out.empty(), caseLabel);
+      VERIFY(numResets == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Bound command added to depot";
+      CmdDepot depot;
+      const BoundCmd greetCmd = bindCommand<&greet>("greet", "g", "", {{"", "", "name"}});
+      depot.addCommand(greetCmd.spec, greetCmd.factory);
+
+      const CmdSpec::Match match = depot.matchCommand("g me");
+      VERIFY(match.areArgsValid, caseLabel);
+      const CmdOutput out = depot.makeCommand("greet")->execute(match.matchedCmd);
+      VERIFY(out == CmdOutput({"Hello me"}), caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testCmdBinding()
+{
+   testBindCommandSpec();
+   testBindCommandExecute();
+}
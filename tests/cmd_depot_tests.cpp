@@ -7,12 +7,18 @@
 #include "cmd_depot_tests.h"
 #include "cmd_depot.h"
 #include "cmd_spec.h"
+#include "interactive_cmd.h"
 #include "test_util.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 using namespace ccon;
 
@@ -23,10 +29,97 @@ namespace
 
 struct TestCmd : public Cmd
 {
-   CmdOutput execute(const VerifiedCmd& input) override { return {"done"}; }
+   CmdOutput execute(const VerifiedCmd& /*input*/) override { return {"done"}; }
 };
 
 
+// Counts its executions and how many executions are in progress at the same time.
+class CountingCmd : public StreamingCmd
+{
+ public:
+   struct Counters
+   {
+      std::atomic<int> numExecuting = 0;
+      std::atomic<int> maxExecuting = 0;
+   };
+
+ public:
+   explicit CountingCmd(Counters* counters) : m_counters{counters} {}
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd&, OutputSink& out) override
+   {
+      const int numExecuting = ++m_counters->numExecuting;
+      int maxExecuting = m_counters->maxExecuting;
+      while (numExecuting > maxExecuting &&
+             !m_counters->maxExecuting.compare_exchange_weak(maxExecuting, numExecuting))
+         ;
+      std::this_thread::sleep_for(std::chrono::milliseconds{5});
+      --m_counters->numExecuting;
+
+      ++m_numExecutions;
+      out.writeLine(std::to_string(m_numExecutions));
+   }
+
+ private:
+   Counters* m_counters;
+   int m_numExecutions = 0;
+};
+
+
+// Executes until it is released.
+class GatedCmd : public StreamingCmd
+{
+ public:
+   GatedCmd(std::atomic<bool>* isStarted, const std::atomic<bool>* isReleased)
+   : m_isStarted{isStarted}, m_isReleased{isReleased}
+   {
+   }
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd&, OutputSink& out) override
+   {
+      *m_isStarted = true;
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+      while (!*m_isReleased && std::chrono::steady_clock::now() < deadline)
+         std::this_thread::yield();
+      out.writeLine("released");
+   }
+
+ private:
+   std::atomic<bool>* m_isStarted;
+   const std::atomic<bool>* m_isReleased;
+};
+
+
+struct FailingCmd : public Cmd
+{
+   CmdOutput execute(const VerifiedCmd&) override { throw std::runtime_error{"boom"}; }
+};
+
+
+struct UiCmd : public Cmd
+{
+   CmdOutput execute(const VerifiedCmd&) override { return {"done"}; }
+   CmdThreadAffinity threadAffinity() const override { return CmdThreadAffinity::UIThread; }
+};
+
+
+struct StepCmd : public InteractiveCmd
+{
+   CmdStep start(const VerifiedCmd&, OutputSink&) override { return CmdStep::Done; }
+};
+
+
+std::string executeCmd(Cmd& cmd, const CancellationToken& cancellation = {})
+{
+   CollectingOutputSink out;
+   out.setCancellation(cancellation);
+   cmd.execute(VerifiedCmd{}, out);
+   return out.lines().empty() ? "" : out.lines().back();
+}
+
+
 template <typename Iter> bool haveCommand(Iter b, Iter e, const std::string& name)
 {
    static_assert(std::is_same_v<typename Iter::value_type, CmdSpec>);
@@ -91,6 +184,126 @@ void testCmdDepotAddCommand()
 }
 
 
+void testCmdDepotFindCommand()
+{
+   {
+      const std::string caseLabel = "CmdDepot::findCommand for command name";
+      const CmdSpec spec1{"cmd1", "c1", "", {}, ""};
+      const CmdSpec spec2{"cmd2", "c2", "", {}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec1, cmdFactory);
+      depot.addCommand(spec2, cmdFactory);
+
+      const CmdSpec* found = depot.findCommand("cmd2");
+
+      VERIFY(found != nullptr, caseLabel);
+      VERIFY(found && found->name() == "cmd2", caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot::findCommand for command abbreviation";
+      const CmdSpec spec1{"cmd1", "c1", "", {}, ""};
+      const CmdSpec spec2{"cmd2", "c2", "", {}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec1, cmdFactory);
+      depot.addCommand(spec2, cmdFactory);
+
+      const CmdSpec* found = depot.findCommand("c1");
+
+      VERIFY(found && found->name() == "cmd1", caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot::findCommand for different case";
+      const CmdSpec spec{"cmd1", "c1", "", {}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec, cmdFactory);
+
+      const CmdSpec* found = depot.findCommand("CMD1");
+
+      VERIFY(found && found->name() == "cmd1", caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot::findCommand for not existing command";
+      const CmdSpec spec{"cmd1", "c1", "", {}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec, cmdFactory);
+
+      VERIFY(depot.findCommand("cmd2") == nullptr, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "CmdDepot::findCommand for name that is also another command's abbreviation";
+      const CmdSpec spec1{"cmd1", "x", "", {}, ""};
+      const CmdSpec spec2{"x", "", "", {}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec1, cmdFactory);
+      depot.addCommand(spec2, cmdFactory);
+
+      const CmdSpec* found = depot.findCommand("x");
+
+      VERIFY(found && found->name() == "x", caseLabel);
+   }
+}
+
+
+void testCmdDepotMatchCommand()
+{
+   {
+      const std::string caseLabel = "CmdDepot::matchCommand for valid command line";
+      const CmdSpec spec1{"cmd1", "c1", "", {ArgSpec::makeOptionalArg("size", 1)}, ""};
+      const CmdSpec spec2{"cmd2", "c2", "", {}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec1, cmdFactory);
+      depot.addCommand(spec2, cmdFactory);
+
+      const CmdSpec::Match res = depot.matchCommand("c1 -size 10");
+
+      VERIFY(res.isMatching, caseLabel);
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.name == "cmd1", caseLabel);
+      VERIFY(res.matchedCmd.args.size() == 1, caseLabel);
+      VERIFY(res.matchedCmd.args[0].values[0] == "10", caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot::matchCommand for invalid arguments";
+      const CmdSpec spec{"cmd1", "c1", "", {ArgSpec::makeOptionalArg("size", 1)}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec, cmdFactory);
+
+      const CmdSpec::Match res = depot.matchCommand("cmd1 -other");
+
+      VERIFY(res.isMatching, caseLabel);
+      VERIFY(!res.areArgsValid, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot::matchCommand for unknown command";
+      const CmdSpec spec{"cmd1", "c1", "", {}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec, cmdFactory);
+
+      const CmdSpec::Match res = depot.matchCommand("cmd2");
+
+      VERIFY(!res.isMatching, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot::matchCommand for empty command line";
+      const CmdSpec spec{"cmd1", "c1", "", {}, ""};
+      auto cmdFactory = []() { return std::unique_ptr<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec, cmdFactory);
+
+      VERIFY(!depot.matchCommand("").isMatching, caseLabel);
+   }
+}
+
+
 void testCmdDepotMakeCommand()
 {
    {
@@ -119,6 +332,259 @@ void testCmdDepotMakeCommand()
 }
 
 
+void testCmdDepotCopy()
+{
+   {
+      const std::string caseLabel = "CmdDepot copy finds and makes the same commands";
+      const CmdSpec spec1{"cmd1", "c", "", {}, ""};
+      const CmdSpec spec2{"cmd2", "c", "", {}, ""};
+      auto cmdFactory = []() { return std::make_unique<TestCmd>(); };
+      auto depot = std::make_unique<CmdDepot>();
+      depot->addCommand(spec1, cmdFactory);
+      depot->addCommand(spec2, cmdFactory);
+
+      const CmdDepot copy{*depot};
+      depot.reset();
+
+      VERIFY(copy.availableCommands().size() == 2, caseLabel);
+      const CmdSpec* found = copy.findCommand("cmd2");
+      VERIFY(found && found->name() == "cmd2", caseLabel);
+      // The abbreviation still belongs to the command that was added first.
+      found = copy.findCommand("c");
+      VERIFY(found && found->name() == "cmd1", caseLabel);
+      VERIFY(copy.makeCommand("cmd1") != nullptr, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot copy is independent of the original";
+      const CmdSpec spec1{"cmd1", "c1", "", {}, ""};
+      const CmdSpec spec2{"cmd2", "c2", "", {}, ""};
+      auto cmdFactory = []() { return std::make_unique<TestCmd>(); };
+      CmdDepot depot;
+      depot.addCommand(spec1, cmdFactory);
+
+      CmdDepot copy;
+      copy = depot;
+      depot.addCommand(spec2, cmdFactory);
+
+      VERIFY(copy.findCommand("cmd2") == nullptr, caseLabel);
+      VERIFY(depot.findCommand("cmd2") != nullptr, caseLabel);
+   }
+}
+
+
+void testCmdDepotLifetimes()
+{
+   {
+      const std::string caseLabel = "CmdDepot creates command for each invocation";
+      int numCreated = 0;
+      CountingCmd::Counters counters;
+      CmdDepot depot;
+      depot.addCommand(CmdSpec{"cmd", "", "", {}, ""}, [&]() {
+         ++numCreated;
+         return std::make_unique<CountingCmd>(&counters);
+      });
+
+      VERIFY(executeCmd(*depot.makeCommand("cmd")) == "1", caseLabel);
+      VERIFY(executeCmd(*depot.makeCommand("cmd")) == "1", caseLabel);
+      VERIFY(numCreated == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot reuses singleton command";
+      int numCreated = 0;
+      CountingCmd::Counters counters;
+      CmdDepot depot;
+      depot.addCommand(
+         CmdSpec{"cmd", "", "", {}, ""},
+         [&]() {
+            ++numCreated;
+            return std::make_unique<CountingCmd>(&counters);
+         },
+         CmdLifetime::Singleton);
+
+      VERIFY(executeCmd(*depot.makeCommand("cmd")) == "1", caseLabel);
+      VERIFY(executeCmd(*depot.makeCommand("cmd")) == "2", caseLabel);
+      // Copies of the depot share the instance.
+      const CmdDepot copy{depot};
+      VERIFY(executeCmd(*copy.makeCommand("cmd")) == "3", caseLabel);
+      VERIFY(numCreated == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot limits concurrent executions of pooled "
+                                    "command";
+      std::atomic<int> numCreated = 0;
+      CountingCmd::Counters counters;
+      CmdDepot depot;
+      depot.addCommand(
+         CmdSpec{"cmd", "", "", {}, ""},
+         [&]() {
+            ++numCreated;
+            return std::make_unique<CountingCmd>(&counters);
+         },
+         CmdLifetime::Pooled, 2);
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < 6; ++i)
+         threads.emplace_back([&depot]() {
+            for (int j = 0; j < 5; ++j)
+               executeCmd(*depot.makeCommand("cmd"));
+         });
+      for (std::thread& thread : threads)
+         thread.join();
+
+      VERIFY(numCreated <= 2, caseLabel);
+      VERIFY(counters.maxExecuting <= 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot discards reused command that failed";
+      int numCreated = 0;
+      CmdDepot depot;
+      depot.addCommand(
+         CmdSpec{"cmd", "", "", {}, ""},
+         [&]() {
+            ++numCreated;
+            return std::make_unique<FailingCmd>();
+         },
+         CmdLifetime::Singleton);
+
+      for (int i = 0; i < 2; ++i)
+      {
+         bool hasThrown = false;
+         try
+         {
+            executeCmd(*depot.makeCommand("cmd"));
+         }
+         catch (const std::runtime_error&)
+         {
+            hasThrown = true;
+         }
+         VERIFY(hasThrown, caseLabel);
+      }
+      VERIFY(numCreated == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot stops waiting for reused command when "
+                                    "cancelled";
+      std::atomic<bool> isStarted = false;
+      std::atomic<bool> isReleased = false;
+      CmdDepot depot;
+      depot.addCommand(
+         CmdSpec{"cmd", "", "", {}, ""},
+         [&]() { return std::make_unique<GatedCmd>(&isStarted, &isReleased); },
+         CmdLifetime::Singleton);
+
+      // Keep the only instance busy.
+      std::thread executing{[&depot]() { executeCmd(*depot.makeCommand("cmd")); }};
+      while (!isStarted)
+         std::this_thread::yield();
+
+      CancellationSource cancellation;
+      cancellation.cancel();
+      const std::string output =
+         executeCmd(*depot.makeCommand("cmd"), cancellation.token());
+
+      isReleased = true;
+      executing.join();
+      VERIFY(output.empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot knows thread affinity of reused command "
+                                    "while its instance is borrowed";
+      std::atomic<bool> isStarted = false;
+      std::atomic<bool> isReleased = false;
+      int numCreated = 0;
+      CmdDepot depot;
+      depot.addCommand(
+         CmdSpec{"ui", "", "", {}, ""},
+         [&]() {
+            ++numCreated;
+            return std::make_unique<UiCmd>();
+         },
+         CmdLifetime::Singleton);
+      depot.addCommand(
+         CmdSpec{"cmd", "", "", {}, ""},
+         [&]() { return std::make_unique<GatedCmd>(&isStarted, &isReleased); },
+         CmdLifetime::Singleton);
+      // Instantiated when added.
+      VERIFY(numCreated == 1, caseLabel);
+
+      // Keep the only instance busy.
+      std::thread executing{[&depot]() { executeCmd(*depot.makeCommand("cmd")); }};
+      while (!isStarted)
+         std::this_thread::yield();
+      const CmdThreadAffinity affinity = depot.makeCommand("cmd")->threadAffinity();
+
+      isReleased = true;
+      executing.join();
+      VERIFY(affinity == CmdThreadAffinity::Any, caseLabel);
+      VERIFY(depot.makeCommand("ui")->threadAffinity() == CmdThreadAffinity::UIThread,
+             caseLabel);
+      VERIFY(numCreated == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot rejects reused interactive command";
+      for (const CmdLifetime lifetime : {CmdLifetime::Singleton, CmdLifetime::Pooled})
+      {
+         CmdDepot depot;
+         bool hasThrown = false;
+         try
+         {
+            depot.addCommand(CmdSpec{"step", "", "", {}, ""},
+                             []() { return std::make_unique<StepCmd>(); }, lifetime, 2);
+         }
+         catch (const std::invalid_argument&)
+         {
+            hasThrown = true;
+         }
+         VERIFY(hasThrown, caseLabel);
+         VERIFY(!depot.findCommand("step"), caseLabel);
+      }
+   }
+   {
+      const std::string caseLabel = "CmdDepot ignores reused command that exists";
+      CmdDepot depot;
+      depot.addCommand(CmdSpec{"cmd", "", "", {}, ""},
+                       []() { return std::make_unique<TestCmd>(); });
+      std::size_t numCreated = 0;
+
+      depot.addCommand(
+         CmdSpec{"cmd", "", "", {}, ""},
+         [&numCreated]() {
+            ++numCreated;
+            return std::unique_ptr<Cmd>{};
+         },
+         CmdLifetime::Pooled, 2);
+
+      VERIFY(numCreated == 0, caseLabel);
+      VERIFY(depot.findCommand("cmd") != nullptr, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot rejects pooled command without instances";
+      CmdDepot depot;
+      bool hasThrown = false;
+      try
+      {
+         depot.addCommand(CmdSpec{"cmd", "", "", {}, ""},
+                          []() { return std::make_unique<TestCmd>(); },
+                          CmdLifetime::Pooled, 0);
+      }
+      catch (const std::invalid_argument&)
+      {
+         hasThrown = true;
+      }
+      VERIFY(hasThrown, caseLabel);
+      VERIFY(!depot.findCommand("cmd"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdDepot accepts interactive command per invocation";
+      CmdDepot depot;
+      depot.addCommand(CmdSpec{"step", "", "", {}, ""},
+                       []() { return std::make_unique<StepCmd>(); },
+                       CmdLifetime::PerInvocation);
+      VERIFY(depot.findCommand("step") != nullptr, caseLabel);
+   }
+}
+
+
 void testCmdDepotGetCommandHelp()
 {
    {
@@ -151,6 +617,10 @@ void testCmdDepotGetCommandHelp()
 void testCmdDepot()
 {
    testCmdDepotAddCommand();
+   testCmdDepotFindCommand();
+   testCmdDepotMatchCommand();
    testCmdDepotMakeCommand();
+   testCmdDepotCopy();
+   testCmdDepotLifetimes();
    testCmdDepotGetCommandHelp();
 }
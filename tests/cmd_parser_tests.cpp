@@ -6,8 +6,10 @@
 //
 #include "cmd_parser_tests.h"
 #include "cmd_parser.h"
+#include "cmd_spec.h"
 #include "test_util.h"
 #include "essentutils/color.h"
+#include <filesystem>
 #include <string>
 
 using namespace ccon;
@@ -224,6 +226,105 @@ void testParseColorArg()
    }
 }
 
+
+
+void testParseArgValue()
+{
+   {
+      const std::string caseLabel = "parseArgValue for text";
+      const auto val = parseArgValue("abc", ValueKind::Text);
+      VERIFY(val.has_value() && std::get<std::string>(*val) == "abc", caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for integer";
+      const auto val = parseArgValue("-42", ValueKind::Int);
+      VERIFY(val.has_value() && std::get<int>(*val) == -42, caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for integer with plus sign";
+      const auto val = parseArgValue("+42", ValueKind::Int);
+      VERIFY(val.has_value() && std::get<int>(*val) == 42, caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for invalid integer";
+      VERIFY(!parseArgValue("42x", ValueKind::Int).has_value(), caseLabel);
+      VERIFY(!parseArgValue("", ValueKind::Int).has_value(), caseLabel);
+      VERIFY(!parseArgValue("+", ValueKind::Int).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for double";
+      const auto val = parseArgValue("2.5", ValueKind::Double);
+      VERIFY(val.has_value() && std::get<double>(*val) == 2.5, caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for invalid double";
+      VERIFY(!parseArgValue("2.5.1", ValueKind::Double).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for hex color";
+      const auto val = parseArgValue("a7993C", ValueKind::HexColor);
+      VERIFY(val.has_value() && std::get<sutil::Rgb>(*val) == sutil::Rgb(167, 153, 60),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for invalid hex color";
+      VERIFY(!parseArgValue("11220w", ValueKind::HexColor).has_value(), caseLabel);
+      VERIFY(!parseArgValue("1122", ValueKind::HexColor).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for enum";
+      const auto val = parseArgValue("Blue", ValueType::makeEnum({"red", "blue"}));
+      VERIFY(val.has_value() && std::get<std::string>(*val) == "blue", caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for invalid enum";
+      VERIFY(!parseArgValue("green", ValueType::makeEnum({"red", "blue"})).has_value(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for bool";
+      const auto yes = parseArgValue("Yes", ValueKind::Bool);
+      const auto off = parseArgValue("off", ValueKind::Bool);
+      VERIFY(yes.has_value() && std::get<bool>(*yes), caseLabel);
+      VERIFY(off.has_value() && !std::get<bool>(*off), caseLabel);
+      VERIFY(!parseArgValue("maybe", ValueKind::Bool).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "parseArgValue for path";
+      const auto val = parseArgValue("dir/file.txt", ValueKind::Path);
+      VERIFY(val.has_value() &&
+                std::get<std::filesystem::path>(*val) ==
+                   std::filesystem::path{"dir/file.txt"},
+             caseLabel);
+      VERIFY(!parseArgValue("", ValueKind::Path).has_value(), caseLabel);
+   }
+}
+
+
+void testArgValue()
+{
+   {
+      const std::string caseLabel = "argValue for typed value";
+      const VerifiedArg arg{"size", {"10"}, {ArgValue{10}}};
+      VERIFY(argValue<int>(arg) == 10, caseLabel);
+   }
+   {
+      const std::string caseLabel = "argValue for typed value of other type";
+      const VerifiedArg arg{"size", {"10"}, {ArgValue{10}}};
+      VERIFY(!argValue<double>(arg).has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "argValue for text value";
+      const VerifiedArg arg{"name", {"abc", "def"}};
+      VERIFY(argValue<std::string>(arg, 1) == "def", caseLabel);
+   }
+   {
+      const std::string caseLabel = "argValue for index out of range";
+      const VerifiedArg arg{"name", {"abc"}};
+      VERIFY(!argValue<std::string>(arg, 1).has_value(), caseLabel);
+   }
+}
+
 } // namespace
 
 
@@ -235,4 +336,6 @@ void testCmdParser()
    testFindArgWithLabel();
    testParseIntArg();
    testParseColorArg();
+   testParseArgValue();
+   testArgValue();
 }
@@ -6,8 +6,13 @@
 //
 #include "cmd_spec_tests.h"
 #include "cmd_spec.h"
+#include "console_util.h"
 #include "test_util.h"
+#include <chrono>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace ccon;
 
@@ -1146,6 +1151,55 @@ void testCmdSpecHelp()
       CmdSpec spec{"name", "n", "descr", {}, "searchableNotes"};
       VERIFY(spec.help().find("searchableNotes") != std::string::npos, caseLabel);
    }
+   {
+      const std::string caseLabel = "CmdSpec::help contains timeout";
+      CmdSpec spec{"name", "n", "descr", {}, "notes"};
+      spec.setTimeout(std::chrono::milliseconds{250});
+      VERIFY(spec.help().find("250 ms") != std::string::npos, caseLabel);
+   }
+}
+
+
+void testCmdSpecTimeout()
+{
+   {
+      const std::string caseLabel = "CmdSpec::timeout for spec without timeout";
+      CmdSpec spec{"name", "n", "descr", {}, "notes"};
+      VERIFY(!spec.timeout().has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::setTimeout";
+      CmdSpec spec{"name", "n", "descr", {}, "notes"};
+      spec.setTimeout(std::chrono::milliseconds{100});
+      VERIFY(spec.timeout() == std::chrono::milliseconds{100}, caseLabel);
+      spec.setTimeout(std::nullopt);
+      VERIFY(!spec.timeout().has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::setTimeout does not change copies";
+      CmdSpec spec{"name", "n", "descr", {}, "notes"};
+      const CmdSpec copy = spec;
+      spec.setTimeout(std::chrono::milliseconds{100});
+      VERIFY(!copy.timeout().has_value(), caseLabel);
+   }
+}
+
+
+void testCmdSpecPure()
+{
+   {
+      const std::string caseLabel = "CmdSpec::isPure for default spec";
+      CmdSpec spec{"name", "n", "descr", {}, "notes"};
+      VERIFY(!spec.isPure(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::setPure does not change copies";
+      CmdSpec spec{"name", "n", "descr", {}, "notes"};
+      const CmdSpec copy = spec;
+      spec.setPure(true);
+      VERIFY(spec.isPure(), caseLabel);
+      VERIFY(!copy.isPure(), caseLabel);
+   }
 }
 
 
@@ -1614,6 +1668,308 @@ void testCmdSpecMatch()
    }
 }
 
+
+
+void testCmdSpecMatchView()
+{
+   {
+      const std::string caseLabel = "CmdSpec::match view for command with args";
+      CmdSpec spec{"test",
+                   "t",
+                   "run a test",
+                   {ArgSpec::makePositionalArg(2), ArgSpec::makeOptionalArg("size", 1),
+                    ArgSpec::makeFlagArg("scan")},
+                   ""};
+      const std::string cmdLine = "TEST 1 2 --size 10 -scan";
+      const CmdArgViews words = splitCmdLine(cmdLine);
+
+      CmdSpec::MatchView res = spec.match(words);
+
+      VERIFY(res.isMatching, caseLabel);
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.name == "test", caseLabel);
+      VERIFY(res.matchedCmd.args.size() == 3, caseLabel);
+      VERIFY(res.matchedCmd.args[0].values.size() == 2, caseLabel);
+      VERIFY(res.matchedCmd.args[0].values[1] == "2", caseLabel);
+      VERIFY(res.matchedCmd.args[1].label == "size", caseLabel);
+      VERIFY(res.matchedCmd.args[1].values[0] == "10", caseLabel);
+      VERIFY(res.matchedCmd.args[2].label == "scan", caseLabel);
+      // Values refer to the command line text.
+      const char* valuePos = res.matchedCmd.args[1].values[0].data();
+      VERIFY(valuePos >= cmdLine.data() && valuePos < cmdLine.data() + cmdLine.size(),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match view for invalid args";
+      CmdSpec spec{"test", "t", "run a test", {ArgSpec::makePositionalArg(2)}, ""};
+
+      CmdSpec::MatchView res = spec.match(splitCmdLine("test 1"));
+
+      VERIFY(res.isMatching, caseLabel);
+      VERIFY(!res.areArgsValid, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match view for other command";
+      CmdSpec spec{"test", "t", "run a test", {}, ""};
+
+      CmdSpec::MatchView res = spec.match(splitCmdLine("toast"));
+
+      VERIFY(!res.isMatching, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match view converted to verified command";
+      CmdSpec spec{"test", "t", "", {ArgSpec::makeOptionalArg("size", 1, "s")}, ""};
+
+      CmdSpec::MatchView res = spec.match(splitCmdLine("t -s 10"));
+      const VerifiedCmd cmd = toVerifiedCmd(res.matchedCmd);
+
+      VERIFY(cmd.name == "test", caseLabel);
+      VERIFY(cmd.args.size() == 1, caseLabel);
+      VERIFY(cmd.args[0].label == "size", caseLabel);
+      VERIFY(cmd.args[0].values == std::vector<std::string>{"10"}, caseLabel);
+   }
+}
+
+
+
+void testCmdSpecMatchTypedValues()
+{
+   {
+      const std::string caseLabel = "CmdSpec::match converts typed values";
+      CmdSpec spec{"test",
+                   "t",
+                   "",
+                   {ArgSpec::makePositionalArg(1, "", ValueKind::Int),
+                    ArgSpec::makeOptionalArg("color", 1, "c", "", ValueKind::HexColor)},
+                   ""};
+
+      CmdSpec::Match res = spec.match("test 12 -c 0a0b0c");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.args.size() == 2, caseLabel);
+      VERIFY(res.matchedCmd.args[0].typedValues.size() == 1, caseLabel);
+      VERIFY(std::get<int>(res.matchedCmd.args[0].typedValues[0]) == 12, caseLabel);
+      VERIFY(std::get<sutil::Rgb>(res.matchedCmd.args[1].typedValues[0]) ==
+                sutil::Rgb(10, 11, 12),
+             caseLabel);
+      // The text of the values is still available.
+      VERIFY(res.matchedCmd.args[0].values[0] == "12", caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match - fail for invalid typed value";
+      CmdSpec spec{"test", "t", "", {ArgSpec::makePositionalArg(1, "", ValueKind::Int)}, ""};
+
+      CmdSpec::Match res = spec.match("test abc");
+
+      VERIFY(res.isMatching, caseLabel);
+      VERIFY(!res.areArgsValid, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match for negative int value";
+      CmdSpec spec{"test", "t", "", {ArgSpec::makePositionalArg(1, "", ValueKind::Int)}, ""};
+
+      CmdSpec::Match res = spec.match("test -5");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(std::get<int>(res.matchedCmd.args[0].typedValues[0]) == -5, caseLabel);
+      VERIFY(res.matchedCmd.args[0].values[0] == "-5", caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match for negative double values";
+      CmdSpec spec{"test",
+                   "t",
+                   "",
+                   {ArgSpec::makeOptionalArg("offset", 2, "o", "", ValueKind::Double),
+                    ArgSpec::makeFlagArg("flag", "f")},
+                   ""};
+
+      CmdSpec::Match res = spec.match("test -o -2.5 -.5 -f");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.args.size() == 2, caseLabel);
+      VERIFY(std::get<double>(res.matchedCmd.args[0].typedValues[0]) == -2.5, caseLabel);
+      VERIFY(std::get<double>(res.matchedCmd.args[0].typedValues[1]) == -0.5, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match for negative number as text value";
+      CmdSpec spec{"test", "t", "", {ArgSpec::makePositionalArg(1)}, ""};
+
+      // Text values keep treating words with dashes as labels.
+      CmdSpec::Match res = spec.match("test -5");
+
+      VERIFY(!res.areArgsValid, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match leaves text values unconverted";
+      CmdSpec spec{"test", "t", "", {ArgSpec::makePositionalArg(1)}, ""};
+
+      CmdSpec::Match res = spec.match("test abc");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.args[0].typedValues.empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "ArgSpec::help for typed values";
+      ArgSpec spec = ArgSpec::makeOptionalArg("mode", 1, "m", "the mode",
+                                              ValueType::makeEnum({"fast", "slow"}));
+      VERIFY(spec.help() == "Optional: -mode/-m + 1 value (one of: fast, slow) -- the mode",
+             caseLabel);
+   }
+}
+
+
+void testCmdSpecMatchSpecIndices()
+{
+   {
+      const std::string caseLabel = "CmdSpec::match stores the indices of matched specs";
+      CmdSpec spec{"test",
+                   "t",
+                   "",
+                   {ArgSpec::makePositionalArg(1), ArgSpec::makeFlagArg("first", "f"),
+                    ArgSpec::makeOptionalArg("second", 1, "s")},
+                   ""};
+
+      CmdSpec::Match res = spec.match("test a -s b -f");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.args.size() == 3, caseLabel);
+      VERIFY(res.matchedCmd.args[0].specIdx == 0, caseLabel);
+      VERIFY(res.matchedCmd.args[1].specIdx == 2, caseLabel);
+      VERIFY(res.matchedCmd.args[2].specIdx == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match for help argument";
+      CmdSpec spec{"test", "t", "", {ArgSpec::makePositionalArg(1)}, ""};
+
+      CmdSpec::Match res = spec.match("test -?");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.args[0].specIdx == NoArgSpecIdx, caseLabel);
+   }
+}
+
+
+void testCmdSpecMatchTimeoutArg()
+{
+   {
+      const std::string caseLabel = "CmdSpec::match common timeout argument";
+      CmdSpec spec{"test", "t", "", {ArgSpec::makePositionalArg(1)}, ""};
+
+      CmdSpec::Match res = spec.match("test a -timeout 50");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.args.size() == 2, caseLabel);
+      VERIFY(res.matchedCmd.args[1].specIdx == NoArgSpecIdx, caseLabel);
+      VERIFY(res.matchedCmd.args[1].labelId == TimeoutArgSpec.labelId(), caseLabel);
+      VERIFY(std::get<int>(res.matchedCmd.args[1].typedValues[0]) == 50, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match - fail for timeout without value";
+      CmdSpec spec{"test", "t", "", {}, ""};
+
+      CmdSpec::Match res = spec.match("test -timeout");
+
+      VERIFY(res.isMatching, caseLabel);
+      VERIFY(!res.areArgsValid, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match - fail for non-integer timeout";
+      CmdSpec spec{"test", "t", "", {}, ""};
+
+      CmdSpec::Match res = spec.match("test -timeout soon");
+
+      VERIFY(res.isMatching, caseLabel);
+      VERIFY(!res.areArgsValid, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::match prefers own timeout argument";
+      CmdSpec spec{"test", "t", "", {ArgSpec::makeOptionalArg("timeout", 1)}, ""};
+
+      CmdSpec::Match res = spec.match("test -timeout soon");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.args[0].specIdx == 0, caseLabel);
+      VERIFY(res.matchedCmd.args[0].values[0] == "soon", caseLabel);
+   }
+}
+
+
+void testCmdSpecFindOptionalArgSpec()
+{
+   const CmdSpec spec{"test",
+                      "t",
+                      "",
+                      {ArgSpec::makePositionalArg(1), ArgSpec::makeFlagArg("first", "f"),
+                       ArgSpec::makeOptionalArg("second", 1, "s")},
+                      ""};
+   {
+      const std::string caseLabel = "CmdSpec::findOptionalArgSpec for label";
+      VERIFY(spec.findOptionalArgSpec(findSymbol("second")) == spec.begin() + 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::findOptionalArgSpec for abbreviation";
+      VERIFY(spec.findOptionalArgSpec(findSymbol("f")) == spec.begin() + 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec::findOptionalArgSpec for unknown label";
+      VERIFY(spec.findOptionalArgSpec(internSymbol("third")) == spec.end(), caseLabel);
+      VERIFY(spec.findOptionalArgSpec(NoSymbol) == spec.end(), caseLabel);
+   }
+}
+
+
+void testCmdSpecRejectsAmbiguousArgs()
+{
+   auto isRejected = [](std::vector<ArgSpec> argSpecs) {
+      try
+      {
+         CmdSpec spec{"test", "t", "", std::move(argSpecs), ""};
+         return false;
+      }
+      catch (const std::invalid_argument&)
+      {
+         return true;
+      }
+   };
+
+   {
+      const std::string caseLabel = "CmdSpec ctor rejects duplicate labels";
+      VERIFY(isRejected({ArgSpec::makeFlagArg("first", "f"), ArgSpec::makeFlagArg("first")}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec ctor rejects duplicate labels in other case";
+      VERIFY(isRejected({ArgSpec::makeFlagArg("first"), ArgSpec::makeFlagArg("FIRST")}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec ctor rejects duplicate abbreviations";
+      VERIFY(isRejected({ArgSpec::makeFlagArg("first", "f"),
+                         ArgSpec::makeOptionalArg("second", 1, "f")}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec ctor rejects abbreviation matching a label";
+      VERIFY(isRejected({ArgSpec::makeFlagArg("first", "s"), ArgSpec::makeFlagArg("s")}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec ctor rejects label of help argument";
+      VERIFY(isRejected({ArgSpec::makeFlagArg("first", "?")}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec ctor rejects positional after optional args";
+      VERIFY(isRejected({ArgSpec::makeFlagArg("first"), ArgSpec::makePositionalArg(1)}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdSpec ctor accepts distinct labels";
+      VERIFY(!isRejected({ArgSpec::makePositionalArg(1), ArgSpec::makeFlagArg("first", "f"),
+                          ArgSpec::makeOptionalArg("second", 1, "s")}),
+             caseLabel);
+   }
+}
+
 } // namespace
 
 
@@ -1644,8 +2000,16 @@ void testCmdSpec()
    testCmdSpecName();
    testCmdSpecDescription();
    testCmdSpecHelp();
+   testCmdSpecTimeout();
+   testCmdSpecPure();
    testCmdSpecHasArgSpec();
    testCmdSpecBegin();
    testCmdSpecEnd();
    testCmdSpecMatch();
+   testCmdSpecMatchView();
+   testCmdSpecMatchTypedValues();
+   testCmdSpecMatchSpecIndices();
+   testCmdSpecMatchTimeoutArg();
+   testCmdSpecFindOptionalArgSpec();
+   testCmdSpecRejectsAmbiguousArgs();
 }
@@ -0,0 +1,246 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "completion_index_tests.h"
+#include "completion_index.h"
+#include "test_util.h"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void testCompletionIndexFind()
+{
+   {
+      const std::string caseLabel = "CompletionIndex::find for keys with prefix";
+      CompletionIndex index;
+      index.add("temp");
+      index.add("add");
+      index.add("teach");
+      index.add("zap");
+      index.add("test");
+
+      const std::vector<std::string> expected = {"teach", "temp", "test"};
+      VERIFY(index.find("te") == expected, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CompletionIndex::find for no matching keys";
+      CompletionIndex index;
+      index.add("add");
+      index.add("zap");
+
+      VERIFY(index.find("te").empty(), caseLabel);
+      VERIFY(index.find("zapper").empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CompletionIndex::find for empty prefix";
+      CompletionIndex index;
+      index.add("b");
+      index.add("a");
+
+      const std::vector<std::string> expected = {"a", "b"};
+      VERIFY(index.find("") == expected, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CompletionIndex::find for key equal to prefix";
+      CompletionIndex index;
+      index.add("te");
+      index.add("tea");
+
+      const std::vector<std::string> expected = {"te", "tea"};
+      VERIFY(index.find("te") == expected, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CompletionIndex::find for empty index";
+      CompletionIndex index;
+      VERIFY(index.find("a").empty(), caseLabel);
+   }
+}
+
+
+void testCompletionIndexCompletions()
+{
+   {
+      const std::string caseLabel =
+         "CompletionIndex::find for keys that complete to different text";
+      CompletionIndex index;
+      index.add("colors");
+      index.add("c", "colors");
+      index.add("fs", "fontsize");
+
+      VERIFY(index.find("c") == std::vector<std::string>{"colors"}, caseLabel);
+      VERIFY(index.find("f") == std::vector<std::string>{"fontsize"}, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "CompletionIndex::find orders completions instead of keys";
+      CompletionIndex index;
+      index.add("ta", "zebra");
+      index.add("tb", "apple");
+
+      const std::vector<std::string> expected = {"apple", "zebra"};
+      VERIFY(index.find("t") == expected, caseLabel);
+   }
+}
+
+
+void testCompletionIndexIncrementalAdd()
+{
+   {
+      const std::string caseLabel = "CompletionIndex::add after lookup";
+      CompletionIndex index;
+      index.add("test");
+      index.add("beta");
+      VERIFY(index.find("te") == std::vector<std::string>{"test"}, caseLabel);
+
+      index.add("teach");
+      index.add("alpha");
+      index.add("temp");
+
+      const std::vector<std::string> expected = {"teach", "temp", "test"};
+      VERIFY(index.find("te") == expected, caseLabel);
+      VERIFY(index.find("a") == std::vector<std::string>{"alpha"}, caseLabel);
+      VERIFY(index.size() == 5, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "CompletionIndex::add for keys in main and added tables";
+      // Enough keys to merge added keys into the main table several times. Added in
+      // an order that is not sorted.
+      CompletionIndex index;
+      std::vector<std::string> keys;
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+         const std::string key = "key" + std::to_string((i * 7919) % 1000);
+         index.add(key);
+         keys.push_back(key);
+
+         if (i % 97 == 0)
+         {
+            std::vector<std::string> expected;
+            for (const std::string& k : keys)
+               if (k.compare(0, 4, "key1") == 0)
+                  expected.push_back(k);
+            std::sort(expected.begin(), expected.end());
+
+            VERIFY(index.find("key1") == expected, caseLabel);
+         }
+      }
+      VERIFY(index.size() == 1000, caseLabel);
+      VERIFY(index.find("key").size() == 1000, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CompletionIndex::clear";
+      CompletionIndex index;
+      index.add("test");
+      index.find("t");
+      index.clear();
+
+      VERIFY(index.empty(), caseLabel);
+      VERIFY(index.find("t").empty(), caseLabel);
+
+      index.add("teach");
+      VERIFY(index.find("t") == std::vector<std::string>{"teach"}, caseLabel);
+   }
+}
+
+
+
+void testCompletionIndexNarrow()
+{
+   {
+      const std::string caseLabel = "CompletionIndex::narrow for prefix matches";
+      CompletionIndex index;
+      index.add("teach");
+      index.add("temp");
+      index.add("test");
+      index.add("tx", "taxes");
+
+      CompletionIndex::Matches matches = index.match("t", CompletionMode::Prefix);
+      VERIFY(index.completions(matches, 10) ==
+                std::vector<std::string>({"taxes", "teach", "temp", "test"}),
+             caseLabel);
+
+      index.narrow(matches, "te");
+      VERIFY(index.completions(matches, 10) ==
+                std::vector<std::string>({"teach", "temp", "test"}),
+             caseLabel);
+
+      index.narrow(matches, "tes");
+      VERIFY(index.completions(matches, 10) == std::vector<std::string>{"test"},
+             caseLabel);
+
+      index.narrow(matches, "tesx");
+      VERIFY(index.completions(matches, 10).empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CompletionIndex::narrow for fuzzy matches";
+      CompletionIndex index;
+      index.add("fontsize");
+      index.add("fastsave");
+      index.add("format");
+
+      CompletionIndex::Matches matches = index.match("f", CompletionMode::Fuzzy);
+      VERIFY(index.completions(matches, 10).size() == 3, caseLabel);
+
+      index.narrow(matches, "fs");
+      VERIFY(index.completions(matches, 10) ==
+                std::vector<std::string>({"fastsave", "fontsize"}),
+             caseLabel);
+
+      index.narrow(matches, "fsz");
+      VERIFY(index.completions(matches, 10) == std::vector<std::string>{"fontsize"},
+             caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "CompletionIndex::narrow for keys in main and added tables";
+      CompletionIndex index;
+      for (std::size_t i = 0; i < 500; ++i)
+         index.add("key" + std::to_string(i));
+
+      CompletionIndex::Matches matches = index.match("key", CompletionMode::Prefix);
+      VERIFY(index.completions(matches, 1000).size() == 500, caseLabel);
+
+      index.narrow(matches, "key4");
+      VERIFY(index.completions(matches, 1000) == index.find("key4"), caseLabel);
+      VERIFY(index.completions(matches, 1000).size() == 111, caseLabel);
+
+      index.narrow(matches, "key49");
+      VERIFY(index.completions(matches, 1000) == index.find("key49"), caseLabel);
+      VERIFY(index.completions(matches, 1000).size() == 11, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CompletionIndex::completions limits results";
+      CompletionIndex index;
+      index.add("teach");
+      index.add("temp");
+      index.add("test");
+
+      const CompletionIndex::Matches matches = index.match("te", CompletionMode::Prefix);
+      VERIFY(index.completions(matches, 2) ==
+                std::vector<std::string>({"teach", "temp"}),
+             caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testCompletionIndex()
+{
+   testCompletionIndexFind();
+   testCompletionIndexCompletions();
+   testCompletionIndexIncrementalAdd();
+   testCompletionIndexNarrow();
+}
@@ -0,0 +1,112 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "concurrent_queue_tests.h"
+#include "concurrent_queue.h"
+#include "test_util.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void testConcurrentQueueDrain()
+{
+   {
+      const std::string caseLabel = "ConcurrentQueue::drain for empty queue";
+      ConcurrentQueue<int> queue;
+      const std::size_t numItems = queue.drain([](int) {});
+      VERIFY(numItems == 0, caseLabel);
+      VERIFY(queue.empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "ConcurrentQueue::drain processes items in push order";
+      ConcurrentQueue<int> queue;
+      queue.push(1);
+      queue.push(2);
+      queue.push(3);
+      VERIFY(!queue.empty(), caseLabel);
+
+      std::vector<int> items;
+      const std::size_t numItems = queue.drain([&items](int item) { items.push_back(item); });
+      VERIFY(numItems == 3, caseLabel);
+      VERIFY(items == std::vector<int>({1, 2, 3}), caseLabel);
+      VERIFY(queue.empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "ConcurrentQueue for move-only items";
+      ConcurrentQueue<std::unique_ptr<int>> queue;
+      queue.push(std::make_unique<int>(5));
+      int value = 0;
+      queue.drain([&value](std::unique_ptr<int> item) { value = *item; });
+      VERIFY(value == 5, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ConcurrentQueue frees undrained items";
+      auto item = std::make_shared<int>(1);
+      {
+         ConcurrentQueue<std::shared_ptr<int>> queue;
+         queue.push(item);
+         VERIFY(item.use_count() == 2, caseLabel);
+      }
+      VERIFY(item.use_count() == 1, caseLabel);
+   }
+}
+
+
+void testConcurrentQueueMultipleProducers()
+{
+   {
+      const std::string caseLabel =
+         "ConcurrentQueue keeps order of each producer for multiple producers";
+      constexpr int NumProducers = 4;
+      constexpr int NumItemsPerProducer = 10000;
+
+      ConcurrentQueue<std::pair<int, int>> queue;
+      std::vector<std::thread> producers;
+      for (int p = 0; p < NumProducers; ++p)
+      {
+         producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < NumItemsPerProducer; ++i)
+               queue.push({p, i});
+         });
+      }
+
+      // Drain concurrently with the producers.
+      std::vector<int> nextExpected(NumProducers, 0);
+      bool isOrdered = true;
+      int numDrained = 0;
+      auto process = [&](std::pair<int, int> item) {
+         isOrdered = isOrdered && item.second == nextExpected[item.first];
+         nextExpected[item.first] = item.second + 1;
+         ++numDrained;
+      };
+      while (numDrained < NumProducers * NumItemsPerProducer)
+         queue.drain(process);
+
+      for (std::thread& producer : producers)
+         producer.join();
+
+      VERIFY(isOrdered, caseLabel);
+      VERIFY(numDrained == NumProducers * NumItemsPerProducer, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testConcurrentQueue()
+{
+   testConcurrentQueueDrain();
+   testConcurrentQueueMultipleProducers();
+}
@@ -0,0 +1,9 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+
+void testConcurrentQueue();
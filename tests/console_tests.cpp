@@ -0,0 +1,1292 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "console_tests.h"
+#include "cmd.h"
+#include "console.h"
+#include "console_ui.h"
+#include "interactive_cmd.h"
+#include "jobs.h"
+#include "test_util.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+struct CountingConsoleUI : public ConsoleUI
+{
+   void setContent(ConsoleContent*) override {}
+   void showConsole() override {}
+   void hideConsole() override {}
+   void setBackgroundColor(const sutil::Rgb&) override {}
+   void setOutputTextColor(const sutil::Rgb&) override {}
+   void setInputTextColor(const sutil::Rgb&) override {}
+   void resetColors() override {}
+   void setFontSize(int) override {}
+   void notifyPendingOutput() override { ++numNotifications; }
+
+   std::atomic<int> numNotifications = 0;
+};
+
+
+// Records the thread that it executes on.
+class ThreadRecordingCmd : public StreamingCmd
+{
+ public:
+   ThreadRecordingCmd(CmdThreadAffinity affinity, std::thread::id* executingThread)
+   : m_affinity{affinity}, m_executingThread{executingThread}
+   {
+   }
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd&, OutputSink& out) override
+   {
+      *m_executingThread = std::this_thread::get_id();
+      out.writeLine("done");
+   }
+   CmdThreadAffinity threadAffinity() const override { return m_affinity; }
+
+ private:
+   CmdThreadAffinity m_affinity;
+   std::thread::id* m_executingThread;
+};
+
+
+// Executes until it is released.
+class BlockingCmd : public StreamingCmd
+{
+ public:
+   explicit BlockingCmd(const std::atomic<bool>* isReleased) : m_isReleased{isReleased} {}
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd&, OutputSink& out) override
+   {
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+      while (!*m_isReleased && std::chrono::steady_clock::now() < deadline)
+         std::this_thread::yield();
+      out.writeLine("released");
+   }
+
+ private:
+   const std::atomic<bool>* m_isReleased;
+};
+
+
+struct ManyLinesCmd : public StreamingCmd
+{
+   explicit ManyLinesCmd(int numLines = 100) : numLines{numLines} {}
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd&, OutputSink& out) override
+   {
+      for (int i = 0; i < numLines; ++i)
+         out.writeLine(std::to_string(i));
+   }
+
+   int numLines = 0;
+};
+
+
+// Writes partial output and executes until it is cancelled.
+class CancellableCmd : public StreamingCmd
+{
+ public:
+   CancellableCmd(CmdThreadAffinity affinity, std::atomic<bool>* isStarted)
+   : m_affinity{affinity}, m_isStarted{isStarted}
+   {
+   }
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd&, OutputSink& out) override
+   {
+      out.writeLine("partial");
+      *m_isStarted = true;
+
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+      while (!out.isCancelled() && std::chrono::steady_clock::now() < deadline)
+         std::this_thread::yield();
+      out.writeLine("not cancelled");
+   }
+   CmdThreadAffinity threadAffinity() const override { return m_affinity; }
+
+ private:
+   CmdThreadAffinity m_affinity;
+   std::atomic<bool>* m_isStarted;
+};
+
+
+// Echoes its value. Fails for the value "bad" and finishes late for the value
+// "slow".
+struct ValueCmd : public StreamingCmd
+{
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd& input, OutputSink& out) override
+   {
+      const std::string& value = input.args[0].values[0];
+      if (value == "bad")
+         throw std::runtime_error{"boom"};
+      if (value == "slow")
+         std::this_thread::sleep_for(std::chrono::milliseconds{100});
+      out.writeLine("got " + value);
+   }
+};
+
+
+// Asks for confirmation until it gets a valid answer.
+class ConfirmingCmd : public InteractiveCmd
+{
+ public:
+   CmdStep start(const VerifiedCmd&, OutputSink& out) override
+   {
+      out.writeLine("Proceed? [y/n]");
+      return CmdStep::AwaitInput;
+   }
+
+   CmdStep resumeWithInput(std::string_view inputLine, OutputSink& out) override
+   {
+      if (inputLine == "y" || inputLine == "n")
+      {
+         out.writeLine(inputLine == "y" ? "Proceeding." : "Aborted.");
+         return CmdStep::Done;
+      }
+      return start({}, out);
+   }
+};
+
+
+// Reports progress in steps.
+class ProgressCmd : public InteractiveCmd
+{
+ public:
+   explicit ProgressCmd(int numSteps) : m_numSteps{numSteps} {}
+
+   CmdStep start(const VerifiedCmd&, OutputSink& out) override { return resume(out); }
+
+   CmdStep resume(OutputSink& out) override
+   {
+      ++m_step;
+      out.writeLine(std::to_string(m_step) + "/" + std::to_string(m_numSteps));
+      return m_step < m_numSteps ? CmdStep::Continue : CmdStep::Done;
+   }
+
+ private:
+   int m_numSteps = 0;
+   int m_step = 0;
+};
+
+
+// Waits until it is woken up from another thread.
+class WakingCmd : public InteractiveCmd
+{
+ public:
+   explicit WakingCmd(WakingCmd** instance) { *instance = this; }
+
+   CmdStep start(const VerifiedCmd&, OutputSink&) override { return CmdStep::Wait; }
+   CmdStep resume(OutputSink& out) override
+   {
+      if (!m_isWoken)
+         return CmdStep::Wait;
+      out.writeLine("woken");
+      return CmdStep::Done;
+   }
+
+   void wake()
+   {
+      m_isWoken = true;
+      wakeUp();
+   }
+
+ private:
+   std::atomic<bool> m_isWoken = false;
+};
+
+
+struct ThrowingInteractiveCmd : public InteractiveCmd
+{
+   CmdStep start(const VerifiedCmd&, OutputSink& out) override
+   {
+      out.writeLine("Proceed?");
+      return CmdStep::AwaitInput;
+   }
+
+   CmdStep resumeWithInput(std::string_view, OutputSink&) override
+   {
+      throw std::runtime_error{"boom"};
+   }
+};
+
+
+// Records the number of arguments that it receives.
+class ArgCountingCmd : public StreamingCmd
+{
+ public:
+   explicit ArgCountingCmd(std::size_t* numArgs) : m_numArgs{numArgs} {}
+
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd& input, OutputSink&) override
+   {
+      *m_numArgs = input.args.size();
+   }
+
+ private:
+   std::size_t* m_numArgs;
+};
+
+
+struct ThrowingCmd : public Cmd
+{
+   using Cmd::execute;
+   CmdOutput execute(const VerifiedCmd&) override { throw std::runtime_error{"boom"}; }
+};
+
+
+CmdSpec makeSpec(const std::string& name)
+{
+   return {name, "", "", {}, ""};
+}
+
+
+CmdSpec makeValueSpec(const std::string& name)
+{
+   return {name, "", "", {ArgSpec::makePositionalArg(1)}, ""};
+}
+
+
+void waitUntil(const std::atomic<bool>& condition)
+{
+   const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+   while (!condition && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::yield();
+}
+
+
+///////////////////
+
+void testConsoleThreadAffinity()
+{
+   {
+      const std::string caseLabel = "Console executes UI thread commands synchronously";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::thread::id executingThread;
+      console.addCommand(makeSpec("ui"), [&executingThread]() {
+         return std::make_unique<ThreadRecordingCmd>(CmdThreadAffinity::UIThread,
+                                                     &executingThread);
+      });
+
+      console.setInputLine("> ui");
+      console.processInputLine();
+
+      VERIFY(executingThread == std::this_thread::get_id(), caseLabel);
+      VERIFY(console.lineText(1) == "done", caseLabel);
+      VERIFY(ui.numNotifications == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console executes other commands on worker threads";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::thread::id executingThread;
+      console.addCommand(makeSpec("any"), [&executingThread]() {
+         return std::make_unique<ThreadRecordingCmd>(CmdThreadAffinity::Any,
+                                                     &executingThread);
+      });
+
+      console.setInputLine("> any");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(executingThread != std::this_thread::get_id(), caseLabel);
+      VERIFY(console.lineText(1) == "done", caseLabel);
+   }
+}
+
+
+void testConsoleInputWhileExecuting()
+{
+   {
+      const std::string caseLabel = "Console input line is editable while command executes";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isReleased = false;
+      console.addCommand(makeSpec("block"), [&isReleased]() {
+         return std::make_unique<BlockingCmd>(&isReleased);
+      });
+
+      console.setInputLine("> block");
+      console.processInputLine();
+      console.setInputLine("> typing");
+      VERIFY(console.inputLineText() == "> typing", caseLabel);
+
+      isReleased = true;
+      console.waitForCommands();
+
+      // The output is inserted before the input line.
+      VERIFY(console.lineText(1) == "released", caseLabel);
+      VERIFY(console.inputLineText() == "> typing", caseLabel);
+   }
+}
+
+
+void testConsolePendingOutputNotifications()
+{
+   {
+      const std::string caseLabel = "Console notifies UI once until output is processed";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("many"), []() { return std::make_unique<ManyLinesCmd>(); });
+
+      console.setInputLine("> many");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(ui.numNotifications == 1, caseLabel);
+      // Entered line, output lines, separator line, input line.
+      VERIFY(console.countLines() == 103, caseLabel);
+      VERIFY(console.lineText(100) == "99", caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "Console keeps all output of foreground jobs that exceeds their buffer";
+      CountingConsoleUI ui;
+      Console console{ui};
+      const int numLines = static_cast<int>(JobOutput::DefaultCapacity) + 500;
+      console.addCommand(makeSpec("many"),
+                         [numLines]() { return std::make_unique<ManyLinesCmd>(numLines); });
+
+      console.setInputLine("> many");
+      console.processInputLine();
+      console.waitForCommands();
+
+      // Entered line, output lines, separator line, input line.
+      VERIFY(console.countLines() == static_cast<std::size_t>(numLines) + 3, caseLabel);
+      VERIFY(console.lineText(1) == "0", caseLabel);
+      VERIFY(console.lineText(numLines) == std::to_string(numLines - 1), caseLabel);
+   }
+}
+
+
+void testConsoleFailingCommand()
+{
+   {
+      const std::string caseLabel = "Console reports exceptions of commands as output";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("throw"), []() { return std::make_unique<ThrowingCmd>(); });
+
+      console.setInputLine("> throw");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "Command failed. boom", caseLabel);
+   }
+}
+
+
+void testConsoleCancelCommands()
+{
+   {
+      const std::string caseLabel = "Console::cancelCommands aborts running commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isStarted = false;
+      console.addCommand(makeSpec("wait"), [&isStarted]() {
+         return std::make_unique<CancellableCmd>(CmdThreadAffinity::Any, &isStarted);
+      });
+
+      console.setInputLine("> wait");
+      console.processInputLine();
+      waitUntil(isStarted);
+      console.cancelCommands();
+      console.waitForCommands();
+
+      // The partial output is kept.
+      VERIFY(console.lineText(1) == "partial", caseLabel);
+      VERIFY(console.lineText(2) == "Command cancelled.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::cancelCommands for finished commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("many"), []() { return std::make_unique<ManyLinesCmd>(); });
+
+      console.setInputLine("> many");
+      console.processInputLine();
+      console.waitForCommands();
+      console.cancelCommands();
+
+      VERIFY(console.lineText(100) == "99", caseLabel);
+      VERIFY(console.lineText(101) == "\n", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console dtor cancels running commands";
+      CountingConsoleUI ui;
+      std::atomic<bool> isStarted = false;
+      const auto start = std::chrono::steady_clock::now();
+      {
+         Console console{ui};
+         console.addCommand(makeSpec("wait"), [&isStarted]() {
+            return std::make_unique<CancellableCmd>(CmdThreadAffinity::Any, &isStarted);
+         });
+         console.setInputLine("> wait");
+         console.processInputLine();
+         waitUntil(isStarted);
+      }
+      // Without cancelling the command would run into its deadline of ten seconds.
+      VERIFY(std::chrono::steady_clock::now() - start < std::chrono::seconds{5},
+             caseLabel);
+   }
+}
+
+
+void testConsoleCommandTimeout()
+{
+   {
+      const std::string caseLabel = "Console aborts commands after timeout argument";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isStarted = false;
+      console.addCommand(makeSpec("wait"), [&isStarted]() {
+         return std::make_unique<CancellableCmd>(CmdThreadAffinity::Any, &isStarted);
+      });
+
+      console.setInputLine("> wait -timeout 20");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "partial", caseLabel);
+      VERIFY(console.lineText(2) == "Command timed out.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console aborts commands after timeout of spec";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isStarted = false;
+      CmdSpec spec = makeSpec("wait");
+      spec.setTimeout(std::chrono::milliseconds{20});
+      console.addCommand(spec, [&isStarted]() {
+         return std::make_unique<CancellableCmd>(CmdThreadAffinity::Any, &isStarted);
+      });
+
+      console.setInputLine("> wait");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "partial", caseLabel);
+      VERIFY(console.lineText(2) == "Command timed out.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console aborts UI thread commands after timeout";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isStarted = false;
+      console.addCommand(makeSpec("wait"), [&isStarted]() {
+         return std::make_unique<CancellableCmd>(CmdThreadAffinity::UIThread, &isStarted);
+      });
+
+      console.setInputLine("> wait -timeout 20");
+      console.processInputLine();
+
+      VERIFY(console.lineText(1) == "partial", caseLabel);
+      VERIFY(console.lineText(2) == "Command timed out.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console hides timeout argument from commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::size_t numArgs = 1;
+      console.addCommand(makeSpec("args"), [&numArgs]() {
+         return std::make_unique<ArgCountingCmd>(&numArgs);
+      });
+
+      console.setInputLine("> args -timeout 1000");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(numArgs == 0, caseLabel);
+   }
+}
+
+
+void testConsoleBackgroundJobs()
+{
+   {
+      const std::string caseLabel = "Console buffers output of background jobs";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("many"), []() { return std::make_unique<ManyLinesCmd>(); });
+
+      console.setInputLine("> many &");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "[1] Running     many &", caseLabel);
+      VERIFY(console.lineText(2) == "\n", caseLabel);
+      // Reported when finished. The output stays buffered.
+      VERIFY(console.lineText(3) == "[1] Done        many &", caseLabel);
+      VERIFY(console.countLines() == 5, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console lists and kills jobs";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isStarted = false;
+      console.addCommand(makeSpec("wait"), [&isStarted]() {
+         return std::make_unique<CancellableCmd>(CmdThreadAffinity::Any, &isStarted);
+      });
+
+      console.setInputLine("> wait&");
+      console.processInputLine();
+      console.setInputLine("> jobs");
+      console.processInputLine();
+      VERIFY(console.lineText(4) == "[1] Running     wait &", caseLabel);
+
+      console.setInputLine("> kill 1");
+      console.processInputLine();
+      console.waitForCommands();
+      VERIFY(console.lineText(7) == "[1] Cancelled   wait &", caseLabel);
+
+      console.setInputLine("> jobs");
+      console.processInputLine();
+      VERIFY(console.lineText(9) == "No jobs.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console brings finished background jobs to the "
+                                    "foreground";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("many"), []() { return std::make_unique<ManyLinesCmd>(); });
+
+      console.setInputLine("> many &");
+      console.processInputLine();
+      console.waitForCommands();
+      console.setInputLine("> fg 1");
+      console.processInputLine();
+
+      VERIFY(console.lineText(5) == "0", caseLabel);
+      VERIFY(console.lineText(104) == "99", caseLabel);
+      VERIFY(console.lineText(105) == "\n", caseLabel);
+
+      // The job is removed once its output was displayed.
+      console.setInputLine("> jobs");
+      console.processInputLine();
+      VERIFY(console.lineText(107) == "No jobs.", caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "Console drops oldest output of background jobs that exceeds their buffer";
+      CountingConsoleUI ui;
+      Console console{ui};
+      const int numLines = static_cast<int>(JobOutput::DefaultCapacity) + 500;
+      console.addCommand(makeSpec("many"),
+                         [numLines]() { return std::make_unique<ManyLinesCmd>(numLines); });
+
+      console.setInputLine("> many &");
+      console.processInputLine();
+      console.waitForCommands();
+      console.setInputLine("> fg 1");
+      console.processInputLine();
+
+      VERIFY(console.lineText(5) == "... 500 lines dropped", caseLabel);
+      VERIFY(console.lineText(6) == "500", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console brings running background jobs to the "
+                                    "foreground";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isStarted = false;
+      console.addCommand(makeSpec("wait"), [&isStarted]() {
+         return std::make_unique<CancellableCmd>(CmdThreadAffinity::Any, &isStarted);
+      });
+
+      console.setInputLine("> wait &");
+      console.processInputLine();
+      waitUntil(isStarted);
+      console.setInputLine("> fg 1");
+      console.processInputLine();
+      VERIFY(console.lineText(4) == "partial", caseLabel);
+
+      // Foreground jobs can be cancelled and display their further output.
+      console.cancelCommands();
+      console.waitForCommands();
+      VERIFY(console.lineText(6) == "Command cancelled.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::cancelCommands skips background jobs";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isStarted = false;
+      console.addCommand(makeSpec("wait"), [&isStarted]() {
+         return std::make_unique<CancellableCmd>(CmdThreadAffinity::Any, &isStarted);
+      });
+
+      console.setInputLine("> wait &");
+      console.processInputLine();
+      waitUntil(isStarted);
+      console.cancelCommands();
+      console.processPendingOutput();
+
+      console.setInputLine("> jobs");
+      console.processInputLine();
+      VERIFY(console.lineText(4) == "[1] Running     wait &", caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "Console executes UI thread commands synchronously in the background";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::thread::id executingThread;
+      console.addCommand(makeSpec("ui"), [&executingThread]() {
+         return std::make_unique<ThreadRecordingCmd>(CmdThreadAffinity::UIThread,
+                                                     &executingThread);
+      });
+
+      console.setInputLine("> ui &");
+      console.processInputLine();
+
+      VERIFY(executingThread == std::this_thread::get_id(), caseLabel);
+      VERIFY(console.lineText(1) == "done", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console reports unknown jobs";
+      CountingConsoleUI ui;
+      Console console{ui};
+
+      console.setInputLine("> fg 3");
+      console.processInputLine();
+      VERIFY(console.lineText(1) == "No job with id 3.", caseLabel);
+
+      console.setInputLine("> kill 3");
+      console.processInputLine();
+      VERIFY(console.lineText(4) == "No job with id 3.", caseLabel);
+   }
+}
+
+
+void testConsoleInteractiveCommands()
+{
+   {
+      const std::string caseLabel = "Console passes input to interactive commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("confirm"),
+                         []() { return std::make_unique<ConfirmingCmd>(); });
+
+      console.setInputLine("> confirm");
+      console.processInputLine();
+      VERIFY(console.lineText(1) == "Proceed? [y/n]", caseLabel);
+      VERIFY(console.countLines() == 3, caseLabel);
+
+      // The input is not executed as command.
+      console.setInputLine("> maybe");
+      console.processInputLine();
+      VERIFY(console.lineText(3) == "Proceed? [y/n]", caseLabel);
+
+      console.setInputLine("> y");
+      console.processInputLine();
+      VERIFY(console.lineText(5) == "Proceeding.", caseLabel);
+      VERIFY(console.lineText(6) == "\n", caseLabel);
+
+      // Input goes to commands again.
+      console.setInputLine("> confirm");
+      console.processInputLine();
+      VERIFY(console.lineText(8) == "Proceed? [y/n]", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console resumes yielding interactive commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("progress"),
+                         []() { return std::make_unique<ProgressCmd>(3); });
+
+      console.setInputLine("> progress");
+      console.processInputLine();
+      VERIFY(console.lineText(1) == "1/3", caseLabel);
+      // The next step is scheduled through the UI.
+      VERIFY(ui.numNotifications == 1, caseLabel);
+
+      console.processPendingOutput();
+      VERIFY(console.lineText(2) == "2/3", caseLabel);
+      console.processPendingOutput();
+      VERIFY(console.lineText(3) == "3/3", caseLabel);
+      VERIFY(console.lineText(4) == "\n", caseLabel);
+      VERIFY(ui.numNotifications == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "Console resumes waiting interactive commands when woken";
+      CountingConsoleUI ui;
+      Console console{ui};
+      WakingCmd* cmd = nullptr;
+      console.addCommand(makeSpec("wake"),
+                         [&cmd]() { return std::make_unique<WakingCmd>(&cmd); });
+
+      console.setInputLine("> wake");
+      console.processInputLine();
+      // Waiting commands are not rescheduled until they wake up.
+      VERIFY(ui.numNotifications == 0, caseLabel);
+      console.processPendingOutput();
+      VERIFY(ui.numNotifications == 0, caseLabel);
+
+      std::thread waker{[cmd]() { cmd->wake(); }};
+      waker.join();
+      VERIFY(ui.numNotifications == 1, caseLabel);
+      console.processPendingOutput();
+      VERIFY(console.lineText(1) == "woken", caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "Console executes other commands while interactive command yields";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("progress"),
+                         []() { return std::make_unique<ProgressCmd>(2); });
+      console.addCommand(makeSpec("confirm"),
+                         []() { return std::make_unique<ConfirmingCmd>(); });
+
+      console.setInputLine("> progress");
+      console.processInputLine();
+      console.setInputLine("> confirm");
+      console.processInputLine();
+      console.waitForCommands();
+
+      // The pending step was processed before the new input.
+      VERIFY(console.lineText(2) == "2/2", caseLabel);
+      VERIFY(console.lineText(5) == "Proceed? [y/n]", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console rejects second interactive command";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("progress"),
+                         []() { return std::make_unique<ProgressCmd>(5); });
+
+      console.setInputLine("> progress");
+      console.processInputLine();
+      console.setInputLine("> progress");
+      console.processInputLine();
+      // The pending step was processed before the new input.
+      VERIFY(console.lineText(2) == "2/5", caseLabel);
+      VERIFY(console.lineText(4) == "Another interactive command is executing.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::cancelCommands ends interactive command";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("confirm"),
+                         []() { return std::make_unique<ConfirmingCmd>(); });
+
+      console.setInputLine("> confirm");
+      console.processInputLine();
+      console.cancelCommands();
+      VERIFY(console.lineText(2) == "Command cancelled.", caseLabel);
+
+      console.setInputLine("> y");
+      console.processInputLine();
+      VERIFY(console.lineText(5) == "Command not found.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console reports failing interactive command";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeSpec("throw"),
+                         []() { return std::make_unique<ThrowingInteractiveCmd>(); });
+
+      console.setInputLine("> throw");
+      console.processInputLine();
+      console.setInputLine("> y");
+      console.processInputLine();
+      VERIFY(console.lineText(3) == "Command failed. boom", caseLabel);
+      VERIFY(console.lineText(4) == "\n", caseLabel);
+   }
+}
+
+
+void testConsolePureCommands()
+{
+   {
+      const std::string caseLabel = "Console reuses results of pure commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+      int numCreated = 0;
+      CmdSpec spec = makeValueSpec("value");
+      spec.setPure(true);
+      console.addCommand(spec, [&numCreated]() {
+         ++numCreated;
+         return std::make_unique<ValueCmd>();
+      });
+
+      console.setInputLine("> value a");
+      console.processInputLine();
+      console.waitForCommands();
+      console.setInputLine("> value a");
+      console.processInputLine();
+      console.waitForCommands();
+      console.setInputLine("> value b");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(numCreated == 2, caseLabel);
+      VERIFY(console.lineText(1) == "got a", caseLabel);
+      VERIFY(console.lineText(4) == "got a", caseLabel);
+      VERIFY(console.lineText(7) == "got b", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console does not reuse results of other commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+      int numCreated = 0;
+      console.addCommand(makeValueSpec("value"), [&numCreated]() {
+         ++numCreated;
+         return std::make_unique<ValueCmd>();
+      });
+
+      for (int i = 0; i < 2; ++i)
+      {
+         console.setInputLine("> value a");
+         console.processInputLine();
+         console.waitForCommands();
+      }
+
+      VERIFY(numCreated == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console does not reuse results of failed commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+      int numCreated = 0;
+      CmdSpec spec = makeValueSpec("value");
+      spec.setPure(true);
+      console.addCommand(spec, [&numCreated]() {
+         ++numCreated;
+         return std::make_unique<ValueCmd>();
+      });
+
+      for (int i = 0; i < 2; ++i)
+      {
+         console.setInputLine("> value bad");
+         console.processInputLine();
+         console.waitForCommands();
+      }
+
+      VERIFY(numCreated == 2, caseLabel);
+      VERIFY(console.lineText(4) == "Command failed. boom", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::invalidateResults";
+      CountingConsoleUI ui;
+      Console console{ui};
+      int numCreated = 0;
+      CmdSpec spec = makeValueSpec("value");
+      spec.setPure(true);
+      console.addCommand(spec, [&numCreated]() {
+         ++numCreated;
+         return std::make_unique<ValueCmd>();
+      });
+
+      console.setInputLine("> value a");
+      console.processInputLine();
+      console.waitForCommands();
+      console.invalidateResults("value");
+      console.setInputLine("> value a");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(numCreated == 2, caseLabel);
+      VERIFY(console.lineText(4) == "got a", caseLabel);
+   }
+}
+
+
+void testConsoleExecute()
+{
+   {
+      const std::string caseLabel = "Console::execute writes output to given sink";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      CollectingOutputSink out;
+      console.execute("value a", out);
+      console.execute("value", out);
+      console.execute("unknown", out);
+
+      VERIFY(out.lines().size() == 3, caseLabel);
+      VERIFY(out.lines()[0] == "got a", caseLabel);
+      VERIFY(out.lines()[1] == "Command syntax error.", caseLabel);
+      VERIFY(out.lines()[2] == "Command not found.", caseLabel);
+      // Only the input line.
+      VERIFY(console.countLines() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::execute executes synchronously";
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::thread::id executingThread;
+      console.addCommand(makeSpec("any"), [&executingThread]() {
+         return std::make_unique<ThreadRecordingCmd>(CmdThreadAffinity::Any,
+                                                     &executingThread);
+      });
+
+      CollectingOutputSink out;
+      console.execute("any &", out);
+
+      VERIFY(executingThread == std::this_thread::get_id(), caseLabel);
+      VERIFY(out.lines().size() == 1 && out.lines()[0] == "done", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::execute returns output";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      VERIFY(console.execute("value a") == CmdOutput{"got a"}, caseLabel);
+      VERIFY(console.execute("value") == CmdOutput{"Command syntax error."}, caseLabel);
+      VERIFY(console.execute("") == CmdOutput{}, caseLabel);
+      VERIFY(console.countLines() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::execute for verified command";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      const std::optional<VerifiedCmd> cmd = console.verifyCommand("value b");
+      VERIFY(cmd.has_value(), caseLabel);
+      VERIFY(console.execute(*cmd) == CmdOutput{"got b"}, caseLabel);
+      VERIFY(console.execute(*cmd) == CmdOutput{"got b"}, caseLabel);
+
+      CollectingOutputSink out;
+      console.execute(*cmd, out);
+      VERIFY(out.lines() == CmdOutput{"got b"}, caseLabel);
+      VERIFY(console.countLines() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::verifyCommand for invalid lines";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      VERIFY(!console.verifyCommand("value").has_value(), caseLabel);
+      VERIFY(!console.verifyCommand("unknown a").has_value(), caseLabel);
+      VERIFY(!console.verifyCommand("  ").has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console::execute for command of other console";
+      CountingConsoleUI ui;
+      Console console{ui};
+      Console other{ui};
+      other.addCommand(makeValueSpec("value"),
+                       []() { return std::make_unique<ValueCmd>(); });
+
+      const std::optional<VerifiedCmd> cmd = other.verifyCommand("value c");
+      VERIFY(cmd.has_value(), caseLabel);
+      VERIFY(console.execute(*cmd) == CmdOutput{"Command not found."}, caseLabel);
+   }
+}
+
+
+void testConsoleAutoCompletion()
+{
+   {
+      const std::string caseLabel = "Console auto completion for added command";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("valuable"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> valu");
+      console.nextAutoCompletion();
+
+      VERIFY(console.inputLineText() == "> valuable", caseLabel);
+   }
+}
+
+
+void testConsoleSourceCommand()
+{
+   {
+      const std::string caseLabel = "Console :source executes script";
+      const std::filesystem::path scriptPath =
+         std::filesystem::temp_directory_path() / "ccon_console_tests_script.txt";
+      {
+         std::ofstream script{scriptPath};
+         script << "value a\n# comment\nunknown\nvalue\nvalue b\n";
+      }
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> :source " + scriptPath.string());
+      console.processInputLine();
+      console.waitForCommands();
+      std::filesystem::remove(scriptPath);
+
+      VERIFY(console.lineText(1) == "got a", caseLabel);
+      VERIFY(console.lineText(2) == "Line 3: Command not found.", caseLabel);
+      VERIFY(console.lineText(3) == "Line 4: Command syntax error.", caseLabel);
+      VERIFY(console.lineText(4) == "got b", caseLabel);
+      VERIFY(console.lineText(5) == "\n", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :source rejects background lines";
+      const std::filesystem::path scriptPath =
+         std::filesystem::temp_directory_path() / "ccon_console_tests_bg_script.txt";
+      {
+         std::ofstream script{scriptPath};
+         script << "value a &\nvalue b\n";
+      }
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> :source " + scriptPath.string());
+      console.processInputLine();
+      console.waitForCommands();
+      std::filesystem::remove(scriptPath);
+
+      VERIFY(console.lineText(1) == "Line 1: Background jobs are not supported in scripts.",
+             caseLabel);
+      VERIFY(console.lineText(2) == "got b", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :source executes lines on worker threads";
+      const std::filesystem::path scriptPath =
+         std::filesystem::temp_directory_path() / "ccon_console_tests_worker_script.txt";
+      {
+         std::ofstream script{scriptPath};
+         script << "value slow\nany\nui\nvalue b\n";
+      }
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::thread::id anyThread;
+      std::thread::id uiThread;
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+      console.addCommand(makeSpec("any"), [&anyThread]() {
+         return std::make_unique<ThreadRecordingCmd>(CmdThreadAffinity::Any, &anyThread);
+      });
+      console.addCommand(makeSpec("ui"), [&uiThread]() {
+         return std::make_unique<ThreadRecordingCmd>(CmdThreadAffinity::UIThread,
+                                                     &uiThread);
+      });
+
+      console.setInputLine("> :source " + scriptPath.string());
+      console.processInputLine();
+      console.waitForCommands();
+      std::filesystem::remove(scriptPath);
+
+      VERIFY(anyThread != std::this_thread::get_id(), caseLabel);
+      VERIFY(uiThread == std::this_thread::get_id(), caseLabel);
+      // Lines execute in order even when an earlier line takes longer.
+      VERIFY(console.lineText(1) == "got slow", caseLabel);
+      VERIFY(console.lineText(2) == "done", caseLabel);
+      VERIFY(console.lineText(3) == "done", caseLabel);
+      VERIFY(console.lineText(4) == "got b", caseLabel);
+      VERIFY(console.lineText(5) == "\n", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :source cancels line executing on worker";
+      const std::filesystem::path scriptPath =
+         std::filesystem::temp_directory_path() / "ccon_console_tests_cancel_script.txt";
+      {
+         std::ofstream script{scriptPath};
+         script << "wait\nwait\n";
+      }
+      CountingConsoleUI ui;
+      Console console{ui};
+      std::atomic<bool> isStarted = false;
+      console.addCommand(makeSpec("wait"), [&isStarted]() {
+         return std::make_unique<CancellableCmd>(CmdThreadAffinity::Any, &isStarted);
+      });
+
+      console.setInputLine("> :source " + scriptPath.string());
+      console.processInputLine();
+      waitUntil(isStarted);
+      // The script waits for the line without rescheduling itself.
+      console.processPendingOutput();
+      const int numNotifications = ui.numNotifications;
+      console.processPendingOutput();
+      console.processPendingOutput();
+      VERIFY(ui.numNotifications == numNotifications, caseLabel);
+      console.cancelCommands();
+      // Returns only if the executing line was cancelled.
+      console.waitForCommands();
+      std::filesystem::remove(scriptPath);
+
+      // The partial output of the line might be displayed before the cancellation.
+      const std::size_t numLines = console.countLines();
+      VERIFY(console.lineText(numLines - 3) == "Command cancelled.", caseLabel);
+      VERIFY(console.lineText(numLines - 2) == "\n", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :source for missing script";
+      CountingConsoleUI ui;
+      Console console{ui};
+      const std::filesystem::path scriptPath =
+         std::filesystem::temp_directory_path() / "ccon_console_tests_missing.txt";
+
+      console.setInputLine("> :source " + scriptPath.string());
+      console.processInputLine();
+
+      VERIFY(console.lineText(1) == "Cannot open script '" + scriptPath.string() + "'.",
+             caseLabel);
+   }
+}
+
+
+void testConsoleParallelCommand()
+{
+   {
+      const std::string caseLabel = "Console :parallel outputs results in value order";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> :parallel value slow a b -jobs 3");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "slow: got slow", caseLabel);
+      VERIFY(console.lineText(2) == "a: got a", caseLabel);
+      VERIFY(console.lineText(3) == "b: got b", caseLabel);
+      VERIFY(console.lineText(4) == "\n", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :parallel outputs results as they finish";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> :p value slow a -j 2 -unordered");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "a: got a", caseLabel);
+      VERIFY(console.lineText(2) == "slow: got slow", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :parallel limits the number of jobs";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> :parallel value a b -jobs 1000000");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "a: got a", caseLabel);
+      VERIFY(console.lineText(2) == "b: got b", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :parallel captures failures per value";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> :parallel value a bad b");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "a: got a", caseLabel);
+      VERIFY(console.lineText(2) == "bad: Command failed. boom", caseLabel);
+      VERIFY(console.lineText(3) == "b: got b", caseLabel);
+      VERIFY(console.lineText(4) == "1 of 3 executions failed.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :parallel verifies the command per value";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(
+         CmdSpec{"number", "", "", {ArgSpec::makePositionalArg(1, "", ValueKind::Int)}, ""},
+         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> :parallel number 1 x");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "1: got 1", caseLabel);
+      VERIFY(console.lineText(2) == "x: Command syntax error.", caseLabel);
+      VERIFY(console.lineText(3) == "1 of 2 executions failed.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :parallel rejects unknown and UI commands";
+      CountingConsoleUI ui;
+      Console console{ui};
+
+      console.setInputLine("> :parallel unknown a");
+      console.processInputLine();
+      console.waitForCommands();
+      console.setInputLine("> :parallel jobs a");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "Command not found.", caseLabel);
+      VERIFY(console.lineText(4) == "Command cannot execute in parallel.", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console :parallel executes commands added later";
+      CountingConsoleUI ui;
+      Console console{ui};
+      console.addCommand(makeValueSpec("value"),
+                         []() { return std::make_unique<ValueCmd>(); });
+
+      console.setInputLine("> :parallel value a");
+      console.processInputLine();
+      console.waitForCommands();
+      console.addCommand(makeValueSpec("later"),
+                         []() { return std::make_unique<ValueCmd>(); });
+      console.setInputLine("> :parallel later b");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.lineText(1) == "a: got a", caseLabel);
+      VERIFY(console.lineText(4) == "b: got b", caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testConsole()
+{
+   testConsoleThreadAffinity();
+   testConsoleInputWhileExecuting();
+   testConsolePendingOutputNotifications();
+   testConsoleFailingCommand();
+   testConsoleCancelCommands();
+   testConsoleCommandTimeout();
+   testConsoleBackgroundJobs();
+   testConsoleInteractiveCommands();
+   testConsolePureCommands();
+   testConsoleExecute();
+   testConsoleAutoCompletion();
+   testConsoleSourceCommand();
+   testConsoleParallelCommand();
+}
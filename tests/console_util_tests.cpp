@@ -44,10 +44,154 @@ void testStripArgSeparators()
    }
 }
 
+
+void testStripArgSeparatorsView()
+{
+   {
+      const std::string caseLabel = "stripArgSeparatorsView for single separator";
+      VERIFY(stripArgSeparatorsView("-arg") == "arg", caseLabel);
+   }
+   {
+      const std::string caseLabel = "stripArgSeparatorsView for double separator";
+      VERIFY(stripArgSeparatorsView("--arg") == "arg", caseLabel);
+   }
+   {
+      const std::string caseLabel = "stripArgSeparatorsView for no separator";
+      VERIFY(stripArgSeparatorsView("arg") == "arg", caseLabel);
+   }
+   {
+      const std::string caseLabel = "stripArgSeparatorsView for separator in middle";
+      VERIFY(stripArgSeparatorsView("arg-more") == "arg-more", caseLabel);
+   }
+   {
+      const std::string caseLabel = "stripArgSeparatorsView for separator only";
+      VERIFY(stripArgSeparatorsView("-") == "", caseLabel);
+   }
+   {
+      const std::string caseLabel = "stripArgSeparatorsView for empty string";
+      VERIFY(stripArgSeparatorsView("") == "", caseLabel);
+   }
+   {
+      const std::string caseLabel = "stripArgSeparatorsView refers to passed text";
+      const std::string text = "--arg";
+      VERIFY(stripArgSeparatorsView(text).data() == text.data() + 2, caseLabel);
+   }
+}
+
+
+void testIsArgLabel()
+{
+   {
+      const std::string caseLabel = "isArgLabel for single dash";
+      VERIFY(isArgLabel("-arg"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "isArgLabel for double dash";
+      VERIFY(isArgLabel("--arg"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "isArgLabel for value";
+      VERIFY(!isArgLabel("arg"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "isArgLabel for triple dash";
+      VERIFY(!isArgLabel("---arg"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "isArgLabel for empty word";
+      VERIFY(!isArgLabel(""), caseLabel);
+   }
+}
+
+
+void testSplitCmdLine()
+{
+   {
+      const std::string caseLabel = "splitCmdLine for multiple words";
+      const CmdArgViews words = splitCmdLine("cmd 1 -opt");
+      VERIFY(words.size() == 3, caseLabel);
+      VERIFY(words[0] == "cmd", caseLabel);
+      VERIFY(words[1] == "1", caseLabel);
+      VERIFY(words[2] == "-opt", caseLabel);
+   }
+   {
+      const std::string caseLabel = "splitCmdLine for single word";
+      const CmdArgViews words = splitCmdLine("cmd");
+      VERIFY(words.size() == 1 && words[0] == "cmd", caseLabel);
+   }
+   {
+      const std::string caseLabel = "splitCmdLine for consecutive spaces";
+      const CmdArgViews words = splitCmdLine("cmd  1");
+      VERIFY(words.size() == 3, caseLabel);
+      VERIFY(words[1].empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "splitCmdLine for empty string";
+      const CmdArgViews words = splitCmdLine("");
+      VERIFY(words.size() == 1 && words[0].empty(), caseLabel);
+   }
+}
+
+
+void testBackgroundMarker()
+{
+   {
+      const std::string caseLabel = "hasBackgroundMarker for marker";
+      VERIFY(hasBackgroundMarker("cmd a &"), caseLabel);
+      VERIFY(hasBackgroundMarker("cmd a&"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "hasBackgroundMarker for trailing whitespace";
+      VERIFY(hasBackgroundMarker("cmd a & \t"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "hasBackgroundMarker for no marker";
+      VERIFY(!hasBackgroundMarker("cmd a"), caseLabel);
+      VERIFY(!hasBackgroundMarker("cmd & a"), caseLabel);
+      VERIFY(!hasBackgroundMarker(""), caseLabel);
+   }
+   {
+      const std::string caseLabel = "stripBackgroundMarker for marker";
+      VERIFY(stripBackgroundMarker("cmd a &") == "cmd a", caseLabel);
+      VERIFY(stripBackgroundMarker("cmd a& ") == "cmd a", caseLabel);
+   }
+   {
+      const std::string caseLabel = "stripBackgroundMarker for no marker";
+      VERIFY(stripBackgroundMarker("cmd a ") == "cmd a", caseLabel);
+      VERIFY(stripBackgroundMarker("&").empty(), caseLabel);
+   }
+}
+
+
+void testEqualsLowercase()
+{
+   {
+      const std::string caseLabel = "equalsLowercase for same text";
+      VERIFY(equalsLowercase("abc", "abc"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "equalsLowercase for different case";
+      VERIFY(equalsLowercase("AbC", "abc"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "equalsLowercase for different text";
+      VERIFY(!equalsLowercase("abd", "abc"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "equalsLowercase for different length";
+      VERIFY(!equalsLowercase("abcd", "abc"), caseLabel);
+   }
+}
+
 } // namespace
 
 
 void testConsoleUtil()
 {
    testStripArgSeparators();
+   testStripArgSeparatorsView();
+   testIsArgLabel();
+   testSplitCmdLine();
+   testBackgroundMarker();
+   testEqualsLowercase();
 }
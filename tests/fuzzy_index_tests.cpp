@@ -0,0 +1,213 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "fuzzy_index_tests.h"
+#include "fuzzy_index.h"
+#include "test_util.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void testFuzzyScore()
+{
+   {
+      const std::string caseLabel = "fuzzyScore for subsequence";
+      VERIFY(fuzzyScore("fsz", "fontsize").has_value(), caseLabel);
+      VERIFY(fuzzyScore("fontsize", "fontsize").has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "fuzzyScore for no subsequence";
+      VERIFY(!fuzzyScore("zf", "fontsize").has_value(), caseLabel);
+      VERIFY(!fuzzyScore("fontsizes", "fontsize").has_value(), caseLabel);
+      VERIFY(!fuzzyScore("a", "").has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "fuzzyScore for empty pattern";
+      VERIFY(fuzzyScore("", "fontsize") == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "fuzzyScore ignores case of text";
+      VERIFY(fuzzyScore("fs", "FontSize") == fuzzyScore("fs", "fontsize"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "fuzzyScore prefers consecutive matches";
+      VERIFY(*fuzzyScore("col", "colors") > *fuzzyScore("col", "cool"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "fuzzyScore prefers matches at word starts";
+      VERIFY(*fuzzyScore("fs", "font-size") > *fuzzyScore("fs", "fontsize"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "fuzzyScore prefers matches at start of text";
+      VERIFY(*fuzzyScore("set", "settings") > *fuzzyScore("set", "reset"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "fuzzyScore uses shortest occurrence";
+      // The first 'a' is far away from the 'b'.
+      VERIFY(fuzzyScore("ab", "axxxxxxab") == fuzzyScore("ab", "xab"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "fuzzyScore uses best alignment";
+      // The first occurrence "a..c" is worse than the one at the word starts.
+      VERIFY(fuzzyScore("ac", "xabxc_auto_complete") == fuzzyScore("ac", "x_auto_complete"),
+             caseLabel);
+      // Matching the 'c' at the start of "complete" is better than the first 'c'.
+      VERIFY(*fuzzyScore("ac", "abc_auto_complete") > *fuzzyScore("ac", "abc"), caseLabel);
+   }
+}
+
+
+void testCharClassMask()
+{
+   {
+      const std::string caseLabel = "charClassMask for contained characters";
+      const std::uint64_t textMask = charClassMask("fontsize");
+      VERIFY((textMask & charClassMask("fsz")) == charClassMask("fsz"), caseLabel);
+      VERIFY((textMask & charClassMask("fx")) != charClassMask("fx"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "charClassMask ignores case";
+      VERIFY(charClassMask("FontSize") == charClassMask("fontsize"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "charClassMask for empty text";
+      VERIFY(charClassMask("") == 0, caseLabel);
+   }
+}
+
+
+void testFuzzyIndexRank()
+{
+   {
+      const std::string caseLabel = "FuzzyIndex::rank orders best match first";
+      FuzzyIndex index;
+      index.add("cool");
+      index.add("colors");
+      index.add("clear");
+      index.add("fontsize");
+
+      const std::vector<std::string> expected = {"colors", "cool"};
+      VERIFY(index.rank("col", 10) == expected, caseLabel);
+   }
+   {
+      const std::string caseLabel = "FuzzyIndex::rank prefers matches at word starts "
+                                    "over earlier matches";
+      FuzzyIndex index;
+      index.add("xabxc_autocomplete");
+      index.add("xabxc_auto_complete");
+
+      const std::vector<std::string> expected = {"xabxc_auto_complete",
+                                                 "xabxc_autocomplete"};
+      VERIFY(index.rank("ac", 10) == expected, caseLabel);
+   }
+   {
+      const std::string caseLabel = "FuzzyIndex::rank orders equal scores by length";
+      FuzzyIndex index;
+      index.add("abcd");
+      index.add("abc");
+      index.add("abx");
+
+      const std::vector<std::string> expected = {"abc", "abx", "abcd"};
+      VERIFY(index.rank("ab", 10) == expected, caseLabel);
+   }
+   {
+      const std::string caseLabel = "FuzzyIndex::rank limits number of results";
+      FuzzyIndex index;
+      index.add("test1");
+      index.add("test22");
+      index.add("test333");
+
+      VERIFY(index.rank("t", 2) == std::vector<std::string>({"test1", "test22"}),
+             caseLabel);
+      VERIFY(index.rank("t", 0).empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "FuzzyIndex::rank for no matches";
+      FuzzyIndex index;
+      index.add("colors");
+      VERIFY(index.rank("xyz", 10).empty(), caseLabel);
+      VERIFY(FuzzyIndex{}.rank("c", 10).empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "FuzzyIndex::rank finds matches at every position for any number of texts";
+      // Covers the texts that don't fill a full vector of masks.
+      for (std::size_t numTexts = 1; numTexts <= 11; ++numTexts)
+      {
+         for (std::size_t matchIdx = 0; matchIdx < numTexts; ++matchIdx)
+         {
+            FuzzyIndex index;
+            for (std::size_t i = 0; i < numTexts; ++i)
+               index.add(i == matchIdx ? "match" : "other" + std::to_string(i));
+
+            VERIFY(index.rank("mch", 10) == std::vector<std::string>{"match"}, caseLabel);
+         }
+      }
+   }
+   {
+      const std::string caseLabel = "FuzzyIndex::clear";
+      FuzzyIndex index;
+      index.add("colors");
+      index.clear();
+
+      VERIFY(index.empty(), caseLabel);
+      VERIFY(index.rank("c", 10).empty(), caseLabel);
+   }
+}
+
+
+
+void testFuzzyIndexNarrow()
+{
+   {
+      const std::string caseLabel = "FuzzyIndex::narrow for extended pattern";
+      FuzzyIndex index;
+      index.add("colors");
+      index.add("clear");
+      index.add("cool");
+      index.add("fontsize");
+
+      std::vector<FuzzyMatch> matches = index.match("c");
+      VERIFY(matches.size() == 3, caseLabel);
+
+      index.narrow(matches, "co");
+      VERIFY(index.best(matches, 10) == std::vector<std::string>({"cool", "colors"}),
+             caseLabel);
+
+      index.narrow(matches, "col");
+      VERIFY(index.best(matches, 10) == std::vector<std::string>({"colors", "cool"}),
+             caseLabel);
+      VERIFY(index.best(matches, 10) == index.rank("col", 10), caseLabel);
+   }
+   {
+      const std::string caseLabel = "FuzzyIndex::narrow for no remaining matches";
+      FuzzyIndex index;
+      index.add("colors");
+
+      std::vector<FuzzyMatch> matches = index.match("c");
+      index.narrow(matches, "cx");
+      VERIFY(matches.empty(), caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testFuzzyIndex()
+{
+   testFuzzyScore();
+   testCharClassMask();
+   testFuzzyIndexRank();
+   testFuzzyIndexNarrow();
+}
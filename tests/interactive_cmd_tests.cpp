@@ -0,0 +1,213 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "interactive_cmd_tests.h"
+#include "interactive_cmd.h"
+#include "output_sink.h"
+#include "test_util.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+// Outputs a line per step.
+class CountingCmd : public InteractiveCmd
+{
+ public:
+   explicit CountingCmd(int numSteps) : m_numSteps{numSteps} {}
+
+   CmdStep start(const VerifiedCmd&, OutputSink& out) override { return step(out); }
+   CmdStep resume(OutputSink& out) override { return step(out); }
+
+ private:
+   CmdStep step(OutputSink& out)
+   {
+      out.writeLine(std::to_string(m_step++));
+      return m_step < m_numSteps ? CmdStep::Continue : CmdStep::Done;
+   }
+
+ private:
+   int m_numSteps = 0;
+   int m_step = 0;
+};
+
+
+// Continues without output until it is cancelled by its own step.
+class SilentCmd : public InteractiveCmd
+{
+ public:
+   explicit SilentCmd(CancellationSource* cancellation) : m_cancellation{cancellation} {}
+
+   CmdStep start(const VerifiedCmd&, OutputSink&) override { return CmdStep::Continue; }
+   CmdStep resume(OutputSink&) override
+   {
+      if (++numResumed == 3)
+         m_cancellation->cancel();
+      return CmdStep::Continue;
+   }
+
+   int numResumed = 0;
+
+ private:
+   CancellationSource* m_cancellation = nullptr;
+};
+
+
+// Waits until it made progress a given number of times.
+class AwaitingCmd : public InteractiveCmd
+{
+ public:
+   explicit AwaitingCmd(int numProgress) : m_numProgress{numProgress} {}
+
+   CmdStep start(const VerifiedCmd&, OutputSink&) override { return CmdStep::Wait; }
+   CmdStep resume(OutputSink&) override
+   {
+      ++numResumed;
+      return numAwaited < m_numProgress ? CmdStep::Wait : CmdStep::Done;
+   }
+   void awaitProgress(const CancellationToken&) override { ++numAwaited; }
+
+   int numResumed = 0;
+   int numAwaited = 0;
+
+ private:
+   int m_numProgress = 0;
+};
+
+
+// Waits for a thread that wakes it up.
+class WakingCmd : public InteractiveCmd
+{
+ public:
+   ~WakingCmd() override
+   {
+      if (m_waker.joinable())
+         m_waker.join();
+   }
+
+   CmdStep start(const VerifiedCmd&, OutputSink&) override
+   {
+      m_waker = std::thread{[this]() {
+         m_isWoken = true;
+         wakeUp();
+      }};
+      return CmdStep::Wait;
+   }
+   CmdStep resume(OutputSink& out) override
+   {
+      if (!m_isWoken)
+         return CmdStep::Wait;
+      out.writeLine("woken");
+      return CmdStep::Done;
+   }
+
+ private:
+   std::atomic<bool> m_isWoken = false;
+   std::thread m_waker;
+};
+
+
+struct PromptingCmd : public InteractiveCmd
+{
+   CmdStep start(const VerifiedCmd&, OutputSink& out) override
+   {
+      out.writeLine("Proceed?");
+      return CmdStep::AwaitInput;
+   }
+};
+
+
+///////////////////
+
+void testInteractiveCmdExecute()
+{
+   {
+      const std::string caseLabel = "InteractiveCmd::execute executes all steps";
+      CountingCmd cmd{3};
+      CollectingOutputSink out;
+      cmd.execute(VerifiedCmd{}, out);
+      VERIFY(out.lines() == std::vector<std::string>({"0", "1", "2"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "InteractiveCmd::execute for vector output";
+      CountingCmd cmd{2};
+      const CmdOutput output = cmd.execute(VerifiedCmd{});
+      VERIFY(output == CmdOutput({"0", "1"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "InteractiveCmd::execute fails for awaited input";
+      PromptingCmd cmd;
+      CollectingOutputSink out;
+      cmd.execute(VerifiedCmd{}, out);
+      VERIFY(out.lines() ==
+                std::vector<std::string>({"Proceed?", "Command requires user input."}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "InteractiveCmd::execute stops when cancelled";
+      CancellationSource cancellation;
+      SilentCmd cmd{&cancellation};
+      CollectingOutputSink out;
+      out.setCancellation(cancellation.token());
+      cmd.execute(VerifiedCmd{}, out);
+      VERIFY(cmd.numResumed == 3, caseLabel);
+   }
+   {
+      const std::string caseLabel = "InteractiveCmd::execute awaits progress between steps";
+      AwaitingCmd cmd{2};
+      CollectingOutputSink out;
+      cmd.execute(VerifiedCmd{}, out);
+      VERIFY(cmd.numAwaited == 2, caseLabel);
+      VERIFY(cmd.numResumed == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "InteractiveCmd::execute waits until woken up";
+      WakingCmd cmd;
+      CollectingOutputSink out;
+      cmd.execute(VerifiedCmd{}, out);
+      VERIFY(out.lines() == std::vector<std::string>{"woken"}, caseLabel);
+   }
+}
+
+
+void testInteractiveCmdDefaultSteps()
+{
+   {
+      const std::string caseLabel = "InteractiveCmd default steps finish the command";
+      PromptingCmd cmd;
+      CollectingOutputSink out;
+      VERIFY(cmd.resume(out) == CmdStep::Done, caseLabel);
+      VERIFY(cmd.resumeWithInput("y", out) == CmdStep::Done, caseLabel);
+      VERIFY(out.lines().empty(), caseLabel);
+   }
+}
+
+
+void testInteractiveCmdThreadAffinity()
+{
+   {
+      const std::string caseLabel = "InteractiveCmd executes on UI thread";
+      PromptingCmd cmd;
+      VERIFY(cmd.threadAffinity() == CmdThreadAffinity::UIThread, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testInteractiveCmd()
+{
+   testInteractiveCmdExecute();
+   testInteractiveCmdDefaultSteps();
+   testInteractiveCmdThreadAffinity();
+}
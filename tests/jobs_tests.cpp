@@ -0,0 +1,321 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "jobs_tests.h"
+#include "jobs.h"
+#include "output_sink.h"
+#include "test_util.h"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void testToJobStatus()
+{
+   {
+      const std::string caseLabel = "toJobStatus";
+      VERIFY(toJobStatus(CancelReason::None) == JobStatus::Done, caseLabel);
+      VERIFY(toJobStatus(CancelReason::Cancelled) == JobStatus::Cancelled, caseLabel);
+      VERIFY(toJobStatus(CancelReason::TimedOut) == JobStatus::TimedOut, caseLabel);
+   }
+}
+
+
+void testWriteJobOutput()
+{
+   {
+      const std::string caseLabel = "writeJobOutput";
+      JobOutputBatch batch;
+      batch.lines = {"a", "b"};
+      CollectingOutputSink out;
+      writeJobOutput(batch, out);
+      VERIFY(out.lines() == std::vector<std::string>({"a", "b"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "writeJobOutput for dropped lines";
+      JobOutputBatch batch;
+      batch.lines = {"c"};
+      batch.numDropped = 2;
+      CollectingOutputSink out;
+      writeJobOutput(batch, out);
+      VERIFY(out.lines() == std::vector<std::string>({"... 2 lines dropped", "c"}),
+             caseLabel);
+   }
+}
+
+
+void testJobOutputPush()
+{
+   {
+      const std::string caseLabel = "JobOutput::push reports first line of batch";
+      JobOutput output;
+      VERIFY(output.push("a"), caseLabel);
+      VERIFY(!output.push("b"), caseLabel);
+      output.takeBatch();
+      VERIFY(output.push("c"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobOutput::push drops oldest lines when full";
+      JobOutput output{2};
+      output.push("a");
+      output.push("b");
+      output.push("c");
+
+      const JobOutputBatch batch = output.takeBatch();
+      VERIFY(batch.lines == std::vector<std::string>({"b", "c"}), caseLabel);
+      VERIFY(batch.numDropped == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobOutput::push waits for space when full";
+      JobOutput output{8, JobOutputOverflow::Wait};
+      constexpr int NumLines = 1000;
+      std::thread producer{[&output]() {
+         for (int i = 0; i < NumLines; ++i)
+            output.push(std::to_string(i));
+         output.finish(JobStatus::Done);
+      }};
+
+      std::vector<std::string> lines;
+      std::size_t numDropped = 0;
+      for (bool isFinal = false; !isFinal;)
+      {
+         JobOutputBatch batch = output.takeBatch();
+         lines.insert(lines.end(), batch.lines.begin(), batch.lines.end());
+         numDropped += batch.numDropped;
+         isFinal = batch.isFinal;
+      }
+      producer.join();
+
+      VERIFY(lines.size() == NumLines, caseLabel);
+      VERIFY(lines.front() == "0" && lines.back() == std::to_string(NumLines - 1),
+             caseLabel);
+      VERIFY(numDropped == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobOutput::push stops waiting when cancelled";
+      JobOutput output{1, JobOutputOverflow::Wait};
+      CancellationSource cancellation;
+      output.push("a");
+      std::thread producer{[&output, token = cancellation.token()]() {
+         output.push("b", token);
+      }};
+      cancellation.cancel();
+      producer.join();
+
+      const JobOutputBatch batch = output.takeBatch();
+      VERIFY(batch.lines == std::vector<std::string>{"b"}, caseLabel);
+      VERIFY(batch.numDropped == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobOutput::push stops waiting when dropping lines";
+      JobOutput output{1, JobOutputOverflow::Wait};
+      output.push("a");
+      std::thread producer{[&output]() { output.push("b"); }};
+      output.setOverflow(JobOutputOverflow::DropOldest);
+      producer.join();
+
+      const JobOutputBatch batch = output.takeBatch();
+      VERIFY(batch.lines == std::vector<std::string>{"b"}, caseLabel);
+      VERIFY(batch.numDropped == 1, caseLabel);
+   }
+}
+
+
+void testJobOutputTakeBatch()
+{
+   {
+      const std::string caseLabel = "JobOutput::takeBatch for running job";
+      JobOutput output;
+      output.push("a");
+      output.push("b");
+
+      const JobOutputBatch batch = output.takeBatch();
+      VERIFY(batch.lines == std::vector<std::string>({"a", "b"}), caseLabel);
+      VERIFY(batch.numDropped == 0, caseLabel);
+      VERIFY(!batch.isFinal, caseLabel);
+      VERIFY(!output.hasLines(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobOutput::takeBatch for finished job";
+      JobOutput output;
+      output.push("a");
+      output.finish(JobStatus::Done);
+
+      const JobOutputBatch batch = output.takeBatch();
+      VERIFY(batch.lines == std::vector<std::string>({"a"}), caseLabel);
+      VERIFY(batch.isFinal, caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobOutput::takeBatch resets dropped lines";
+      JobOutput output{1};
+      output.push("a");
+      output.push("b");
+      output.takeBatch();
+      output.push("c");
+      VERIFY(output.takeBatch().numDropped == 0, caseLabel);
+   }
+}
+
+
+void testJobOutputWaitForOutput()
+{
+   {
+      const std::string caseLabel = "JobOutput::waitForOutput wakes for first line";
+      JobOutput output;
+      std::thread producer{[&output]() { output.push("a"); }};
+      output.waitForOutput(CancellationToken{});
+      VERIFY(output.hasLines(), caseLabel);
+      producer.join();
+   }
+   {
+      const std::string caseLabel = "JobOutput::waitForOutput wakes for finished job";
+      JobOutput output;
+      std::thread producer{[&output]() { output.finish(JobStatus::Done); }};
+      output.waitForOutput(CancellationToken{});
+      VERIFY(output.status() == JobStatus::Done, caseLabel);
+      producer.join();
+   }
+   {
+      const std::string caseLabel = "JobOutput::waitForOutput stops when cancelled";
+      JobOutput output;
+      CancellationSource cancellation;
+      std::thread canceller{[&cancellation]() { cancellation.cancel(); }};
+      output.waitForOutput(cancellation.token());
+      VERIFY(!output.hasLines(), caseLabel);
+      canceller.join();
+   }
+}
+
+
+void testJobOutputStatus()
+{
+   {
+      const std::string caseLabel = "JobOutput::status";
+      JobOutput output;
+      VERIFY(output.status() == JobStatus::Running, caseLabel);
+      output.finish(JobStatus::TimedOut);
+      VERIFY(output.status() == JobStatus::TimedOut, caseLabel);
+   }
+}
+
+
+void testDescribeJob()
+{
+   {
+      const std::string caseLabel = "describeJob for foreground job";
+      Job job;
+      job.id = 3;
+      job.cmdLine = "count 5";
+      VERIFY(describeJob(job) == "[3] Running     count 5", caseLabel);
+   }
+   {
+      const std::string caseLabel = "describeJob for finished background job";
+      Job job;
+      job.id = 12;
+      job.cmdLine = "count 5";
+      job.isBackground = true;
+      job.output->finish(JobStatus::TimedOut);
+      VERIFY(describeJob(job) == "[12] Timed out   count 5 &", caseLabel);
+   }
+}
+
+
+void testJobTableAddJob()
+{
+   {
+      const std::string caseLabel = "JobTable::addJob";
+      JobTable jobs;
+      Job& job = jobs.addJob("cmd", true);
+      VERIFY(job.id == 1, caseLabel);
+      VERIFY(job.cmdLine == "cmd", caseLabel);
+      VERIFY(job.isBackground, caseLabel);
+      VERIFY(job.output != nullptr, caseLabel);
+      VERIFY(jobs.size() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobTable::addJob continues after highest id";
+      JobTable jobs;
+      jobs.addJob("a", false);
+      jobs.addJob("b", false);
+      jobs.addJob("c", false);
+      jobs.removeJob(2);
+      VERIFY(jobs.addJob("d", false).id == 4, caseLabel);
+      jobs.removeJob(4);
+      VERIFY(jobs.addJob("e", false).id == 4, caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobTable::addJob restarts ids for empty table";
+      JobTable jobs;
+      jobs.addJob("a", false);
+      jobs.removeJob(1);
+      VERIFY(jobs.addJob("b", false).id == 1, caseLabel);
+   }
+}
+
+
+void testJobTableFindJob()
+{
+   {
+      const std::string caseLabel = "JobTable::findJob for existing job";
+      JobTable jobs;
+      jobs.addJob("a", false);
+      jobs.addJob("b", false);
+      Job* job = jobs.findJob(2);
+      VERIFY(job != nullptr, caseLabel);
+      VERIFY(job->cmdLine == "b", caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobTable::findJob for unknown job";
+      JobTable jobs;
+      jobs.addJob("a", false);
+      VERIFY(jobs.findJob(2) == nullptr, caseLabel);
+   }
+}
+
+
+void testJobTableRemoveJob()
+{
+   {
+      const std::string caseLabel = "JobTable::removeJob by id";
+      JobTable jobs;
+      jobs.addJob("a", false);
+      VERIFY(jobs.removeJob(1), caseLabel);
+      VERIFY(!jobs.removeJob(1), caseLabel);
+      VERIFY(jobs.empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "JobTable::removeJob by position";
+      JobTable jobs;
+      jobs.addJob("a", false);
+      jobs.addJob("b", false);
+      auto next = jobs.removeJob(jobs.begin());
+      VERIFY(next != jobs.end() && next->second.cmdLine == "b", caseLabel);
+      VERIFY(jobs.size() == 1, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testJobs()
+{
+   testToJobStatus();
+   testWriteJobOutput();
+   testJobOutputPush();
+   testJobOutputTakeBatch();
+   testJobOutputWaitForOutput();
+   testJobOutputStatus();
+   testDescribeJob();
+   testJobTableAddJob();
+   testJobTableFindJob();
+   testJobTableRemoveJob();
+}
@@ -0,0 +1,280 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "output_sink_tests.h"
+#include "blackboard.h"
+#include "cancellation.h"
+#include "cmd.h"
+#include "console.h"
+#include "console_ui.h"
+#include "output_sink.h"
+#include "test_util.h"
+#include <chrono>
+#include <memory>
+#include <string>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+struct NullConsoleUI : public ConsoleUI
+{
+   void setContent(ConsoleContent*) override {}
+   void showConsole() override {}
+   void hideConsole() override {}
+   void setBackgroundColor(const sutil::Rgb&) override {}
+   void setOutputTextColor(const sutil::Rgb&) override {}
+   void setInputTextColor(const sutil::Rgb&) override {}
+   void resetColors() override {}
+   void setFontSize(int) override {}
+   void notifyPendingOutput() override {}
+};
+
+
+// Command that writes its output to a sink.
+struct SinkWritingCmd : public StreamingCmd
+{
+   using StreamingCmd::execute;
+   void execute(const VerifiedCmd&, OutputSink& out) override
+   {
+      out.writeLine("first");
+      out.write("sec");
+      out.write("ond\nthi");
+      out.writeLine("rd");
+   }
+};
+
+
+// Command that returns its output as vector.
+struct VectorCmd : public Cmd
+{
+   using Cmd::execute;
+   CmdOutput execute(const VerifiedCmd&) override { return {"one", "two\nthree"}; }
+};
+
+
+///////////////////
+
+void testOutputSinkWriteLine()
+{
+   {
+      const std::string caseLabel = "OutputSink::writeLine for single line";
+      CollectingOutputSink out;
+      out.writeLine("line");
+      VERIFY(out.lines() == std::vector<std::string>({"line"}), caseLabel);
+      VERIFY(out.countLines() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "OutputSink::writeLine for empty line";
+      CollectingOutputSink out;
+      out.writeLine("");
+      VERIFY(out.lines() == std::vector<std::string>({""}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "OutputSink::writeLine for embedded line breaks";
+      CollectingOutputSink out;
+      out.writeLine("a\nb\n");
+      VERIFY(out.lines() == std::vector<std::string>({"a", "b", ""}), caseLabel);
+      VERIFY(out.countLines() == 3, caseLabel);
+   }
+}
+
+
+void testOutputSinkWrite()
+{
+   {
+      const std::string caseLabel = "OutputSink::write without line break";
+      CollectingOutputSink out;
+      out.write("abc");
+      VERIFY(out.lines().empty(), caseLabel);
+      out.flush();
+      VERIFY(out.lines() == std::vector<std::string>({"abc"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "OutputSink::write for chunks across line breaks";
+      CollectingOutputSink out;
+      out.write("ab");
+      out.write("c\nde");
+      out.write("\n\nf");
+      VERIFY(out.lines() == std::vector<std::string>({"abc", "de", ""}), caseLabel);
+      out.flush();
+      VERIFY(out.lines() == std::vector<std::string>({"abc", "de", "", "f"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "OutputSink::writeLine completes pending text";
+      CollectingOutputSink out;
+      out.write("ab");
+      out.writeLine("c");
+      VERIFY(out.lines() == std::vector<std::string>({"abc"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "OutputSink::flush without pending text";
+      CollectingOutputSink out;
+      out.write("ab\n");
+      out.flush();
+      VERIFY(out.lines() == std::vector<std::string>({"ab"}), caseLabel);
+   }
+}
+
+
+void testOutputSinkCancellation()
+{
+   {
+      const std::string caseLabel = "OutputSink without cancellation";
+      CollectingOutputSink out;
+      VERIFY(!out.isCancelled(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "OutputSink::writeLine throws when cancelled";
+      CancellationSource source;
+      CollectingOutputSink out;
+      out.setCancellation(source.token());
+      out.writeLine("before");
+      source.cancel();
+
+      VERIFY(out.isCancelled(), caseLabel);
+      bool hasThrown = false;
+      try
+      {
+         out.writeLine("after");
+      }
+      catch (const CancelledError& err)
+      {
+         hasThrown = err.reason() == CancelReason::Cancelled;
+      }
+      VERIFY(hasThrown, caseLabel);
+      VERIFY(out.lines() == std::vector<std::string>({"before"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "OutputSink::write throws when timed out";
+      CancellationSource source;
+      source.cancelAfter(std::chrono::milliseconds{0});
+      CollectingOutputSink out;
+      out.setCancellation(source.token());
+
+      bool hasThrown = false;
+      try
+      {
+         out.write("text");
+      }
+      catch (const CancelledError& err)
+      {
+         hasThrown = err.reason() == CancelReason::TimedOut;
+      }
+      VERIFY(hasThrown, caseLabel);
+   }
+   {
+      const std::string caseLabel = "OutputSink::flush keeps partial output when cancelled";
+      CancellationSource source;
+      CollectingOutputSink out;
+      out.setCancellation(source.token());
+      out.write("partial");
+      source.cancel();
+
+      out.flush();
+
+      VERIFY(out.lines() == std::vector<std::string>({"partial"}), caseLabel);
+   }
+}
+
+
+void testCmdExecuteAdapters()
+{
+   {
+      const std::string caseLabel = "Cmd::execute with sink for command that returns vector";
+      VectorCmd cmd;
+      CollectingOutputSink out;
+      static_cast<Cmd&>(cmd).execute(VerifiedCmd{}, out);
+      VERIFY(out.lines() == std::vector<std::string>({"one", "two", "three"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Cmd::execute with vector for command that streams";
+      SinkWritingCmd cmd;
+      const CmdOutput out = static_cast<Cmd&>(cmd).execute(VerifiedCmd{});
+      VERIFY(out == CmdOutput({"first", "second", "third"}), caseLabel);
+   }
+}
+
+
+void testBlackboardOutputSink()
+{
+   {
+      const std::string caseLabel = "BlackboardOutputSink inserts lines before input line";
+      Blackboard bb{"> "};
+      BlackboardOutputSink out{bb};
+      out.writeLine("a\nb");
+      VERIFY(bb.countLines() == 3, caseLabel);
+      VERIFY(bb.lineText(0) == "a", caseLabel);
+      VERIFY(bb.lineText(1) == "b", caseLabel);
+      VERIFY(!bb.isEnteredLine(1), caseLabel);
+      VERIFY(bb.inputLineText() == "> ", caseLabel);
+   }
+}
+
+
+void testConsoleStreamsOutput()
+{
+   {
+      const std::string caseLabel = "Console displays output of streaming command";
+      NullConsoleUI ui;
+      Console console{ui};
+      console.addCommand(CmdSpec{"stream", "", "", {}, ""},
+                         []() { return std::make_unique<SinkWritingCmd>(); });
+
+      console.setInputLine("> stream");
+      console.processInputLine();
+      console.waitForCommands();
+
+      // Entered line, three output lines, separator line, new input line.
+      VERIFY(console.countLines() == 6, caseLabel);
+      VERIFY(console.lineText(1) == "first", caseLabel);
+      VERIFY(console.lineText(2) == "second", caseLabel);
+      VERIFY(console.lineText(3) == "third", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console splits vector output at line breaks";
+      NullConsoleUI ui;
+      Console console{ui};
+      console.addCommand(CmdSpec{"vec", "", "", {}, ""},
+                         []() { return std::make_unique<VectorCmd>(); });
+
+      console.setInputLine("> vec");
+      console.processInputLine();
+      console.waitForCommands();
+
+      VERIFY(console.countLines() == 6, caseLabel);
+      VERIFY(console.lineText(1) == "one", caseLabel);
+      VERIFY(console.lineText(2) == "two", caseLabel);
+      VERIFY(console.lineText(3) == "three", caseLabel);
+   }
+   {
+      const std::string caseLabel = "Console displays output of help command";
+      NullConsoleUI ui;
+      Console console{ui};
+
+      console.setInputLine("> help");
+      console.processInputLine();
+
+      VERIFY(console.lineText(1) == "Commands:", caseLabel);
+      VERIFY(console.lineText(2).find("  :colors - ") == 0, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testOutputSink()
+{
+   testOutputSinkWriteLine();
+   testOutputSinkWrite();
+   testOutputSinkCancellation();
+   testCmdExecuteAdapters();
+   testBlackboardOutputSink();
+   testConsoleStreamsOutput();
+}
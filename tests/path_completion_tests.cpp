@@ -0,0 +1,310 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "path_completion_tests.h"
+#include "auto_completion.h"
+#include "path_completion.h"
+#include "test_util.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace ccon;
+namespace fs = std::filesystem;
+
+
+namespace
+{
+///////////////////
+
+// Directory in the temp folder that gets removed with its content when going out of
+// scope.
+class TempDir
+{
+ public:
+   TempDir()
+   {
+      static int counter = 0;
+      const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+      m_path = fs::temp_directory_path() /
+               ("ccon_tests_" + std::to_string(now) + "_" + std::to_string(++counter));
+      fs::create_directories(m_path);
+   }
+   ~TempDir()
+   {
+      std::error_code ec;
+      fs::remove_all(m_path, ec);
+   }
+   TempDir(const TempDir&) = delete;
+   TempDir(TempDir&&) = delete;
+   TempDir& operator=(const TempDir&) = delete;
+   TempDir& operator=(TempDir&&) = delete;
+
+   const fs::path& path() const { return m_path; }
+
+   void addFile(const std::string& name) const { std::ofstream{m_path / name}; }
+   void addDir(const std::string& name) const { fs::create_directories(m_path / name); }
+
+ private:
+   fs::path m_path;
+};
+
+
+std::vector<std::string> names(const std::optional<std::vector<DirEntry>>& entries)
+{
+   std::vector<std::string> result;
+   if (entries)
+      for (const DirEntry& entry : *entries)
+         result.push_back(entry.name);
+   return result;
+}
+
+
+///////////////////
+
+void testDirectoryCacheFind()
+{
+   {
+      const std::string caseLabel = "DirectoryCache::find for entries with prefix";
+      TempDir dir;
+      dir.addFile("beta");
+      dir.addFile("alpha");
+      dir.addDir("alpine");
+      dir.addFile("gamma");
+      DirectoryCache cache;
+
+      const std::optional<std::vector<DirEntry>> entries = cache.find(dir.path(), "al");
+      VERIFY(names(entries) == std::vector<std::string>({"alpha", "alpine"}), caseLabel);
+      VERIFY(!(*entries)[0].isDirectory && (*entries)[1].isDirectory, caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache::find for empty prefix";
+      TempDir dir;
+      dir.addFile("b");
+      dir.addFile("a");
+      DirectoryCache cache;
+
+      VERIFY(names(cache.find(dir.path(), "")) == std::vector<std::string>({"a", "b"}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache::find for no matching entries";
+      TempDir dir;
+      dir.addFile("a");
+      DirectoryCache cache;
+
+      const std::optional<std::vector<DirEntry>> entries = cache.find(dir.path(), "x");
+      VERIFY(entries && entries->empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache::find for missing directory";
+      TempDir dir;
+      DirectoryCache cache;
+
+      VERIFY(!cache.find(dir.path() / "missing", ""), caseLabel);
+      VERIFY(cache.size() == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache::find for many entries";
+      TempDir dir;
+      for (int i = 0; i < 1000; ++i)
+         dir.addFile("file" + std::to_string(i));
+      DirectoryCache cache;
+
+      VERIFY(cache.find(dir.path(), "file")->size() == 1000, caseLabel);
+      VERIFY(names(cache.find(dir.path(), "file99")) ==
+                std::vector<std::string>({"file99", "file990", "file991", "file992",
+                                          "file993", "file994", "file995", "file996",
+                                          "file997", "file998", "file999"}),
+             caseLabel);
+   }
+}
+
+
+void testDirectoryCacheInvalidation()
+{
+   {
+      const std::string caseLabel = "DirectoryCache reuses listing of unchanged directory";
+      TempDir dir;
+      dir.addFile("a");
+      DirectoryCache cache;
+
+      cache.find(dir.path(), "");
+      cache.find(dir.path(), "a");
+      // Different paths of the same directory.
+      cache.find(dir.path() / ".", "");
+      VERIFY(cache.countScans() == 1, caseLabel);
+      VERIFY(cache.size() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache for added entry";
+      TempDir dir;
+      dir.addFile("a");
+      DirectoryCache cache;
+
+      cache.find(dir.path(), "");
+      dir.addFile("b");
+      VERIFY(names(cache.find(dir.path(), "")) == std::vector<std::string>({"a", "b"}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache for removed entry";
+      TempDir dir;
+      dir.addFile("a");
+      dir.addFile("b");
+      DirectoryCache cache;
+
+      cache.find(dir.path(), "");
+      fs::remove(dir.path() / "a");
+      VERIFY(names(cache.find(dir.path(), "")) == std::vector<std::string>{"b"},
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache for renamed entry";
+      TempDir dir;
+      dir.addFile("a");
+      DirectoryCache cache;
+
+      cache.find(dir.path(), "");
+      fs::rename(dir.path() / "a", dir.path() / "c");
+      VERIFY(names(cache.find(dir.path(), "")) == std::vector<std::string>{"c"},
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache for removed directory";
+      TempDir dir;
+      dir.addDir("sub");
+      DirectoryCache cache;
+
+      VERIFY(cache.find(dir.path() / "sub", "").has_value(), caseLabel);
+      fs::remove(dir.path() / "sub");
+      VERIFY(!cache.find(dir.path() / "sub", ""), caseLabel);
+      VERIFY(cache.size() == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache::clear";
+      TempDir dir;
+      DirectoryCache cache;
+
+      cache.find(dir.path(), "");
+      cache.clear();
+      VERIFY(cache.size() == 0, caseLabel);
+      cache.find(dir.path(), "");
+      VERIFY(cache.countScans() == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "DirectoryCache evicts least recently used listing";
+      TempDir dir;
+      dir.addDir("a");
+      dir.addDir("b");
+      dir.addDir("c");
+      DirectoryCache cache{2};
+
+      cache.find(dir.path() / "a", "");
+      cache.find(dir.path() / "b", "");
+      cache.find(dir.path() / "a", "");
+      cache.find(dir.path() / "c", "");
+      VERIFY(cache.size() == 2, caseLabel);
+      VERIFY(cache.countScans() == 3, caseLabel);
+      // Still cached.
+      cache.find(dir.path() / "a", "");
+      VERIFY(cache.countScans() == 3, caseLabel);
+      // Evicted.
+      cache.find(dir.path() / "b", "");
+      VERIFY(cache.countScans() == 4, caseLabel);
+   }
+}
+
+
+void testPathCompletionProvider()
+{
+   const char sep = static_cast<char>(fs::path::preferred_separator);
+
+   {
+      const std::string caseLabel = "PathCompletionProvider for relative path";
+      TempDir dir;
+      dir.addFile("notes.txt");
+      dir.addDir("nested");
+      dir.addFile("nested/inner.txt");
+      PathCompletionProvider provider{dir.path()};
+
+      VERIFY(provider.complete("n") ==
+                std::vector<std::string>({std::string{"nested"} + sep, "notes.txt"}),
+             caseLabel);
+      VERIFY(provider.complete("nested/") == std::vector<std::string>{"nested/inner.txt"},
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "PathCompletionProvider for absolute path";
+      TempDir dir;
+      dir.addFile("file");
+      PathCompletionProvider provider;
+
+      const std::string prefix = (dir.path() / "f").string();
+      VERIFY(provider.complete(prefix) ==
+                std::vector<std::string>{(dir.path() / "file").string()},
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "PathCompletionProvider for hidden entries";
+      TempDir dir;
+      dir.addFile(".hidden");
+      dir.addFile("visible");
+      PathCompletionProvider provider{dir.path()};
+
+      VERIFY(provider.complete("") == std::vector<std::string>{"visible"}, caseLabel);
+      VERIFY(provider.complete(".") == std::vector<std::string>{".hidden"}, caseLabel);
+   }
+   {
+      const std::string caseLabel = "PathCompletionProvider for missing directory";
+      TempDir dir;
+      PathCompletionProvider provider{dir.path()};
+
+      const std::optional<std::vector<std::string>> completions =
+         provider.complete("missing/a");
+      VERIFY(completions && completions->empty(), caseLabel);
+   }
+}
+
+
+void testAutoCompletionOfPaths()
+{
+   {
+      const std::string caseLabel = "AutoCompletion for value of path argument";
+      TempDir dir;
+      dir.addFile("report.txt");
+      dir.addFile("readme.md");
+      std::set<CmdSpec> specs = {
+         {"open",
+          "",
+          "",
+          {ArgSpec::makeOptionalArg("file", 1, "f", "", ValueKind::Path)},
+          ""}};
+      AutoCompletion ac;
+      ac.setCmds(specs);
+
+      const std::string input = "open -file " + (dir.path() / "rep").string();
+      VERIFY(ac.all(input) ==
+                std::vector<std::string>{"open -file " +
+                                         (dir.path() / "report.txt").string()},
+             caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testPathCompletion()
+{
+   testDirectoryCacheFind();
+   testDirectoryCacheInvalidation();
+   testPathCompletionProvider();
+   testAutoCompletionOfPaths();
+}
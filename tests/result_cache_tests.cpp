@@ -0,0 +1,203 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "result_cache_tests.h"
+#include "result_cache.h"
+#include "symbol_table.h"
+#include "test_util.h"
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+VerifiedArg makeArg(const std::string& label, std::vector<std::string> values,
+                    std::size_t specIdx)
+{
+   VerifiedArg arg;
+   arg.label = label;
+   arg.values = std::move(values);
+   arg.specIdx = specIdx;
+   return arg;
+}
+
+
+VerifiedCmd makeCmd(const std::string& name, VerifiedArgs args)
+{
+   VerifiedCmd cmd;
+   cmd.name = name;
+   cmd.nameId = internSymbol(name);
+   cmd.args = std::move(args);
+   return cmd;
+}
+
+
+///////////////////
+
+void testMakeResultKey()
+{
+   {
+      const std::string caseLabel = "makeResultKey ignores order of optional args";
+      const VerifiedCmd a = makeCmd(
+         "cmd", {makeArg("", {"x"}, 0), makeArg("a", {"1"}, 1), makeArg("b", {}, 2)});
+      const VerifiedCmd b = makeCmd(
+         "cmd", {makeArg("", {"x"}, 0), makeArg("b", {}, 2), makeArg("a", {"1"}, 1)});
+      VERIFY(makeResultKey(a) == makeResultKey(b), caseLabel);
+   }
+   {
+      const std::string caseLabel = "makeResultKey for different values";
+      const VerifiedCmd a = makeCmd("cmd", {makeArg("", {"x"}, 0)});
+      const VerifiedCmd b = makeCmd("cmd", {makeArg("", {"y"}, 0)});
+      VERIFY(makeResultKey(a) != makeResultKey(b), caseLabel);
+   }
+   {
+      const std::string caseLabel = "makeResultKey for different commands";
+      const VerifiedCmd a = makeCmd("cmd1", {makeArg("", {"x"}, 0)});
+      const VerifiedCmd b = makeCmd("cmd2", {makeArg("", {"x"}, 0)});
+      VERIFY(makeResultKey(a) != makeResultKey(b), caseLabel);
+   }
+   {
+      const std::string caseLabel = "makeResultKey for differently split values";
+      const VerifiedCmd a = makeCmd("cmd", {makeArg("", {"ab", "c"}, 0)});
+      const VerifiedCmd b = makeCmd("cmd", {makeArg("", {"a", "bc"}, 0)});
+      VERIFY(makeResultKey(a) != makeResultKey(b), caseLabel);
+   }
+}
+
+
+void testCmdResultCacheFind()
+{
+   {
+      const std::string caseLabel = "CmdResultCache::find for stored result";
+      CmdResultCache cache;
+      cache.insert("key", internSymbol("cmd"), {"a", "b"}, cache.generation());
+
+      const std::optional<CmdOutput> result = cache.find("key");
+
+      VERIFY(result.has_value(), caseLabel);
+      VERIFY(*result == CmdOutput({"a", "b"}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdResultCache::find for unknown key";
+      CmdResultCache cache;
+      cache.insert("key", internSymbol("cmd"), {"a"}, cache.generation());
+      VERIFY(!cache.find("other").has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdResultCache::find for expired result";
+      CmdResultCache cache{10, std::chrono::milliseconds{10}};
+      cache.insert("key", internSymbol("cmd"), {"a"}, cache.generation());
+
+      std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+      VERIFY(!cache.find("key").has_value(), caseLabel);
+      VERIFY(cache.size() == 0, caseLabel);
+   }
+}
+
+
+void testCmdResultCacheInsert()
+{
+   {
+      const std::string caseLabel = "CmdResultCache::insert evicts least recently used";
+      CmdResultCache cache{2};
+      cache.insert("a", internSymbol("cmd"), {"1"}, cache.generation());
+      cache.insert("b", internSymbol("cmd"), {"2"}, cache.generation());
+      cache.find("a");
+
+      cache.insert("c", internSymbol("cmd"), {"3"}, cache.generation());
+
+      VERIFY(cache.size() == 2, caseLabel);
+      VERIFY(cache.find("a").has_value(), caseLabel);
+      VERIFY(!cache.find("b").has_value(), caseLabel);
+      VERIFY(cache.find("c").has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdResultCache::insert replaces existing result";
+      CmdResultCache cache;
+      cache.insert("a", internSymbol("cmd"), {"1"}, cache.generation());
+      cache.insert("a", internSymbol("cmd"), {"2"}, cache.generation());
+
+      VERIFY(cache.size() == 1, caseLabel);
+      VERIFY(*cache.find("a") == CmdOutput{"2"}, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdResultCache::insert for outdated generation";
+      CmdResultCache cache;
+      const std::uint64_t startGeneration = cache.generation();
+      cache.invalidateAll();
+
+      cache.insert("a", internSymbol("cmd"), {"1"}, startGeneration);
+
+      VERIFY(!cache.find("a").has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdResultCache::insert for cache without space";
+      CmdResultCache cache{0};
+      cache.insert("a", internSymbol("cmd"), {"1"}, cache.generation());
+      VERIFY(cache.size() == 0, caseLabel);
+   }
+}
+
+
+void testCmdResultCacheInvalidate()
+{
+   {
+      const std::string caseLabel = "CmdResultCache::invalidate for one command";
+      CmdResultCache cache;
+      cache.insert("a1", internSymbol("cmdA"), {"1"}, cache.generation());
+      cache.insert("b", internSymbol("cmdB"), {"2"}, cache.generation());
+      cache.insert("a2", internSymbol("cmdA"), {"3"}, cache.generation());
+
+      cache.invalidate(internSymbol("cmdA"));
+
+      VERIFY(cache.size() == 1, caseLabel);
+      VERIFY(cache.find("b").has_value(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "CmdResultCache::invalidateAll";
+      CmdResultCache cache;
+      cache.insert("a", internSymbol("cmdA"), {"1"}, cache.generation());
+      cache.insert("b", internSymbol("cmdB"), {"2"}, cache.generation());
+
+      cache.invalidateAll();
+
+      VERIFY(cache.size() == 0, caseLabel);
+   }
+}
+
+
+void testCmdResultCacheSetLimits()
+{
+   {
+      const std::string caseLabel = "CmdResultCache::setLimits evicts excess results";
+      CmdResultCache cache;
+      cache.insert("a", internSymbol("cmd"), {"1"}, cache.generation());
+      cache.insert("b", internSymbol("cmd"), {"2"}, cache.generation());
+
+      cache.setLimits(1, std::nullopt);
+
+      VERIFY(cache.size() == 1, caseLabel);
+      VERIFY(cache.find("b").has_value(), caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testResultCache()
+{
+   testMakeResultKey();
+   testCmdResultCacheFind();
+   testCmdResultCacheInsert();
+   testCmdResultCacheInvalidate();
+   testCmdResultCacheSetLimits();
+}
@@ -0,0 +1,163 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "ring_buffer_tests.h"
+#include "ring_buffer.h"
+#include "test_util.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+std::vector<int> drainAll(RingBuffer<int>& buffer)
+{
+   std::vector<int> items;
+   buffer.drain([&items](int item) { items.push_back(item); });
+   return items;
+}
+
+
+///////////////////
+
+void testRingBufferCtor()
+{
+   {
+      const std::string caseLabel = "RingBuffer ctor";
+      RingBuffer<int> buffer{3};
+      VERIFY(buffer.capacity() == 3, caseLabel);
+      VERIFY(buffer.size() == 0, caseLabel);
+      VERIFY(buffer.empty(), caseLabel);
+      VERIFY(!buffer.full(), caseLabel);
+   }
+}
+
+
+void testRingBufferPush()
+{
+   {
+      const std::string caseLabel = "RingBuffer::push below capacity";
+      RingBuffer<int> buffer{3};
+      VERIFY(!buffer.push(1), caseLabel);
+      VERIFY(!buffer.push(2), caseLabel);
+      VERIFY(buffer.size() == 2, caseLabel);
+      VERIFY(drainAll(buffer) == std::vector<int>({1, 2}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "RingBuffer::push up to capacity";
+      RingBuffer<int> buffer{3};
+      buffer.push(1);
+      buffer.push(2);
+      VERIFY(!buffer.push(3), caseLabel);
+      VERIFY(buffer.full(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "RingBuffer::push overwrites oldest items when full";
+      RingBuffer<int> buffer{3};
+      for (int i = 1; i <= 3; ++i)
+         buffer.push(i);
+      VERIFY(buffer.push(4), caseLabel);
+      VERIFY(buffer.push(5), caseLabel);
+      VERIFY(buffer.size() == 3, caseLabel);
+      VERIFY(drainAll(buffer) == std::vector<int>({3, 4, 5}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "RingBuffer::push after pop keeps order";
+      RingBuffer<int> buffer{4};
+      buffer.push(1);
+      buffer.push(2);
+      buffer.push(3);
+      buffer.pop();
+      buffer.push(4);
+      // Grows the storage while the items wrap around.
+      VERIFY(!buffer.push(5), caseLabel);
+      VERIFY(buffer.push(6), caseLabel);
+      VERIFY(drainAll(buffer) == std::vector<int>({3, 4, 5, 6}), caseLabel);
+   }
+   {
+      const std::string caseLabel = "RingBuffer::push for move-only items";
+      RingBuffer<std::unique_ptr<int>> buffer{2};
+      buffer.push(std::make_unique<int>(7));
+      VERIFY(*buffer.pop() == 7, caseLabel);
+   }
+}
+
+
+void testRingBufferPop()
+{
+   {
+      const std::string caseLabel = "RingBuffer::pop returns oldest item";
+      RingBuffer<std::string> buffer{2};
+      buffer.push("a");
+      buffer.push("b");
+      VERIFY(buffer.pop() == "a", caseLabel);
+      VERIFY(buffer.pop() == "b", caseLabel);
+      VERIFY(buffer.empty(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "RingBuffer::pop after wrapping around";
+      RingBuffer<int> buffer{2};
+      buffer.push(1);
+      buffer.push(2);
+      buffer.push(3);
+      VERIFY(buffer.pop() == 2, caseLabel);
+      buffer.push(4);
+      VERIFY(buffer.pop() == 3, caseLabel);
+      VERIFY(buffer.pop() == 4, caseLabel);
+   }
+}
+
+
+void testRingBufferDrain()
+{
+   {
+      const std::string caseLabel = "RingBuffer::drain for empty buffer";
+      RingBuffer<int> buffer{2};
+      VERIFY(buffer.drain([](int) {}) == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "RingBuffer::drain empties the buffer";
+      RingBuffer<int> buffer{2};
+      buffer.push(1);
+      buffer.push(2);
+      VERIFY(buffer.drain([](int) {}) == 2, caseLabel);
+      VERIFY(buffer.empty(), caseLabel);
+   }
+}
+
+
+void testRingBufferClear()
+{
+   {
+      const std::string caseLabel = "RingBuffer::clear";
+      RingBuffer<int> buffer{2};
+      buffer.push(1);
+      buffer.push(2);
+      buffer.push(3);
+      buffer.clear();
+      VERIFY(buffer.empty(), caseLabel);
+      buffer.push(4);
+      VERIFY(drainAll(buffer) == std::vector<int>({4}), caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testRingBuffer()
+{
+   testRingBufferCtor();
+   testRingBufferPush();
+   testRingBufferPop();
+   testRingBufferDrain();
+   testRingBufferClear();
+}
@@ -0,0 +1,158 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "script_parser_tests.h"
+#include "cmd_depot.h"
+#include "cmd_spec.h"
+#include "script_parser.h"
+#include "test_util.h"
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+struct NoopCmd : public Cmd
+{
+   CmdOutput execute(const VerifiedCmd&) override { return {}; }
+};
+
+
+std::shared_ptr<const CmdDepot> makeDepot()
+{
+   auto depot = std::make_shared<CmdDepot>();
+   depot->addCommand(CmdSpec{"cmd", "", "", {ArgSpec::makePositionalArg(1)}, ""},
+                     []() { return std::make_unique<NoopCmd>(); });
+   return depot;
+}
+
+
+// Takes lines until the parser is finished.
+std::vector<ScriptLine> takeAllLines(ScriptParser& parser)
+{
+   std::vector<ScriptLine> lines;
+   while (true)
+   {
+      const bool isParsed = parser.isParsed();
+      for (ScriptLine& line : parser.takeLines())
+         lines.push_back(std::move(line));
+      if (isParsed)
+         return lines;
+      parser.waitForLines(CancellationToken{});
+   }
+}
+
+
+///////////////////
+
+void testScriptParserTakeLines()
+{
+   {
+      const std::string caseLabel = "ScriptParser verifies lines";
+      ScriptParser parser{std::make_unique<std::istringstream>("cmd a\ncmd\nother x\n"),
+                          makeDepot()};
+
+      const std::vector<ScriptLine> lines = takeAllLines(parser);
+
+      VERIFY(lines.size() == 3, caseLabel);
+      VERIFY(lines[0].isMatching && lines[0].areArgsValid, caseLabel);
+      VERIFY(lines[0].cmd.name == "cmd", caseLabel);
+      VERIFY(lines[0].cmd.args[0].values[0] == "a", caseLabel);
+      VERIFY(lines[1].isMatching && !lines[1].areArgsValid, caseLabel);
+      VERIFY(!lines[2].isMatching, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ScriptParser skips empty and comment lines";
+      ScriptParser parser{
+         std::make_unique<std::istringstream>("\n# comment\n  \n  # indented\ncmd a\r\n"),
+         makeDepot()};
+
+      const std::vector<ScriptLine> lines = takeAllLines(parser);
+
+      VERIFY(lines.size() == 1, caseLabel);
+      VERIFY(lines[0].lineNum == 5, caseLabel);
+      VERIFY(lines[0].cmd.args[0].values[0] == "a", caseLabel);
+   }
+   {
+      const std::string caseLabel = "ScriptParser strips background marker";
+      ScriptParser parser{std::make_unique<std::istringstream>("cmd a &\ncmd b\n"),
+                          makeDepot()};
+
+      const std::vector<ScriptLine> lines = takeAllLines(parser);
+
+      VERIFY(lines.size() == 2, caseLabel);
+      VERIFY(lines[0].isBackground, caseLabel);
+      VERIFY(lines[0].isMatching && lines[0].areArgsValid, caseLabel);
+      VERIFY(lines[0].cmd.args[0].values[0] == "a", caseLabel);
+      VERIFY(!lines[1].isBackground, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ScriptParser keeps order of many lines";
+      std::string script;
+      const std::size_t numLines = ScriptParser::MaxLinesAhead + ScriptParser::BatchSize + 3;
+      for (std::size_t i = 0; i < numLines; ++i)
+         script += "cmd " + std::to_string(i) + "\n";
+      ScriptParser parser{std::make_unique<std::istringstream>(script), makeDepot()};
+
+      const std::vector<ScriptLine> lines = takeAllLines(parser);
+
+      VERIFY(lines.size() == numLines, caseLabel);
+      bool isOrdered = true;
+      for (std::size_t i = 0; i < lines.size(); ++i)
+         isOrdered = isOrdered && lines[i].lineNum == i + 1 &&
+                     lines[i].cmd.args[0].values[0] == std::to_string(i);
+      VERIFY(isOrdered, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ScriptParser for empty script";
+      ScriptParser parser{std::make_unique<std::istringstream>(""), makeDepot()};
+      VERIFY(takeAllLines(parser).empty(), caseLabel);
+   }
+}
+
+
+void testScriptParserWaitForLines()
+{
+   {
+      const std::string caseLabel = "ScriptParser::waitForLines for parsed script";
+      ScriptParser parser{std::make_unique<std::istringstream>("cmd a\n"), makeDepot()};
+      parser.waitForLines(CancellationToken{});
+      VERIFY(parser.isParsed() || !parser.takeLines().empty(), caseLabel);
+   }
+}
+
+
+void testScriptParserStop()
+{
+   {
+      const std::string caseLabel = "ScriptParser stops when destroyed";
+      std::string script;
+      for (std::size_t i = 0; i < 2 * ScriptParser::MaxLinesAhead; ++i)
+         script += "cmd x\n";
+
+      // Would block when reading ahead too far without being stopped.
+      {
+         ScriptParser parser{std::make_unique<std::istringstream>(script), makeDepot()};
+      }
+      VERIFY(true, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testScriptParser()
+{
+   testScriptParserTakeLines();
+   testScriptParserWaitForLines();
+   testScriptParserStop();
+}
@@ -0,0 +1,127 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "static_cmd_spec_tests.h"
+#include "cmd_depot.h"
+#include "static_cmd_spec.h"
+#include "test_util.h"
+#include <string>
+#include <variant>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+constexpr StaticArgSpec TestArgSpecs[] = {
+   {"", "", 1, "the target", ValueKind::Int},
+   {"verbose", "v", 0, "more output"},
+   {"mode", "m", 2, "the modes"},
+};
+
+constexpr StaticCmdSpec TestSpec{"Test", "T", "a test command", TestArgSpecs,
+                                 "some notes"};
+constexpr StaticCmdSpec TestSpecWithoutArgs{"plain", "p", "no args"};
+
+
+void testToCmdSpec()
+{
+   {
+      const std::string caseLabel = "toCmdSpec for spec with arguments";
+      const CmdSpec spec = toCmdSpec(TestSpec);
+
+      VERIFY(spec.operator bool(), caseLabel);
+      VERIFY(spec.name() == "test", caseLabel);
+      VERIFY(spec.abbreviation() == "t", caseLabel);
+      VERIFY(spec.description() == "a test command", caseLabel);
+      VERIFY(spec.end() - spec.begin() == 3, caseLabel);
+
+      const ArgSpec& positional = *spec.begin();
+      VERIFY(positional.isRequired(), caseLabel);
+      VERIFY(positional.valueType().kind() == ValueKind::Int, caseLabel);
+      const ArgSpec& flag = *(spec.begin() + 1);
+      VERIFY(!flag.isRequired(), caseLabel);
+      VERIFY(flag.label() == "verbose", caseLabel);
+      const ArgSpec& optional = *(spec.begin() + 2);
+      VERIFY(optional.label() == "mode", caseLabel);
+      VERIFY(optional.valueType().isText(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "toCmdSpec for spec without arguments";
+      const CmdSpec spec = toCmdSpec(TestSpecWithoutArgs);
+
+      VERIFY(spec.name() == "plain", caseLabel);
+      VERIFY(spec.begin() == spec.end(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "toCmdSpec result matches command lines";
+      const CmdSpec spec = toCmdSpec(TestSpec);
+
+      const CmdSpec::Match res = spec.match("test 5 -v -m a b");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.args.size() == 3, caseLabel);
+      VERIFY(std::get<int>(res.matchedCmd.args[0].typedValues[0]) == 5, caseLabel);
+      VERIFY(res.matchedCmd.args[2].values.size() == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "toCmdSpec shares the data of repeated conversions";
+      const CmdSpec a = toCmdSpec(TestSpec);
+      const CmdSpec b = toCmdSpec(TestSpec);
+
+      VERIFY(&a.name() == &b.name(), caseLabel);
+      VERIFY(&*a.begin() == &*b.begin(), caseLabel);
+   }
+}
+
+
+void testCmdSpecCopiesShareData()
+{
+   {
+      const std::string caseLabel = "CmdSpec copies share the spec data";
+      const CmdSpec spec{"name", "n", "descr", {ArgSpec::makePositionalArg(1)}, ""};
+      const CmdSpec copy = spec;
+
+      VERIFY(copy == spec, caseLabel);
+      VERIFY(&copy.description() == &spec.description(), caseLabel);
+      VERIFY(&*copy.begin() == &*spec.begin(), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Moved-from CmdSpec stays valid";
+      CmdSpec spec{"name", "n", "descr", {}, ""};
+      const CmdSpec moved = std::move(spec);
+
+      VERIFY(moved.name() == "name", caseLabel);
+      VERIFY(spec.name() == "name", caseLabel);
+   }
+}
+
+
+void testCmdDepotAddStaticCommand()
+{
+   {
+      const std::string caseLabel = "CmdDepot::addCommand for static spec";
+      CmdDepot depot;
+      depot.addCommand(TestSpec, []() { return std::unique_ptr<Cmd>{}; });
+
+      const CmdSpec* spec = depot.findCommand("t");
+      VERIFY(spec != nullptr, caseLabel);
+      VERIFY(spec->name() == "test", caseLabel);
+      VERIFY(depot.matchCommand("test 1").areArgsValid, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testStaticCmdSpec()
+{
+   testToCmdSpec();
+   testCmdSpecCopiesShareData();
+   testCmdDepotAddStaticCommand();
+}
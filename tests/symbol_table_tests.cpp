@@ -0,0 +1,137 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "symbol_table_tests.h"
+#include "cmd_parser.h"
+#include "cmd_spec.h"
+#include "symbol_table.h"
+#include "test_util.h"
+#include <string>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void testSymbolTableIntern()
+{
+   {
+      const std::string caseLabel = "SymbolTable::intern for new name";
+      SymbolTable symbols;
+      const SymbolId id = symbols.intern("abc");
+      VERIFY(id != NoSymbol, caseLabel);
+      VERIFY(symbols.size() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "SymbolTable::intern for existing name";
+      SymbolTable symbols;
+      const SymbolId id = symbols.intern("abc");
+      VERIFY(symbols.intern(std::string{"abc"}) == id, caseLabel);
+      VERIFY(symbols.size() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "SymbolTable::intern for different names";
+      SymbolTable symbols;
+      VERIFY(symbols.intern("abc") != symbols.intern("abd"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "SymbolTable::intern for empty name";
+      SymbolTable symbols;
+      VERIFY(symbols.intern("") == NoSymbol, caseLabel);
+      VERIFY(symbols.size() == 0, caseLabel);
+   }
+}
+
+
+void testSymbolTableFind()
+{
+   {
+      const std::string caseLabel = "SymbolTable::find for interned name";
+      SymbolTable symbols;
+      const SymbolId id = symbols.intern("abc");
+      VERIFY(symbols.find("abc") == id, caseLabel);
+   }
+   {
+      const std::string caseLabel = "SymbolTable::find for unknown name";
+      SymbolTable symbols;
+      symbols.intern("abc");
+      VERIFY(symbols.find("ab") == NoSymbol, caseLabel);
+      VERIFY(symbols.size() == 1, caseLabel);
+   }
+}
+
+
+void testSymbolTableName()
+{
+   {
+      const std::string caseLabel = "SymbolTable::name for interned name";
+      SymbolTable symbols;
+      const SymbolId id = symbols.intern("abc");
+      VERIFY(symbols.name(id) == "abc", caseLabel);
+   }
+   {
+      const std::string caseLabel = "SymbolTable::name for unknown id";
+      SymbolTable symbols;
+      VERIFY(symbols.name(NoSymbol).empty(), caseLabel);
+      VERIFY(symbols.name(100).empty(), caseLabel);
+   }
+}
+
+
+void testFindSymbolIgnoringCase()
+{
+   {
+      const std::string caseLabel = "findSymbolIgnoringCase for mixed case name";
+      const SymbolId id = internSymbol("symboltest");
+      VERIFY(findSymbolIgnoringCase("SymbolTest") == id, caseLabel);
+      VERIFY(findSymbolIgnoringCase("symboltest") == id, caseLabel);
+      VERIFY(symbolName(id) == "symboltest", caseLabel);
+   }
+}
+
+
+void testSpecsInternLabels()
+{
+   {
+      const std::string caseLabel = "ArgSpec interns its label";
+      const ArgSpec spec = ArgSpec::makeOptionalArg("Interned", 1, "i");
+      VERIFY(spec.labelId() == findSymbol("interned"), caseLabel);
+      VERIFY(spec.matchLabel(findSymbol("interned")), caseLabel);
+      VERIFY(spec.matchLabel(findSymbol("i")), caseLabel);
+      VERIFY(!spec.matchLabel(NoSymbol), caseLabel);
+   }
+   {
+      const std::string caseLabel = "Verified args carry interned labels";
+      const CmdSpec spec{"test", "t", "", {ArgSpec::makeOptionalArg("interned", 1, "i")}, ""};
+
+      const CmdSpec::Match res = spec.match("TEST -I a");
+
+      VERIFY(res.areArgsValid, caseLabel);
+      VERIFY(res.matchedCmd.nameId == spec.nameId(), caseLabel);
+      VERIFY(res.matchedCmd.args[0].labelId == findSymbol("interned"), caseLabel);
+
+      const VerifiedArgs& args = res.matchedCmd.args;
+      VERIFY(findArgWithLabel(args.begin(), args.end(), findSymbol("interned")) ==
+                args.begin(),
+             caseLabel);
+      VERIFY(findArgWithLabel(args.begin(), args.end(), "--interned") == args.begin(),
+             caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testSymbolTable()
+{
+   testSymbolTableIntern();
+   testSymbolTableFind();
+   testSymbolTableName();
+   testFindSymbolIgnoringCase();
+   testSpecsInternLabels();
+}
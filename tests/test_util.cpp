@@ -5,8 +5,194 @@
 // MIT license
 //
 #include "test_util.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include <string>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+
+static std::atomic<std::size_t> numHeapAllocations = 0;
+
+
+namespace
+{
+///////////////////
+
+void* allocate(std::size_t size) noexcept
+{
+   ++numHeapAllocations;
+   return std::malloc(size > 0 ? size : 1);
+}
+
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+{
+   ++numHeapAllocations;
+   const std::size_t align = static_cast<std::size_t>(alignment);
+   // The size has to be a multiple of the alignment.
+   size = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+#ifdef _WIN32
+   return _aligned_malloc(size, align);
+#else
+   return std::aligned_alloc(align, size);
+#endif
+}
+
+
+void deallocate(void* mem) noexcept
+{
+   std::free(mem);
+}
+
+
+void deallocateAligned(void* mem) noexcept
+{
+#ifdef _WIN32
+   _aligned_free(mem);
+#else
+   std::free(mem);
+#endif
+}
+
+} // namespace
+
+
+// Replacements of all global allocation functions that count the heap allocations.
+// All forms have to be replaced. Otherwise allocations are missed and memory that
+// the library allocates is released by the replacements or vice versa.
+void* operator new(std::size_t size)
+{
+   if (void* mem = allocate(size))
+      return mem;
+   throw std::bad_alloc{};
+}
+
+
+void* operator new[](std::size_t size)
+{
+   if (void* mem = allocate(size))
+      return mem;
+   throw std::bad_alloc{};
+}
+
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+   return allocate(size);
+}
+
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+   return allocate(size);
+}
+
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+   if (void* mem = allocateAligned(size, alignment))
+      return mem;
+   throw std::bad_alloc{};
+}
+
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+   if (void* mem = allocateAligned(size, alignment))
+      return mem;
+   throw std::bad_alloc{};
+}
+
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept
+{
+   return allocateAligned(size, alignment);
+}
+
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept
+{
+   return allocateAligned(size, alignment);
+}
+
+
+void operator delete(void* mem) noexcept
+{
+   deallocate(mem);
+}
+
+
+void operator delete[](void* mem) noexcept
+{
+   deallocate(mem);
+}
+
+
+void operator delete(void* mem, std::size_t) noexcept
+{
+   deallocate(mem);
+}
+
+
+void operator delete[](void* mem, std::size_t) noexcept
+{
+   deallocate(mem);
+}
+
+
+void operator delete(void* mem, const std::nothrow_t&) noexcept
+{
+   deallocate(mem);
+}
+
+
+void operator delete[](void* mem, const std::nothrow_t&) noexcept
+{
+   deallocate(mem);
+}
+
+
+void operator delete(void* mem, std::align_val_t) noexcept
+{
+   deallocateAligned(mem);
+}
+
+
+void operator delete[](void* mem, std::align_val_t) noexcept
+{
+   deallocateAligned(mem);
+}
+
+
+void operator delete(void* mem, std::size_t, std::align_val_t) noexcept
+{
+   deallocateAligned(mem);
+}
+
+
+void operator delete[](void* mem, std::size_t, std::align_val_t) noexcept
+{
+   deallocateAligned(mem);
+}
+
+
+void operator delete(void* mem, std::align_val_t, const std::nothrow_t&) noexcept
+{
+   deallocateAligned(mem);
+}
+
+
+void operator delete[](void* mem, std::align_val_t, const std::nothrow_t&) noexcept
+{
+   deallocateAligned(mem);
+}
 
 
 static std::string errorMessage(const std::string& label, const std::string& reason,
@@ -34,3 +220,9 @@ bool verify(bool cond, const std::string& label, const std::string& reason,
       std::cout << errorMessage(label, reason, fileName, lineNum) << "\n";
    return cond;
 }
+
+
+std::size_t countHeapAllocations()
+{
+   return numHeapAllocations;
+}
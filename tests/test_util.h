@@ -5,6 +5,7 @@
 // MIT license
 //
 #pragma once
+#include <cstddef>
 #include <string>
 
 
@@ -13,3 +14,7 @@ bool verify(bool cond, const std::string& label, const std::string& reason,
 
 #define VERIFY(cond, label) (verify(cond, label, #cond, __FILE__, __LINE__))
 #define FAIL(reason, label) (verify(false, label, reason, __FILE__, __LINE__))
+
+
+// Returns the number of heap allocations that the test program made so far.
+std::size_t countHeapAllocations();
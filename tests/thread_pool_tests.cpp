@@ -0,0 +1,144 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "thread_pool_tests.h"
+#include "test_util.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+void testThreadPoolCtor()
+{
+   {
+      const std::string caseLabel = "ThreadPool ctor for given number of threads";
+      ThreadPool pool{3};
+      VERIFY(pool.countThreads() == 3, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ThreadPool ctor for zero threads";
+      ThreadPool pool{0};
+      VERIFY(pool.countThreads() == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ThreadPool default thread count";
+      VERIFY(ThreadPool::defaultThreadCount() >= 2, caseLabel);
+   }
+}
+
+
+void testThreadPoolSubmit()
+{
+   {
+      const std::string caseLabel = "ThreadPool::submit executes all tasks";
+      ThreadPool pool{4};
+      std::atomic<int> numExecuted = 0;
+      for (int i = 0; i < 1000; ++i)
+         pool.submit([&numExecuted]() { ++numExecuted; });
+      pool.waitUntilIdle();
+      VERIFY(numExecuted == 1000, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ThreadPool::submit from a task";
+      ThreadPool pool{2};
+      std::atomic<int> numExecuted = 0;
+      pool.submit([&pool, &numExecuted]() {
+         for (int i = 0; i < 10; ++i)
+            pool.submit([&numExecuted]() { ++numExecuted; });
+      });
+      pool.waitUntilIdle();
+      VERIFY(numExecuted == 10, caseLabel);
+   }
+   {
+      const std::string caseLabel = "ThreadPool dtor finishes submitted tasks";
+      std::atomic<int> numExecuted = 0;
+      {
+         ThreadPool pool{2};
+         for (int i = 0; i < 100; ++i)
+            pool.submit([&numExecuted]() { ++numExecuted; });
+      }
+      VERIFY(numExecuted == 100, caseLabel);
+   }
+}
+
+
+void testThreadPoolOrder()
+{
+   {
+      const std::string caseLabel =
+         "ThreadPool starts tasks from outside the pool in submission order";
+      ThreadPool pool{1};
+      std::atomic<bool> isReleased = false;
+      std::mutex orderMutex;
+      std::vector<int> order;
+
+      // Keeps the worker busy until all tasks are queued.
+      pool.submit([&isReleased]() {
+         while (!isReleased)
+            std::this_thread::yield();
+      });
+      for (int i = 0; i < 10; ++i)
+      {
+         pool.submit([&, i]() {
+            std::lock_guard lock{orderMutex};
+            order.push_back(i);
+         });
+      }
+      isReleased = true;
+
+      pool.waitUntilIdle();
+      VERIFY(order == std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), caseLabel);
+   }
+}
+
+
+void testThreadPoolWorkStealing()
+{
+   {
+      const std::string caseLabel =
+         "ThreadPool executes tasks queued behind a blocked task on other workers";
+      ThreadPool pool{2};
+      std::atomic<int> numExecuted = 0;
+      std::atomic<bool> wereStolen = false;
+
+      // Tasks submitted from within a task go to the queue of its worker. They can
+      // only execute while the task is blocked if the other worker steals them.
+      pool.submit([&]() {
+         for (int i = 0; i < 10; ++i)
+            pool.submit([&numExecuted]() { ++numExecuted; });
+
+         const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+         while (numExecuted < 10 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+         wereStolen = numExecuted == 10;
+      });
+
+      pool.waitUntilIdle();
+      VERIFY(wereStolen, caseLabel);
+      VERIFY(numExecuted == 10, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testThreadPool()
+{
+   testThreadPoolCtor();
+   testThreadPoolSubmit();
+   testThreadPoolOrder();
+   testThreadPoolWorkStealing();
+}
@@ -0,0 +1,240 @@
+//
+// ccon tests
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "value_completion_tests.h"
+#include "value_completion.h"
+#include "test_util.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ccon;
+
+
+namespace
+{
+///////////////////
+
+// Lookup that completes a prefix to itself with a suffix and counts its calls.
+ValueLookupFn makeCountingLookup(std::atomic<int>& numLookups)
+{
+   return [&numLookups](const std::string& prefix, const CancellationToken&) {
+      ++numLookups;
+      return std::vector<std::string>{prefix + "1", prefix + "2"};
+   };
+}
+
+
+///////////////////
+
+void testSyncValueCompletionProvider()
+{
+   {
+      const std::string caseLabel = "SyncValueCompletionProvider looks up each time";
+      std::atomic<int> numLookups = 0;
+      SyncValueCompletionProvider provider{makeCountingLookup(numLookups)};
+
+      VERIFY(provider.complete("a") == std::vector<std::string>({"a1", "a2"}), caseLabel);
+      VERIFY(provider.complete("a") == std::vector<std::string>({"a1", "a2"}), caseLabel);
+      VERIFY(numLookups == 2, caseLabel);
+   }
+}
+
+
+void testCachedValueCompletionProvider()
+{
+   {
+      const std::string caseLabel = "CachedValueCompletionProvider reuses completions";
+      std::atomic<int> numLookups = 0;
+      CachedValueCompletionProvider provider{makeCountingLookup(numLookups)};
+
+      VERIFY(provider.complete("a") == std::vector<std::string>({"a1", "a2"}), caseLabel);
+      VERIFY(provider.complete("a") == std::vector<std::string>({"a1", "a2"}), caseLabel);
+      VERIFY(numLookups == 1, caseLabel);
+      VERIFY(provider.complete("b") == std::vector<std::string>({"b1", "b2"}), caseLabel);
+      VERIFY(numLookups == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CachedValueCompletionProvider::invalidate";
+      std::atomic<int> numLookups = 0;
+      CachedValueCompletionProvider provider{makeCountingLookup(numLookups)};
+
+      provider.complete("a");
+      provider.invalidate();
+      provider.complete("a");
+      VERIFY(numLookups == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel = "CachedValueCompletionProvider for expired completions";
+      std::atomic<int> numLookups = 0;
+      CachedValueCompletionProvider provider{makeCountingLookup(numLookups),
+                                             std::chrono::milliseconds{1}};
+
+      provider.complete("a");
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+      provider.complete("a");
+      VERIFY(numLookups == 2, caseLabel);
+   }
+}
+
+
+void testAsyncValueCompletionProvider()
+{
+   {
+      const std::string caseLabel =
+         "AsyncValueCompletionProvider returns completions once looked up";
+      std::atomic<int> numLookups = 0;
+      std::string notifiedPrefix;
+      ThreadPool workers{2};
+      AsyncValueCompletionProvider provider{
+         workers, makeCountingLookup(numLookups), std::chrono::milliseconds{0},
+         std::nullopt,
+         [&notifiedPrefix](const std::string& prefix) { notifiedPrefix = prefix; }};
+
+      VERIFY(!provider.complete("a"), caseLabel);
+      provider.waitUntilIdle();
+      VERIFY(notifiedPrefix == "a", caseLabel);
+      VERIFY(provider.complete("a") == std::vector<std::string>({"a1", "a2"}), caseLabel);
+      VERIFY(numLookups == 1, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "AsyncValueCompletionProvider does not repeat a running lookup";
+      std::atomic<bool> isReleased = false;
+      std::atomic<int> numLookups = 0;
+      ThreadPool workers{2};
+      AsyncValueCompletionProvider provider{
+         workers, [&](const std::string& prefix, const CancellationToken&) {
+            ++numLookups;
+            while (!isReleased)
+               std::this_thread::yield();
+            return std::vector<std::string>{prefix};
+         },
+         std::chrono::milliseconds{0}};
+
+      VERIFY(!provider.complete("a"), caseLabel);
+      VERIFY(!provider.complete("a"), caseLabel);
+      isReleased = true;
+      provider.waitUntilIdle();
+      VERIFY(numLookups == 1, caseLabel);
+      VERIFY(provider.complete("a") == std::vector<std::string>{"a"}, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "AsyncValueCompletionProvider cancels the lookup of a changed prefix";
+      std::atomic<bool> isStarted = false;
+      std::atomic<bool> wasCancelled = false;
+      ThreadPool workers{2};
+      AsyncValueCompletionProvider provider{
+         workers, [&](const std::string& prefix, const CancellationToken& cancellation) {
+            isStarted = true;
+            // The first lookup runs until it gets cancelled.
+            while (prefix == "a" && !cancellation.isCancelled())
+               std::this_thread::yield();
+            wasCancelled = wasCancelled || cancellation.isCancelled();
+            return std::vector<std::string>{prefix};
+         },
+         std::chrono::milliseconds{0}};
+
+      provider.complete("a");
+      while (!isStarted)
+         std::this_thread::yield();
+      provider.complete("ab");
+      provider.waitUntilIdle();
+      VERIFY(wasCancelled, caseLabel);
+      VERIFY(provider.complete("ab") == std::vector<std::string>{"ab"}, caseLabel);
+      // Completions of the cancelled lookup are not kept.
+      VERIFY(!provider.complete("a"), caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "AsyncValueCompletionProvider debounces quickly changing prefixes";
+      std::atomic<int> numLookups = 0;
+      ThreadPool workers{2};
+      AsyncValueCompletionProvider provider{workers, makeCountingLookup(numLookups),
+                                            std::chrono::milliseconds{50}};
+
+      provider.complete("a");
+      provider.complete("ab");
+      provider.complete("abc");
+      provider.waitUntilIdle();
+      VERIFY(numLookups == 1, caseLabel);
+      VERIFY(provider.complete("abc") == std::vector<std::string>({"abc1", "abc2"}),
+             caseLabel);
+   }
+   {
+      const std::string caseLabel = "AsyncValueCompletionProvider for failing lookup";
+      ThreadPool workers{2};
+      AsyncValueCompletionProvider provider{
+         workers,
+         [](const std::string&, const CancellationToken&) -> std::vector<std::string> {
+            throw std::runtime_error("lookup failed");
+         },
+         std::chrono::milliseconds{0}};
+
+      provider.complete("a");
+      provider.waitUntilIdle();
+      VERIFY(!provider.complete("a"), caseLabel);
+   }
+   {
+      const std::string caseLabel = "AsyncValueCompletionProvider::invalidate";
+      std::atomic<int> numLookups = 0;
+      ThreadPool workers{2};
+      AsyncValueCompletionProvider provider{workers, makeCountingLookup(numLookups),
+                                            std::chrono::milliseconds{0}};
+
+      provider.complete("a");
+      provider.waitUntilIdle();
+      provider.invalidate();
+      VERIFY(!provider.complete("a"), caseLabel);
+      provider.waitUntilIdle();
+      VERIFY(numLookups == 2, caseLabel);
+   }
+   {
+      const std::string caseLabel =
+         "AsyncValueCompletionProvider interrupts the debounce of a cancelled lookup";
+      std::atomic<int> numLookups = 0;
+      ThreadPool workers{1};
+      AsyncValueCompletionProvider provider{workers, makeCountingLookup(numLookups),
+                                            std::chrono::hours{1}};
+
+      provider.complete("a");
+      // Would wait for the full debounce time otherwise.
+      provider.invalidate();
+      VERIFY(workers.waitUntilIdle(std::chrono::seconds{10}), caseLabel);
+      VERIFY(numLookups == 0, caseLabel);
+   }
+   {
+      const std::string caseLabel = "AsyncValueCompletionProvider for shared pool";
+      std::atomic<int> numLookups = 0;
+      ThreadPool workers{1};
+      AsyncValueCompletionProvider first{workers, makeCountingLookup(numLookups),
+                                         std::chrono::milliseconds{0}};
+      AsyncValueCompletionProvider second{workers, makeCountingLookup(numLookups),
+                                          std::chrono::milliseconds{0}};
+
+      first.complete("a");
+      second.complete("b");
+      first.waitUntilIdle();
+      second.waitUntilIdle();
+      VERIFY(first.complete("a") == std::vector<std::string>({"a1", "a2"}), caseLabel);
+      VERIFY(second.complete("b") == std::vector<std::string>({"b1", "b2"}), caseLabel);
+      VERIFY(numLookups == 2, caseLabel);
+   }
+}
+
+} // namespace
+
+
+void testValueCompletion()
+{
+   testSyncValueCompletionProvider();
+   testCachedValueCompletionProvider();
+   testAsyncValueCompletionProvider();
+}
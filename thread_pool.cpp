@@ -0,0 +1,185 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "thread_pool.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+
+namespace
+{
+///////////////////
+
+// Identifies the pool and queue of the worker that runs on the current thread.
+thread_local const void* currentPool = nullptr;
+thread_local std::size_t currentWorkerIdx = 0;
+
+} // namespace
+
+
+namespace ccon
+{
+///////////////////
+
+std::size_t ThreadPool::defaultThreadCount()
+{
+   // Leave one core for the UI thread but have at least two workers so that a
+   // single slow command does not block all others.
+   const std::size_t numCores = std::thread::hardware_concurrency();
+   return std::max<std::size_t>(numCores > 0 ? numCores - 1 : 0, 2);
+}
+
+
+ThreadPool::ThreadPool(std::size_t numThreads)
+{
+   numThreads = std::max<std::size_t>(numThreads, 1);
+
+   m_queues.reserve(numThreads);
+   for (std::size_t i = 0; i < numThreads; ++i)
+      m_queues.push_back(std::make_unique<WorkerQueue>());
+
+   m_threads.reserve(numThreads);
+   for (std::size_t i = 0; i < numThreads; ++i)
+      m_threads.emplace_back([this, i]() { runWorker(i); });
+}
+
+
+ThreadPool::~ThreadPool()
+{
+   {
+      std::lock_guard<std::mutex> lock{m_stateMutex};
+      m_isStopping = true;
+   }
+   m_taskAvailable.notify_all();
+
+   for (std::thread& thread : m_threads)
+      thread.join();
+}
+
+
+void ThreadPool::submit(Task task)
+{
+   // Tasks from outside the pool start in the order of their submission, e.g.
+   // the commands that the user entered.
+   const bool isWorker = currentPool == this;
+   WorkerQueue& queue = isWorker ? *m_queues[currentWorkerIdx] : m_injected;
+
+   // Count the task before queuing it, so that the counters never drop below the
+   // number of queued tasks when a worker takes it right away.
+   {
+      std::lock_guard<std::mutex> lock{m_stateMutex};
+      ++m_numQueued;
+      ++m_numUnfinished;
+   }
+
+   {
+      std::lock_guard<std::mutex> lock{queue.mutex};
+      queue.tasks.push_back(std::move(task));
+   }
+   m_taskAvailable.notify_one();
+}
+
+
+void ThreadPool::waitUntilIdle()
+{
+   assert(currentPool != this && "Waiting from a task would never finish.");
+
+   std::unique_lock<std::mutex> lock{m_stateMutex};
+   m_idle.wait(lock, [this]() { return m_numUnfinished == 0; });
+}
+
+
+bool ThreadPool::waitUntilIdle(std::chrono::milliseconds timeout)
+{
+   assert(currentPool != this && "Waiting from a task would never finish.");
+
+   std::unique_lock<std::mutex> lock{m_stateMutex};
+   return m_idle.wait_for(lock, timeout, [this]() { return m_numUnfinished == 0; });
+}
+
+
+void ThreadPool::runWorker(std::size_t workerIdx)
+{
+   currentPool = this;
+   currentWorkerIdx = workerIdx;
+
+   while (true)
+   {
+      if (std::optional<Task> task = takeTask(workerIdx); task.has_value())
+      {
+         (*task)();
+         finishTask();
+         continue;
+      }
+
+      std::unique_lock<std::mutex> lock{m_stateMutex};
+      m_taskAvailable.wait(lock, [this]() { return m_isStopping || m_numQueued > 0; });
+      // Finish the queued tasks before stopping.
+      if (m_isStopping && m_numQueued == 0)
+         return;
+   }
+}
+
+
+std::optional<ThreadPool::Task> ThreadPool::takeTask(std::size_t workerIdx)
+{
+   // Take the most recent task of the own queue. It is the most likely to still
+   // have its data in the cache.
+   {
+      WorkerQueue& own = *m_queues[workerIdx];
+      std::lock_guard<std::mutex> lock{own.mutex};
+      if (!own.tasks.empty())
+      {
+         Task task = std::move(own.tasks.back());
+         own.tasks.pop_back();
+         --m_numQueued;
+         return task;
+      }
+   }
+
+   // Take the oldest task that was submitted from outside the pool.
+   {
+      std::lock_guard<std::mutex> lock{m_injected.mutex};
+      if (!m_injected.tasks.empty())
+      {
+         Task task = std::move(m_injected.tasks.front());
+         m_injected.tasks.pop_front();
+         --m_numQueued;
+         return task;
+      }
+   }
+
+   // Steal the oldest task of another queue.
+   for (std::size_t i = 1; i < m_queues.size(); ++i)
+   {
+      WorkerQueue& victim = *m_queues[(workerIdx + i) % m_queues.size()];
+      std::lock_guard<std::mutex> lock{victim.mutex};
+      if (!victim.tasks.empty())
+      {
+         Task task = std::move(victim.tasks.front());
+         victim.tasks.pop_front();
+         --m_numQueued;
+         return task;
+      }
+   }
+
+   return std::nullopt;
+}
+
+
+void ThreadPool::finishTask()
+{
+   bool isIdle = false;
+   {
+      std::lock_guard<std::mutex> lock{m_stateMutex};
+      isIdle = --m_numUnfinished == 0;
+   }
+   if (isIdle)
+      m_idle.notify_all();
+}
+
+} // namespace ccon
@@ -0,0 +1,86 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+// Pool of worker threads that execute submitted tasks.
+// Tasks that are submitted from outside the pool go to a shared queue and start in
+// the order of their submission. Tasks that are submitted from a worker go to the
+// worker's own queue. Workers that run out of tasks steal tasks from the queues of
+// other workers, so that a worker that is blocked by a long task does not hold up
+// the tasks that were queued behind it.
+// Tasks must not throw.
+class ThreadPool
+{
+ public:
+   using Task = std::function<void()>;
+
+   static std::size_t defaultThreadCount();
+
+ public:
+   explicit ThreadPool(std::size_t numThreads = defaultThreadCount());
+   // Finishes all submitted tasks before joining the workers.
+   ~ThreadPool();
+   ThreadPool(const ThreadPool&) = delete;
+   ThreadPool(ThreadPool&&) = delete;
+   ThreadPool& operator=(const ThreadPool&) = delete;
+   ThreadPool& operator=(ThreadPool&&) = delete;
+
+   std::size_t countThreads() const { return m_threads.size(); }
+   // Tasks that are submitted from a worker go to the worker's own queue. Other
+   // tasks go to the shared queue.
+   void submit(Task task);
+   // Blocks until all submitted tasks are finished. Must not be called from a task.
+   void waitUntilIdle();
+   // Blocks until all submitted tasks are finished or the timeout passed. Returns
+   // whether the tasks are finished. Must not be called from a task.
+   bool waitUntilIdle(std::chrono::milliseconds timeout);
+
+ private:
+   struct WorkerQueue
+   {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+   };
+
+   void runWorker(std::size_t workerIdx);
+   std::optional<Task> takeTask(std::size_t workerIdx);
+   void finishTask();
+
+ private:
+   // Tasks that were submitted from outside the pool. Taken oldest first.
+   WorkerQueue m_injected;
+   std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+   std::vector<std::thread> m_threads;
+
+   // Guards the sleeping and waking of the workers and of the idle waiters.
+   std::mutex m_stateMutex;
+   std::condition_variable m_taskAvailable;
+   std::condition_variable m_idle;
+   // Number of tasks that are queued but not yet taken by a worker.
+   std::atomic<std::size_t> m_numQueued = 0;
+   // Number of tasks that are queued or running.
+   std::size_t m_numUnfinished = 0;
+   bool m_isStopping = false;
+};
+
+} // namespace ccon
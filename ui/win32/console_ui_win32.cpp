@@ -92,6 +92,16 @@ void ConsoleUIWin32::setFontSize(int sizeInPoints)
 }
 
 
+void ConsoleUIWin32::notifyPendingOutput()
+{
+   // Called from worker threads. The window is created once and kept, so checking
+   // it here is safe. Output that is pending before the window exists is displayed
+   // when the next input line is processed.
+   if (m_wnd)
+      m_wnd->notifyPendingOutput();
+}
+
+
 win32::Rect ConsoleUIWin32::calcConsoleBounds() const
 {
    win32::Rect bounds = DefaultPrefs::consoleWindowBounds();
@@ -44,6 +44,7 @@ class ConsoleUIWin32 : public ConsoleUI
    void setInputTextColor(const sutil::Rgb& color) override;
    void resetColors() override;
    void setFontSize(int sizeInPoints) override;
+   void notifyPendingOutput() override;
 
  private:
    win32::Rect calcConsoleBounds() const;
@@ -23,6 +23,10 @@ namespace
 constexpr UINT TextFormatFlags = DT_LEFT | DT_TOP | DT_NOPREFIX | DT_EXTERNALLEADING;
 constexpr UINT CursorBlinkRateMs = 500;
 constexpr long CursorWidth = 1;
+// Posted when commands that execute on worker threads have output pending.
+constexpr UINT PendingOutputMsg = WM_APP + 1;
+// Character that WM_CHAR reports for Ctrl-C.
+constexpr TCHAR CtrlC = 0x03;
 
 
 ///////////////////
@@ -193,6 +197,14 @@ void ConsoleWndWin32::setFontSize(int sizeInPoints)
 }
 
 
+void ConsoleWndWin32::notifyPendingOutput()
+{
+   // Posting is thread-safe. The output is processed on the window's thread.
+   if (exists())
+      postMessage(PendingOutputMsg);
+}
+
+
 const TCHAR* ConsoleWndWin32::windowClassName() const
 {
    return _T("ConsoleWndClass");
@@ -228,6 +240,18 @@ bool ConsoleWndWin32::registerWindowClass() const
 }
 
 
+LRESULT ConsoleWndWin32::handleMessage(HWND hwnd, UINT msgId, WPARAM wParam,
+                                       LPARAM lParam)
+{
+   if (msgId == PendingOutputMsg)
+   {
+      processPendingOutput();
+      return 0;
+   }
+   return Window::handleMessage(hwnd, msgId, wParam, lParam);
+}
+
+
 win32::Window::CreationResult ConsoleWndWin32::onCreate(const CREATESTRUCT* createInfo)
 {
    Window::onCreate(createInfo);
@@ -602,6 +626,12 @@ bool ConsoleWndWin32::handleInputKey(TCHAR tch)
    if (tch == VK_BACK || tch == VK_RETURN || tch == VK_TAB)
       return false;
 
+   if (tch == CtrlC)
+   {
+      m_content.cancelCommands();
+      return true;
+   }
+
    const std::optional<char> ch = toNarrowChar(tch);
    if (!ch.has_value())
       return false;
@@ -647,6 +677,21 @@ void ConsoleWndWin32::processInputLine()
 }
 
 
+void ConsoleWndWin32::processPendingOutput()
+{
+   m_content.processPendingOutput();
+
+   // The output lines are inserted above the input line. The cursor stays at its
+   // position within the input line.
+   m_layout.calcContentMetrics(clientBounds());
+   updateScrollbar();
+   scrollIntoView();
+   updateInputCursor();
+
+   inval(true);
+}
+
+
 void ConsoleWndWin32::displayPreviousInput()
 {
    invalInputLine();
@@ -38,11 +38,15 @@ class ConsoleWndWin32 : public win32::Window
    void setInputTextColor(const sutil::Rgb& color);
    void resetColors();
    void setFontSize(int sizeInPoints);
+   // Can be called from any thread.
+   void notifyPendingOutput();
 
  protected:
    const TCHAR* windowClassName() const override;
    bool registerWindowClass() const override;
 
+   LRESULT handleMessage(HWND hwnd, UINT msgId, WPARAM wParam, LPARAM lParam) override;
+
    CreationResult onCreate(const CREATESTRUCT* createInfo) override;
    bool onDestroy() override;
    bool onPaint() override;
@@ -79,6 +83,7 @@ class ConsoleWndWin32 : public win32::Window
    bool handleInputKey(TCHAR tch);
    void deleteInputCharacter(std::size_t charIdx, int cursorOffset);
    void processInputLine();
+   void processPendingOutput();
    void displayPreviousInput();
    void displayNextInput();
    void autoCompleteInput();
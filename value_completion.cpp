@@ -0,0 +1,177 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#include "value_completion.h"
+#include <utility>
+
+
+namespace ccon
+{
+///////////////////
+
+SyncValueCompletionProvider::SyncValueCompletionProvider(ValueLookupFn lookup)
+: m_lookup{std::move(lookup)}
+{
+}
+
+
+std::optional<std::vector<std::string>>
+SyncValueCompletionProvider::complete(const std::string& prefix)
+{
+   return m_lookup(prefix, CancellationToken{});
+}
+
+
+///////////////////
+
+CachedValueCompletionProvider::CachedValueCompletionProvider(
+   ValueLookupFn lookup, std::optional<std::chrono::milliseconds> ttl,
+   std::size_t maxEntries)
+: m_lookup{std::move(lookup)}, m_cache{maxEntries, ttl}
+{
+}
+
+
+std::optional<std::vector<std::string>>
+CachedValueCompletionProvider::complete(const std::string& prefix)
+{
+   if (std::optional<CmdOutput> completions = m_cache.find(prefix))
+      return completions;
+
+   const std::uint64_t startGeneration = m_cache.generation();
+   std::vector<std::string> completions = m_lookup(prefix, CancellationToken{});
+   m_cache.insert(prefix, NoSymbol, completions, startGeneration);
+   return completions;
+}
+
+
+void CachedValueCompletionProvider::invalidate()
+{
+   m_cache.invalidateAll();
+}
+
+
+///////////////////
+
+AsyncValueCompletionProvider::AsyncValueCompletionProvider(
+   ThreadPool& workers, ValueLookupFn lookup, std::chrono::milliseconds debounce,
+   std::optional<std::chrono::milliseconds> ttl, NotifyFn onCompleted)
+: m_workers{workers}, m_lookup{std::move(lookup)}, m_debounce{debounce},
+  m_onCompleted{std::move(onCompleted)}, m_cache{CmdResultCache::DefaultMaxEntries, ttl}
+{
+}
+
+
+AsyncValueCompletionProvider::~AsyncValueCompletionProvider()
+{
+   {
+      std::lock_guard lock{m_mutex};
+      if (m_lookupInProgress)
+         m_lookupInProgress->cancellation.cancel();
+   }
+   // The lookups use the members.
+   waitUntilIdle();
+}
+
+
+std::optional<std::vector<std::string>>
+AsyncValueCompletionProvider::complete(const std::string& prefix)
+{
+   if (std::optional<CmdOutput> completions = m_cache.find(prefix))
+      return completions;
+
+   std::lock_guard lock{m_mutex};
+
+   // Don't start the same lookup again while it is running. A finished lookup
+   // whose completions are not cached failed or expired and is repeated.
+   if (m_lookupInProgress && m_lookupInProgress->prefix == prefix &&
+       !m_lookupInProgress->isFinished)
+   {
+      return std::nullopt;
+   }
+
+   if (m_lookupInProgress)
+      m_lookupInProgress->cancellation.cancel();
+   m_lookupInProgress = std::make_shared<Lookup>();
+   m_lookupInProgress->prefix = prefix;
+   m_lookupInProgress->startGeneration = m_cache.generation();
+
+   {
+      std::lock_guard runLock{m_runMutex};
+      ++m_numRunning;
+   }
+   m_workers.submit([this, lookup = m_lookupInProgress]() { run(*lookup); });
+   return std::nullopt;
+}
+
+
+void AsyncValueCompletionProvider::invalidate()
+{
+   std::lock_guard lock{m_mutex};
+   if (m_lookupInProgress)
+      m_lookupInProgress->cancellation.cancel();
+   m_lookupInProgress.reset();
+   m_cache.invalidateAll();
+}
+
+
+void AsyncValueCompletionProvider::waitUntilIdle()
+{
+   std::unique_lock lock{m_runMutex};
+   m_idle.wait(lock, [this]() { return m_numRunning == 0; });
+}
+
+
+void AsyncValueCompletionProvider::run(Lookup& lookup)
+{
+   const CancellationToken cancellation = lookup.cancellation.token();
+
+   // Tasks of the pool must not throw. Failed lookups leave no completions.
+   try
+   {
+      if (debounce(cancellation))
+      {
+         std::vector<std::string> completions = m_lookup(lookup.prefix, cancellation);
+         if (!cancellation.isCancelled())
+         {
+            m_cache.insert(lookup.prefix, NoSymbol, std::move(completions),
+                           lookup.startGeneration);
+            lookup.isFinished = true;
+            if (m_onCompleted)
+               m_onCompleted(lookup.prefix);
+         }
+      }
+   }
+   catch (...)
+   {
+   }
+
+   lookup.isFinished = true;
+   finishRun();
+}
+
+
+bool AsyncValueCompletionProvider::debounce(const CancellationToken& cancellation)
+{
+   // A newer request cancels the lookup, which interrupts the wait.
+   const auto end = std::chrono::steady_clock::now() + m_debounce;
+   std::unique_lock lock{m_runMutex};
+   waitUnlessCancelled(m_debounceInterrupted, lock, cancellation, end,
+                       []() { return false; });
+   return !cancellation.isCancelled();
+}
+
+
+void AsyncValueCompletionProvider::finishRun()
+{
+   // Notify under the lock. The provider might be destroyed as soon as a waiter
+   // sees that no lookups are running.
+   std::lock_guard lock{m_runMutex};
+   if (--m_numRunning == 0)
+      m_idle.notify_all();
+}
+
+} // namespace ccon
@@ -0,0 +1,160 @@
+//
+// ccon
+//
+// Oct-2026, Michael Lindner
+// MIT license
+//
+#pragma once
+#include "cancellation.h"
+#include "result_cache.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace ccon
+{
+///////////////////
+
+// Looks up the completions of a partially entered argument value. The completions
+// are full values. Lookups that take long should check the cancellation regularly
+// and return early once it is cancelled.
+using ValueLookupFn = std::function<std::vector<std::string>(
+   const std::string& prefix, const CancellationToken& cancellation)>;
+
+
+// Source of completions for the values of an argument (see
+// ArgSpec::setCompletionProvider).
+class ValueCompletionProvider
+{
+ public:
+   ValueCompletionProvider() = default;
+   virtual ~ValueCompletionProvider() = default;
+   ValueCompletionProvider(const ValueCompletionProvider&) = delete;
+   ValueCompletionProvider(ValueCompletionProvider&&) = delete;
+   ValueCompletionProvider& operator=(const ValueCompletionProvider&) = delete;
+   ValueCompletionProvider& operator=(ValueCompletionProvider&&) = delete;
+
+   // Returns the completions of a partially entered value. Returns nothing if they
+   // are not available yet. Called on the thread that handles the user's input.
+   virtual std::optional<std::vector<std::string>> complete(const std::string& prefix) = 0;
+   // Drops completions that were remembered from earlier lookups.
+   virtual void invalidate() {}
+};
+
+
+///////////////////
+
+// Looks up completions right away each time they are requested. For cheap lookups.
+class SyncValueCompletionProvider : public ValueCompletionProvider
+{
+ public:
+   explicit SyncValueCompletionProvider(ValueLookupFn lookup);
+
+   std::optional<std::vector<std::string>> complete(const std::string& prefix) override;
+
+ private:
+   ValueLookupFn m_lookup;
+};
+
+
+///////////////////
+
+// Looks up completions when they are requested and remembers them for a given time.
+class CachedValueCompletionProvider : public ValueCompletionProvider
+{
+ public:
+   // Completions are kept until they get evicted or invalidated if no time to live
+   // is given.
+   explicit CachedValueCompletionProvider(
+      ValueLookupFn lookup, std::optional<std::chrono::milliseconds> ttl = std::nullopt,
+      std::size_t maxEntries = CmdResultCache::DefaultMaxEntries);
+
+   std::optional<std::vector<std::string>> complete(const std::string& prefix) override;
+   void invalidate() override;
+
+ private:
+   ValueLookupFn m_lookup;
+   CmdResultCache m_cache;
+};
+
+
+///////////////////
+
+// Looks up completions on a thread pool, so that expensive lookups never block the
+// input. Requesting the completions of a prefix starts a lookup and returns nothing.
+// Requesting them again after the lookup finished returns its completions from a
+// cache.
+// A lookup starts after a given debounce time, so that prefixes that change in
+// quick succession don't start a lookup each. Requesting a different prefix
+// cancels the running lookup.
+// Providers share a pool that is reserved for lookups, e.g. the completion workers
+// of the console (see Console::completionWorkers), instead of having threads of
+// their own. Lookups wait for their debounce time on a thread of the pool, so the
+// pool must not execute commands.
+class AsyncValueCompletionProvider : public ValueCompletionProvider
+{
+ public:
+   // Called on the background thread with the prefix whose completions became
+   // available, e.g. to complete the input again.
+   using NotifyFn = std::function<void(const std::string& prefix)>;
+
+ public:
+   // The pool has to outlive the provider.
+   AsyncValueCompletionProvider(ThreadPool& workers, ValueLookupFn lookup,
+                                std::chrono::milliseconds debounce,
+                                std::optional<std::chrono::milliseconds> ttl = std::nullopt,
+                                NotifyFn onCompleted = {});
+   // Cancels the running lookup and waits for it to return.
+   ~AsyncValueCompletionProvider() override;
+
+   std::optional<std::vector<std::string>> complete(const std::string& prefix) override;
+   void invalidate() override;
+   // Blocks until the started lookups are finished.
+   void waitUntilIdle();
+
+ private:
+   struct Lookup
+   {
+      std::string prefix;
+      CancellationSource cancellation;
+      std::uint64_t startGeneration = 0;
+      std::atomic<bool> isFinished = false;
+   };
+
+   void run(Lookup& lookup);
+   // Returns whether the debounce time passed without the lookup being cancelled.
+   bool debounce(const CancellationToken& cancellation);
+   void finishRun();
+
+ private:
+   ThreadPool& m_workers;
+   ValueLookupFn m_lookup;
+   std::chrono::milliseconds m_debounce;
+   NotifyFn m_onCompleted;
+   CmdResultCache m_cache;
+   std::mutex m_mutex;
+   // Last started lookup.
+   std::shared_ptr<Lookup> m_lookupInProgress;
+   // Guards the waiting for the debounce time and for the lookups to finish. Never
+   // locked while cancelling a lookup.
+   std::mutex m_runMutex;
+   // Never signaled. Debouncing lookups wait on it until they get cancelled or the
+   // debounce time passed.
+   std::condition_variable m_debounceInterrupted;
+   // Signaled when the last submitted lookup finished.
+   std::condition_variable m_idle;
+   // Number of lookups that were submitted to the pool and did not finish yet.
+   std::size_t m_numRunning = 0;
+};
+
+} // namespace ccon